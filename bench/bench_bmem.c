@@ -0,0 +1,57 @@
+#include "bench_bmem.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Counting implementation of the OBS allocators used by the micro-benchmarks,
+ * so that allocations per operation can be reported next to the timings.
+ */
+
+static size_t g_allocations;
+static size_t g_reallocations;
+
+void *bzalloc(size_t size) {
+    g_allocations++;
+    return calloc(1, size);
+}
+
+void *bmalloc(size_t size) {
+    g_allocations++;
+    return malloc(size);
+}
+
+void *brealloc(void *ptr, size_t size) {
+    if (ptr)
+        g_reallocations++;
+    else
+        g_allocations++;
+    return realloc(ptr, size);
+}
+
+void bfree(void *ptr) {
+    free(ptr);
+}
+
+char *bstrdup(const char *str) {
+    if (!str)
+        return NULL;
+    size_t len = strlen(str) + 1;
+    char  *dup = bmalloc(len);
+    if (dup)
+        memcpy(dup, str, len);
+    return dup;
+}
+
+void bench_bmem_reset(void) {
+    g_allocations   = 0;
+    g_reallocations = 0;
+}
+
+size_t bench_bmem_allocations(void) {
+    return g_allocations;
+}
+
+size_t bench_bmem_reallocations(void) {
+    return g_reallocations;
+}
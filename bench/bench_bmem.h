@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Reset the allocation counters.
+ */
+void bench_bmem_reset(void);
+
+/**
+ * @brief Number of fresh allocations (bmalloc, bzalloc, brealloc(NULL, ...)) since the last reset.
+ */
+size_t bench_bmem_allocations(void);
+
+/**
+ * @brief Number of reallocations of existing blocks since the last reset.
+ */
+size_t bench_bmem_reallocations(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,107 @@
+#include "bench_bmem.h"
+
+#include "crypto/crypto.h"
+
+#include <openssl/evp.h>
+#include <util/bmem.h>
+
+#include <stdio.h>
+#include <time.h>
+
+/*
+ * Measures the throughput of the request signing.
+ *
+ * The "one-shot" variant calls crypto_sign(), which sets up the signing context
+ * and allocates the header for every request. The "signer" variant reuses a
+ * crypto_signer_t created once for the key and writes the header into a stack
+ * buffer. Allocations are the ones made through bmem; OpenSSL's own allocations
+ * are not counted.
+ */
+
+#define ITERATIONS 20000
+
+static const char *g_url = "https://sisu.xboxlive.com/authorize";
+
+static const char *g_payload =
+    "{\"AccessToken\":\"t=EwAYA+pvBAAUKods63Ys1fGlwiccIFJ+qE1hANsAAQ\",\"AppId\":\"000000004c12ae6f\","
+    "\"DeviceToken\":\"eyJhbGciOiJSU0EtT0FFUCIsImVuYyI6IkEyNTZDQkMtSFM1MTIiLCJ6aXAiOiJERUYifQ\","
+    "\"Sandbox\":\"RETAIL\",\"UseModernGamertag\":true,\"SiteName\":\"user.auth.xboxlive.com\","
+    "\"RelyingParty\":\"http://xboxlive.com\",\"ProofKey\":{\"kty\":\"EC\",\"crv\":\"P-256\",\"alg\":\"ES256\","
+    "\"use\":\"sig\",\"x\":\"f83OJ3D2xF1Bg8vub9tLe1gHMzV76e8Tus9uPHvRVEU\",\"y\":\"x_FEzRu9m36HLN_tue659LNpXW6pCyStikYjKIWI5a0\"}}";
+
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void report(const char *name, int signatures, double elapsed, size_t allocations) {
+
+    printf("%-8s  signatures=%6d  signatures/s=%9.1f  us/signature=%8.3f  allocs/signature=%5.2f\n",
+           name,
+           signatures,
+           (double)signatures / elapsed,
+           elapsed * 1e6 / (double)signatures,
+           (double)allocations / (double)signatures);
+}
+
+static void run_one_shot(const EVP_PKEY *keys) {
+
+    int signatures = 0;
+
+    bench_bmem_reset();
+
+    double start = now_seconds();
+
+    for (int i = 0; i < ITERATIONS; i++) {
+        size_t   length = 0;
+        uint8_t *header = crypto_sign(keys, g_url, "", g_payload, &length);
+
+        if (header) {
+            signatures++;
+        }
+
+        bfree(header);
+    }
+
+    report("one-shot", signatures, now_seconds() - start, bench_bmem_allocations());
+}
+
+static void run_signer(const EVP_PKEY *keys) {
+
+    int              signatures = 0;
+    crypto_signer_t *signer     = crypto_signer_create(keys);
+
+    bench_bmem_reset();
+
+    double start = now_seconds();
+
+    for (int i = 0; i < ITERATIONS; i++) {
+        uint8_t header[CRYPTO_SIGNATURE_HEADER_SIZE];
+
+        if (crypto_signer_sign(signer, g_url, "", g_payload, header)) {
+            signatures++;
+        }
+    }
+
+    report("signer", signatures, now_seconds() - start, bench_bmem_allocations());
+
+    crypto_signer_free(&signer);
+}
+
+int main(void) {
+
+    EVP_PKEY *keys = crypto_generate_keys();
+
+    if (!keys) {
+        fprintf(stderr, "Unable to generate the keys\n");
+        return 1;
+    }
+
+    run_one_shot(keys);
+    run_signer(keys);
+
+    EVP_PKEY_free(keys);
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include "bench_bmem.h"
+
+#include "net/http/http_buffer.h"
+
+#include <util/bmem.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Compares the cost of accumulating HTTP response bodies:
+ *  - naive:    brealloc on every chunk (previous curl_write_cb behavior)
+ *  - doubling: http_buffer_t growing geometrically
+ *  - arena:    http_buffer_t borrowing the thread arena (no Content-Length)
+ *  - presized: http_buffer_t reserved from Content-Length
+ *
+ * Each simulated request receives a body in network-sized chunks, then hands
+ * the body over to the caller which frees it.
+ */
+
+#define REQUESTS   2000
+#define CHUNK_SIZE 1400
+
+typedef enum bench_mode {
+    BENCH_NAIVE,
+    BENCH_DOUBLING,
+    BENCH_ARENA,
+    BENCH_PRESIZED,
+} bench_mode_t;
+
+static const char *g_mode_names[] = {"naive", "doubling", "arena", "presized"};
+
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static char *receive_naive(const char *chunk, size_t body_size) {
+
+    char  *data = bzalloc(1);
+    size_t size = 0;
+
+    for (size_t received = 0; received < body_size; received += CHUNK_SIZE) {
+        size_t length = body_size - received < CHUNK_SIZE ? body_size - received : CHUNK_SIZE;
+
+        data = brealloc(data, size + length + 1);
+        memcpy(data + size, chunk, length);
+        size += length;
+        data[size] = '\0';
+    }
+
+    return data;
+}
+
+static char *receive_buffered(const char *chunk, size_t body_size, bench_mode_t mode) {
+
+    http_buffer_t buffer;
+    http_buffer_init(&buffer, mode == BENCH_ARENA);
+
+    if (mode == BENCH_PRESIZED) {
+        http_buffer_reserve(&buffer, body_size);
+    }
+
+    for (size_t received = 0; received < body_size; received += CHUNK_SIZE) {
+        size_t length = body_size - received < CHUNK_SIZE ? body_size - received : CHUNK_SIZE;
+        http_buffer_append(&buffer, chunk, length);
+    }
+
+    return http_buffer_detach(&buffer, NULL);
+}
+
+static void run(bench_mode_t mode, size_t body_size) {
+
+    char chunk[CHUNK_SIZE];
+    memset(chunk, 'x', sizeof(chunk));
+
+    bench_bmem_reset();
+
+    double start = now_seconds();
+
+    for (int i = 0; i < REQUESTS; i++) {
+        char *body = mode == BENCH_NAIVE ? receive_naive(chunk, body_size) : receive_buffered(chunk, body_size, mode);
+        bfree(body);
+    }
+
+    double elapsed = now_seconds() - start;
+
+    printf("%-9s body=%7zu B  allocs/request=%7.2f  reallocs/request=%7.2f  us/request=%8.2f\n",
+           g_mode_names[mode],
+           body_size,
+           (double)bench_bmem_allocations() / REQUESTS,
+           (double)bench_bmem_reallocations() / REQUESTS,
+           elapsed * 1e6 / REQUESTS);
+}
+
+int main(void) {
+
+    const size_t body_sizes[] = {2 * 1024, 64 * 1024, 512 * 1024};
+
+    for (size_t i = 0; i < sizeof(body_sizes) / sizeof(body_sizes[0]); i++) {
+        run(BENCH_NAIVE, body_sizes[i]);
+        run(BENCH_DOUBLING, body_sizes[i]);
+        run(BENCH_ARENA, body_sizes[i]);
+        run(BENCH_PRESIZED, body_sizes[i]);
+        printf("\n");
+    }
+
+    return 0;
+}
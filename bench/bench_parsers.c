@@ -0,0 +1,128 @@
+#include "bench_bmem.h"
+
+#include "text/parsers.h"
+
+#include <cJSON.h>
+#include <cJSON_Utils.h>
+#include <util/bmem.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Measures how parse_achievement_catalog() scales with the size of the catalog.
+ *
+ * A synthetic response with N achievements (each with a media asset and two
+ * rewards) is parsed repeatedly. The time per achievement must stay flat as N
+ * grows. The "pointer" baseline resolves "/achievements/<i>/id" for every index
+ * the way the former parser did, which grows linearly per achievement.
+ */
+
+#define TARGET_ACHIEVEMENTS 20000
+
+static const char *g_achievement_format =
+    "{\"id\":\"%d\",\"serviceConfigId\":\"00000000-0000-0000-0000-00007972ac43\",\"name\":\"Achievement %d\","
+    "\"progressState\":\"NotStarted\",\"mediaAssets\":[{\"name\":\"icon\",\"type\":\"Icon\","
+    "\"url\":\"https://images-eds-ssl.xboxlive.com/image?url=%d\"}],\"isSecret\":false,"
+    "\"description\":\"You did thing %d.\",\"lockedDescription\":\"Do thing %d.\","
+    "\"rewards\":[{\"value\":\"Hat\",\"type\":\"InApp\"},{\"value\":\"10\",\"type\":\"Gamerscore\"}]}";
+
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static char *build_response(int count) {
+
+    size_t capacity = 64 + (size_t)count * 512;
+    char  *json     = bmalloc(capacity);
+    size_t length   = (size_t)snprintf(json, capacity, "{\"achievements\":[");
+
+    for (int i = 0; i < count; i++) {
+        if (i > 0) {
+            json[length++] = ',';
+        }
+        length += (size_t)snprintf(json + length, capacity - length, g_achievement_format, i, i, i, i, i);
+    }
+
+    snprintf(json + length, capacity - length, "]}");
+
+    return json;
+}
+
+static size_t lookup_with_pointers(const cJSON *json_root) {
+
+    size_t found = 0;
+
+    for (int index = 0;; index++) {
+        char pointer[64];
+        snprintf(pointer, sizeof(pointer), "/achievements/%d/id", index);
+
+        if (!cJSONUtils_GetPointer((cJSON *)json_root, pointer)) {
+            break;
+        }
+
+        found++;
+    }
+
+    return found;
+}
+
+static void run(int count) {
+
+    char  *json       = build_response(count);
+    int    iterations = TARGET_ACHIEVEMENTS / count > 0 ? TARGET_ACHIEVEMENTS / count : 1;
+    size_t parsed     = 0;
+
+    bench_bmem_reset();
+
+    double start = now_seconds();
+
+    for (int i = 0; i < iterations; i++) {
+        achievement_catalog_t *catalog = parse_achievement_catalog(json);
+
+        for (const achievement_t *achievement = achievement_catalog_get_achievements(catalog); achievement;
+             achievement                      = achievement->next) {
+            parsed++;
+        }
+
+        free_achievement_catalog(&catalog);
+    }
+
+    double parse_elapsed = now_seconds() - start;
+    size_t allocations   = bench_bmem_allocations();
+
+    cJSON *json_root = cJSON_Parse(json);
+
+    start = now_seconds();
+
+    for (int i = 0; i < iterations; i++) {
+        lookup_with_pointers(json_root);
+    }
+
+    double pointer_elapsed = now_seconds() - start;
+
+    cJSON_Delete(json_root);
+    bfree(json);
+
+    printf("achievements=%5d  parsed=%6zu  allocs/achievement=%5.2f  parse us/achievement=%6.3f  pointer "
+           "us/achievement=%8.3f\n",
+           count,
+           parsed / (size_t)iterations,
+           (double)allocations / (double)parsed,
+           parse_elapsed * 1e6 / ((double)iterations * count),
+           pointer_elapsed * 1e6 / ((double)iterations * count));
+}
+
+int main(void) {
+
+    const int counts[] = {10, 100, 1000, 5000};
+
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        run(counts[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,410 @@
+#include "achievement_catalog.h"
+
+#include <obs-module.h>
+#include <util/threading.h>
+
+#include <stdint.h>
+#include <string.h>
+
+/** Alignment of each section of the catalog block */
+#define SECTION_ALIGNMENT 16
+
+#define ALIGN_UP(size) (((size) + (SECTION_ALIGNMENT - 1)) & ~(size_t)(SECTION_ALIGNMENT - 1))
+
+/** Index slot value marking an empty slot (slots store the record index + 1) */
+#define EMPTY_SLOT 0
+
+struct achievement_catalog {
+    /** Number of owners; the catalog is freed when the last one releases it */
+    volatile long references;
+
+    achievement_t *achievements;
+    size_t         achievement_count;
+    size_t         achievement_capacity;
+
+    media_asset_t *media_assets;
+    size_t         media_asset_count;
+    size_t         media_asset_capacity;
+
+    reward_t *rewards;
+    size_t    reward_count;
+    size_t    reward_capacity;
+
+    /** Open-addressing (linear probing) table; its capacity is a power of two */
+    uint32_t *index;
+    size_t    index_capacity;
+
+    char  *text;
+    size_t text_size;
+    size_t text_capacity;
+
+    /** Achievements owning the last media asset / reward, used to chain the next one in O(1) */
+    const achievement_t *last_media_asset_owner;
+    const achievement_t *last_reward_owner;
+};
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+static char fold_case(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+}
+
+/**
+ * @brief FNV-1a hash of the case-folded id.
+ */
+static uint32_t hash_id(const char *id) {
+
+    uint32_t hash = 2166136261u;
+
+    for (const char *c = id; *c; c++) {
+        hash ^= (uint8_t)fold_case(*c);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static bool ids_match(const char *left, const char *right) {
+
+    while (*left && fold_case(*left) == fold_case(*right)) {
+        left++;
+        right++;
+    }
+
+    return fold_case(*left) == fold_case(*right);
+}
+
+static size_t compute_index_capacity(size_t achievement_count) {
+
+    /* Keeps the load factor at or below 50% so probes stay short */
+    size_t capacity = 8;
+
+    while (capacity < achievement_count * 2) {
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
+static void index_achievement(achievement_catalog_t *catalog, size_t achievement_index) {
+
+    const char *id   = catalog->achievements[achievement_index].id;
+    size_t      mask = catalog->index_capacity - 1;
+    size_t      slot = hash_id(id) & mask;
+
+    while (catalog->index[slot] != EMPTY_SLOT) {
+
+        if (ids_match(catalog->achievements[catalog->index[slot] - 1].id, id)) {
+            /* Duplicated id: the first achievement wins */
+            return;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    catalog->index[slot] = (uint32_t)(achievement_index + 1);
+}
+
+static size_t text_length(const char *text) {
+    return text ? strlen(text) + 1 : 0;
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Creates an empty catalog.
+ *
+ * Every section (records, index, text) lives in a single zeroed allocation.
+ */
+achievement_catalog_t *create_achievement_catalog(size_t achievement_count,
+                                                  size_t media_asset_count,
+                                                  size_t reward_count,
+                                                  size_t text_size) {
+
+    if (achievement_count >= UINT32_MAX) {
+        return NULL;
+    }
+
+    size_t index_capacity = compute_index_capacity(achievement_count);
+
+    size_t achievements_offset = ALIGN_UP(sizeof(achievement_catalog_t));
+    size_t media_assets_offset = ALIGN_UP(achievements_offset + achievement_count * sizeof(achievement_t));
+    size_t rewards_offset      = ALIGN_UP(media_assets_offset + media_asset_count * sizeof(media_asset_t));
+    size_t index_offset        = ALIGN_UP(rewards_offset + reward_count * sizeof(reward_t));
+    size_t text_offset         = ALIGN_UP(index_offset + index_capacity * sizeof(uint32_t));
+    size_t total_size          = text_offset + text_size;
+
+    uint8_t *block = bzalloc(total_size);
+
+    if (!block) {
+        return NULL;
+    }
+
+    achievement_catalog_t *catalog = (achievement_catalog_t *)block;
+    catalog->references            = 1;
+    catalog->achievements          = (achievement_t *)(block + achievements_offset);
+    catalog->achievement_capacity  = achievement_count;
+    catalog->media_assets          = (media_asset_t *)(block + media_assets_offset);
+    catalog->media_asset_capacity  = media_asset_count;
+    catalog->rewards               = (reward_t *)(block + rewards_offset);
+    catalog->reward_capacity       = reward_count;
+    catalog->index                 = (uint32_t *)(block + index_offset);
+    catalog->index_capacity        = index_capacity;
+    catalog->text                  = (char *)(block + text_offset);
+    catalog->text_capacity         = text_size;
+
+    return catalog;
+}
+
+/**
+ * @brief Creates a catalog holding a copy of an achievement list.
+ *
+ * Sizes the catalog with a first pass over the list, then copies every record.
+ */
+achievement_catalog_t *create_achievement_catalog_from_list(const achievement_t *achievements) {
+
+    size_t achievement_count = 0;
+    size_t media_asset_count = 0;
+    size_t reward_count      = 0;
+    size_t text_size         = 0;
+
+    for (const achievement_t *achievement = achievements; achievement; achievement = achievement->next) {
+
+        if (!achievement->id) {
+            continue;
+        }
+
+        achievement_count++;
+        text_size += text_length(achievement->id) + text_length(achievement->service_config_id) +
+                     text_length(achievement->name) + text_length(achievement->progress_state) +
+                     text_length(achievement->description) + text_length(achievement->locked_description);
+
+        for (const media_asset_t *media_asset = achievement->media_assets; media_asset; media_asset = media_asset->next) {
+            media_asset_count++;
+            text_size += text_length(media_asset->url);
+        }
+
+        for (const reward_t *reward = achievement->rewards; reward; reward = reward->next) {
+            reward_count++;
+            text_size += text_length(reward->value);
+        }
+    }
+
+    achievement_catalog_t *catalog =
+        create_achievement_catalog(achievement_count, media_asset_count, reward_count, text_size);
+
+    if (!catalog) {
+        return NULL;
+    }
+
+    for (const achievement_t *source = achievements; source; source = source->next) {
+
+        achievement_t *achievement = achievement_catalog_add(catalog, source->id);
+
+        if (!achievement) {
+            continue;
+        }
+
+        achievement->service_config_id  = achievement_catalog_store_text(catalog, source->service_config_id);
+        achievement->name               = achievement_catalog_store_text(catalog, source->name);
+        achievement->progress_state     = achievement_catalog_store_text(catalog, source->progress_state);
+        achievement->description        = achievement_catalog_store_text(catalog, source->description);
+        achievement->locked_description = achievement_catalog_store_text(catalog, source->locked_description);
+        achievement->is_secret          = source->is_secret;
+
+        for (const media_asset_t *media_asset = source->media_assets; media_asset; media_asset = media_asset->next) {
+            achievement_catalog_add_media_asset(catalog, achievement, media_asset->url);
+        }
+
+        for (const reward_t *reward = source->rewards; reward; reward = reward->next) {
+            achievement_catalog_add_reward(catalog, achievement, reward->value);
+        }
+    }
+
+    return catalog;
+}
+
+/**
+ * @brief Deep-copies a catalog.
+ */
+achievement_catalog_t *copy_achievement_catalog(const achievement_catalog_t *catalog) {
+
+    if (!catalog) {
+        return NULL;
+    }
+
+    return create_achievement_catalog_from_list(achievement_catalog_get_achievements(catalog));
+}
+
+/**
+ * @brief Adds an owner to a catalog.
+ *
+ * The reference count is atomic because snapshots sharing the catalog are
+ * released on other threads.
+ */
+achievement_catalog_t *retain_achievement_catalog(achievement_catalog_t *catalog) {
+
+    if (catalog) {
+        os_atomic_inc_long(&catalog->references);
+    }
+
+    return catalog;
+}
+
+/**
+ * @brief Releases the caller's reference and sets the caller's pointer to NULL.
+ *
+ * The records, index and text share the catalog allocation, so freeing the last
+ * reference is a single free.
+ */
+void free_achievement_catalog(achievement_catalog_t **catalog) {
+
+    if (!catalog || !*catalog) {
+        return;
+    }
+
+    achievement_catalog_t *current = *catalog;
+    *catalog                       = NULL;
+
+    if (os_atomic_dec_long(&current->references) > 0) {
+        return;
+    }
+
+    bfree(current);
+}
+
+const char *achievement_catalog_store_text(achievement_catalog_t *catalog, const char *text) {
+
+    if (!catalog || !text) {
+        return NULL;
+    }
+
+    size_t length = strlen(text) + 1;
+
+    if (length > catalog->text_capacity - catalog->text_size) {
+        return NULL;
+    }
+
+    char *copy = catalog->text + catalog->text_size;
+    memcpy(copy, text, length);
+    catalog->text_size += length;
+
+    return copy;
+}
+
+achievement_t *achievement_catalog_add(achievement_catalog_t *catalog, const char *id) {
+
+    if (!catalog || !id || catalog->achievement_count >= catalog->achievement_capacity) {
+        return NULL;
+    }
+
+    const char *stored_id = achievement_catalog_store_text(catalog, id);
+
+    if (!stored_id) {
+        return NULL;
+    }
+
+    size_t         achievement_index = catalog->achievement_count++;
+    achievement_t *achievement       = &catalog->achievements[achievement_index];
+    achievement->id                  = stored_id;
+
+    if (achievement_index > 0) {
+        catalog->achievements[achievement_index - 1].next = achievement;
+    }
+
+    index_achievement(catalog, achievement_index);
+
+    return achievement;
+}
+
+bool achievement_catalog_add_media_asset(achievement_catalog_t *catalog, achievement_t *achievement, const char *url) {
+
+    if (!catalog || !achievement || catalog->media_asset_count >= catalog->media_asset_capacity) {
+        return false;
+    }
+
+    const char *stored_url = achievement_catalog_store_text(catalog, url);
+
+    if (!stored_url) {
+        return false;
+    }
+
+    media_asset_t *media_asset = &catalog->media_assets[catalog->media_asset_count++];
+    media_asset->url           = stored_url;
+
+    if (catalog->last_media_asset_owner == achievement) {
+        media_asset[-1].next = media_asset;
+    } else {
+        achievement->media_assets = media_asset;
+    }
+
+    catalog->last_media_asset_owner = achievement;
+
+    return true;
+}
+
+bool achievement_catalog_add_reward(achievement_catalog_t *catalog, achievement_t *achievement, const char *value) {
+
+    if (!catalog || !achievement || catalog->reward_count >= catalog->reward_capacity) {
+        return false;
+    }
+
+    const char *stored_value = achievement_catalog_store_text(catalog, value);
+
+    if (!stored_value) {
+        return false;
+    }
+
+    reward_t *reward = &catalog->rewards[catalog->reward_count++];
+    reward->value    = stored_value;
+
+    if (catalog->last_reward_owner == achievement) {
+        reward[-1].next = reward;
+    } else {
+        achievement->rewards = reward;
+    }
+
+    catalog->last_reward_owner = achievement;
+
+    return true;
+}
+
+const achievement_t *achievement_catalog_find(const achievement_catalog_t *catalog, const char *id) {
+
+    if (!catalog || !id || catalog->achievement_count == 0) {
+        return NULL;
+    }
+
+    size_t mask = catalog->index_capacity - 1;
+    size_t slot = hash_id(id) & mask;
+
+    while (catalog->index[slot] != EMPTY_SLOT) {
+
+        const achievement_t *achievement = &catalog->achievements[catalog->index[slot] - 1];
+
+        if (ids_match(achievement->id, id)) {
+            return achievement;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return NULL;
+}
+
+const achievement_t *achievement_catalog_get_achievements(const achievement_catalog_t *catalog) {
+
+    if (!catalog || catalog->achievement_count == 0) {
+        return NULL;
+    }
+
+    return catalog->achievements;
+}
+
+size_t achievement_catalog_count(const achievement_catalog_t *catalog) {
+    return catalog ? catalog->achievement_count : 0;
+}
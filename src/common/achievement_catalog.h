@@ -0,0 +1,165 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "common/achievement.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Achievement definitions of a game, stored contiguously.
+ *
+ * A catalog is a single allocation holding:
+ * - an array of @c achievement_t records, chained through @c next in array order
+ *   so the catalog can still be walked like a regular achievement list;
+ * - arrays of @c media_asset_t and @c reward_t records referenced by the
+ *   achievements;
+ * - an open-addressing hash index keyed on the case-folded achievement id;
+ * - a text arena owning every string referenced by the records.
+ *
+ * The capacities are fixed when the catalog is created, typically after a
+ * sizing pass over the source data.
+ *
+ * Ownership:
+ * - Catalogs are reference counted. Each owner, the creator included, releases
+ *   its reference with @ref free_achievement_catalog; owners are added with
+ *   @ref retain_achievement_catalog.
+ * - A catalog must not be modified once it has more than one owner.
+ * - Records returned by the catalog belong to it. They must never be passed to
+ *   @ref free_achievement, @ref free_media_asset or @ref free_reward.
+ */
+typedef struct achievement_catalog achievement_catalog_t;
+
+/**
+ * @brief Creates an empty catalog.
+ *
+ * @param achievement_count Number of achievements the catalog can hold.
+ * @param media_asset_count Number of media assets the catalog can hold.
+ * @param reward_count Number of rewards the catalog can hold.
+ * @param text_size Number of bytes of text (including NUL terminators) the catalog can hold.
+ *
+ * @return Newly allocated catalog, or NULL on allocation failure.
+ */
+achievement_catalog_t *create_achievement_catalog(size_t achievement_count,
+                                                  size_t media_asset_count,
+                                                  size_t reward_count,
+                                                  size_t text_size);
+
+/**
+ * @brief Creates a catalog holding a copy of an achievement list.
+ *
+ * @param achievements Head of the source list (may be NULL).
+ *
+ * @return Newly allocated catalog (empty if @p achievements is NULL), or NULL on
+ *         allocation failure.
+ */
+achievement_catalog_t *create_achievement_catalog_from_list(const achievement_t *achievements);
+
+/**
+ * @brief Deep-copies a catalog.
+ *
+ * @param catalog Source catalog (may be NULL).
+ *
+ * @return Newly allocated copy of @p catalog, or NULL if @p catalog is NULL.
+ */
+achievement_catalog_t *copy_achievement_catalog(const achievement_catalog_t *catalog);
+
+/**
+ * @brief Adds an owner to a catalog without copying it.
+ *
+ * @param catalog Catalog to share (may be NULL).
+ *
+ * @return @p catalog. The caller owns the new reference and must release it with
+ *         @ref free_achievement_catalog.
+ */
+achievement_catalog_t *retain_achievement_catalog(achievement_catalog_t *catalog);
+
+/**
+ * @brief Releases a reference to a catalog and sets the caller's pointer to NULL.
+ *
+ * The catalog is freed when its last reference is released. Safe to call with
+ * NULL or with @c *catalog == NULL.
+ *
+ * @param[in,out] catalog Address of the catalog pointer to release.
+ */
+void free_achievement_catalog(achievement_catalog_t **catalog);
+
+/**
+ * @brief Copies a string into the text arena of the catalog.
+ *
+ * @param catalog Catalog to store the string in.
+ * @param text String to copy (may be NULL).
+ *
+ * @return Copy owned by the catalog, or NULL if @p text is NULL or the arena is full.
+ */
+const char *achievement_catalog_store_text(achievement_catalog_t *catalog, const char *text);
+
+/**
+ * @brief Appends an achievement to the catalog and indexes it by id.
+ *
+ * The other fields of the returned record are zeroed and can be filled with
+ * text stored through @ref achievement_catalog_store_text. If several
+ * achievements share an id, lookups return the first one.
+ *
+ * @param catalog Catalog to append to.
+ * @param id Achievement id.
+ *
+ * @return The new record, or NULL if @p id is NULL or the catalog is full.
+ */
+achievement_t *achievement_catalog_add(achievement_catalog_t *catalog, const char *id);
+
+/**
+ * @brief Appends a media asset to an achievement of the catalog.
+ *
+ * The media assets of an achievement must be added before moving on to the
+ * next achievement.
+ *
+ * @return false if @p url is NULL or the catalog is full.
+ */
+bool achievement_catalog_add_media_asset(achievement_catalog_t *catalog, achievement_t *achievement, const char *url);
+
+/**
+ * @brief Appends a reward to an achievement of the catalog.
+ *
+ * The rewards of an achievement must be added before moving on to the next
+ * achievement.
+ *
+ * @return false if @p value is NULL or the catalog is full.
+ */
+bool achievement_catalog_add_reward(achievement_catalog_t *catalog, achievement_t *achievement, const char *value);
+
+/**
+ * @brief Finds an achievement by id (case-insensitive) in constant time.
+ *
+ * @param catalog Catalog to search (may be NULL).
+ * @param id Achievement id (may be NULL).
+ *
+ * @return Matching record, or NULL if not found.
+ */
+const achievement_t *achievement_catalog_find(const achievement_catalog_t *catalog, const char *id);
+
+/**
+ * @brief Returns the achievements of the catalog as a list.
+ *
+ * @param catalog Catalog to read (may be NULL).
+ *
+ * @return First record, chained to the others through @c next, or NULL if the
+ *         catalog is NULL or empty.
+ */
+const achievement_t *achievement_catalog_get_achievements(const achievement_catalog_t *catalog);
+
+/**
+ * @brief Returns the number of achievements in the catalog.
+ *
+ * @param catalog Catalog to read (may be NULL).
+ *
+ * @return Number of achievements, or 0 if @p catalog is NULL.
+ */
+size_t achievement_catalog_count(const achievement_catalog_t *catalog);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,28 @@
+#include "device.h"
+
+#include "memory.h"
+
+/**
+ * @brief Frees a device and sets the caller's pointer to NULL.
+ *
+ * Frees the identifiers and then the @c device_t object itself. The key pair is
+ * borrowed from the state subsystem and is not freed.
+ *
+ * Safe to call with NULL or with @c *device == NULL.
+ *
+ * @param[in,out] device Address of the @c device_t pointer to free.
+ */
+void free_device(device_t **device) {
+
+    if (!device || !*device) {
+        return;
+    }
+
+    device_t *current = *device;
+
+    free_memory((void **)&current->uuid);
+    free_memory((void **)&current->serial_number);
+
+    bfree(current);
+    *device = NULL;
+}
@@ -13,12 +13,13 @@ extern "C" {
  * number) and an OpenSSL keypair used as a proof-of-ownership credential.
  *
  * Ownership/lifetime:
- * - This header does not define constructors/destructors for @c device_t.
- *   Callers are responsible for managing the lifetime of the pointed-to strings
- *   and the OpenSSL key object.
- * - @c keys is an OpenSSL @c EVP_PKEY pointer. Whether it is borrowed or owned
- *   depends on the code that populates the struct. If you take ownership,
- *   release it with @c EVP_PKEY_free().
+ * - Instances returned by state_get_device() are owned by the caller and must
+ *   be freed with @ref free_device.
+ * - @c uuid and @c serial_number are owned by the instance and freed by
+ *   @ref free_device.
+ * - @c keys is borrowed: it is the process-wide key pair cached by the state
+ *   subsystem and shared by every @c device_t. It must not be freed with
+ *   @c EVP_PKEY_free(); it is released by io_unload().
  */
 typedef struct device {
     /** Unique identifier for the device (typically a UUID string). */
@@ -29,6 +30,17 @@ typedef struct device {
     const EVP_PKEY *keys;
 } device_t;
 
+/**
+ * @brief Frees a device and sets the caller's pointer to NULL.
+ *
+ * The borrowed key pair is left untouched.
+ *
+ * Safe to call with NULL or with @c *device == NULL.
+ *
+ * @param[in,out] device Address of the @c device_t pointer to free.
+ */
+void free_device(device_t **device);
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,11 +2,107 @@
 
 #include <obs-module.h>
 
+#include <stdint.h>
+
+/** Smallest number of slots allocated for the set of unlocked ids */
+#define MIN_UNLOCKED_IDS_CAPACITY 16
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+static char fold_case(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+}
+
+/**
+ * @brief FNV-1a hash of the case-folded id.
+ */
+static uint32_t hash_id(const char *id) {
+
+    uint32_t hash = 2166136261u;
+
+    for (const char *c = id; *c; c++) {
+        hash ^= (uint8_t)fold_case(*c);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static bool ids_match(const char *left, const char *right) {
+
+    while (*left && fold_case(*left) == fold_case(*right)) {
+        left++;
+        right++;
+    }
+
+    return fold_case(*left) == fold_case(*right);
+}
+
+/**
+ * @brief Returns the slot holding @p id, or the empty slot where it would be inserted.
+ */
+static size_t find_slot(const char *const *ids, size_t capacity, const char *id) {
+
+    size_t mask = capacity - 1;
+    size_t slot = hash_id(id) & mask;
+
+    while (ids[slot] && !ids_match(ids[slot], id)) {
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+/**
+ * @brief Makes room for one more id, keeping the load factor at or below 50%.
+ */
+static bool reserve_unlocked_id(gamerscore_t *gamerscore) {
+
+    size_t needed = (gamerscore->unlocked_count + 1) * 2;
+
+    if (needed <= gamerscore->unlocked_ids_capacity) {
+        return true;
+    }
+
+    size_t capacity = gamerscore->unlocked_ids_capacity ? gamerscore->unlocked_ids_capacity : MIN_UNLOCKED_IDS_CAPACITY;
+
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+
+    const char **ids = bzalloc(capacity * sizeof(const char *));
+
+    if (!ids) {
+        return false;
+    }
+
+    for (size_t i = 0; i < gamerscore->unlocked_ids_capacity; i++) {
+        const char *id = gamerscore->unlocked_ids[i];
+
+        if (id) {
+            ids[find_slot(ids, capacity, id)] = id;
+        }
+    }
+
+    bfree((void *)gamerscore->unlocked_ids);
+    gamerscore->unlocked_ids          = ids;
+    gamerscore->unlocked_ids_capacity = capacity;
+
+    return true;
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public functions
+//  --------------------------------------------------------------------------------------------------------------------
+
 /**
  * @brief Creates a deep copy of a gamerscore object.
  *
- * Duplicates the gamerscore container and deep-copies its linked list of
- * unlocked achievements.
+ * Duplicates the gamerscore container, its list of unlocked achievements and its
+ * set of ids. The set is allocated once with the capacity of the source and the
+ * ids are known to be unique, so nothing is rehashed or checked twice.
  *
  * @param gamerscore Source gamerscore to copy (may be NULL).
  *
@@ -22,8 +118,32 @@ gamerscore_t *copy_gamerscore(const gamerscore_t *gamerscore) {
 
     gamerscore_t *copy = bzalloc(sizeof(gamerscore_t));
 
-    copy->base_value            = gamerscore->base_value;
-    copy->unlocked_achievements = copy_unlocked_achievement(gamerscore->unlocked_achievements);
+    copy->base_value     = gamerscore->base_value;
+    copy->unlocked_value = gamerscore->unlocked_value;
+    copy->unlocked_count = gamerscore->unlocked_count;
+
+    if (gamerscore->unlocked_ids_capacity > 0) {
+        copy->unlocked_ids          = bzalloc(gamerscore->unlocked_ids_capacity * sizeof(const char *));
+        copy->unlocked_ids_capacity = gamerscore->unlocked_ids_capacity;
+    }
+
+    for (const unlocked_achievement_t *current = gamerscore->unlocked_achievements; current; current = current->next) {
+
+        unlocked_achievement_t *unlocked_achievement = bzalloc(sizeof(unlocked_achievement_t));
+        unlocked_achievement->id                     = bstrdup(current->id);
+        unlocked_achievement->value                  = current->value;
+
+        if (copy->last_unlocked_achievement) {
+            copy->last_unlocked_achievement->next = unlocked_achievement;
+        } else {
+            copy->unlocked_achievements = unlocked_achievement;
+        }
+
+        copy->last_unlocked_achievement = unlocked_achievement;
+
+        size_t slot              = find_slot(copy->unlocked_ids, copy->unlocked_ids_capacity, current->id);
+        copy->unlocked_ids[slot] = unlocked_achievement->id;
+    }
 
     return copy;
 }
@@ -31,8 +151,8 @@ gamerscore_t *copy_gamerscore(const gamerscore_t *gamerscore) {
 /**
  * @brief Frees a gamerscore object and sets the caller's pointer to NULL.
  *
- * Frees nested allocations (the unlocked achievements list) and then frees the
- * gamerscore container.
+ * Frees nested allocations (the unlocked achievements list and the set of ids)
+ * and then frees the gamerscore container.
  *
  * Safe to call with NULL or with @c *gamerscore == NULL.
  *
@@ -46,16 +166,62 @@ void free_gamerscore(gamerscore_t **gamerscore) {
 
     gamerscore_t *current = *gamerscore;
     free_unlocked_achievement(&current->unlocked_achievements);
+    bfree((void *)current->unlocked_ids);
 
     bfree(current);
     *gamerscore = NULL;
 }
 
+bool gamerscore_add_unlocked_achievement(gamerscore_t *gamerscore, const char *id, int value) {
+
+    if (!gamerscore || !id) {
+        return false;
+    }
+
+    if (gamerscore_is_unlocked(gamerscore, id)) {
+        return false;
+    }
+
+    if (!reserve_unlocked_id(gamerscore)) {
+        return false;
+    }
+
+    unlocked_achievement_t *unlocked_achievement = bzalloc(sizeof(unlocked_achievement_t));
+    unlocked_achievement->id                     = bstrdup(id);
+    unlocked_achievement->value                  = value;
+
+    if (gamerscore->last_unlocked_achievement) {
+        gamerscore->last_unlocked_achievement->next = unlocked_achievement;
+    } else {
+        gamerscore->unlocked_achievements = unlocked_achievement;
+    }
+
+    gamerscore->last_unlocked_achievement = unlocked_achievement;
+    gamerscore->unlocked_value += value;
+    gamerscore->unlocked_count++;
+
+    size_t slot                    = find_slot(gamerscore->unlocked_ids, gamerscore->unlocked_ids_capacity, id);
+    gamerscore->unlocked_ids[slot] = unlocked_achievement->id;
+
+    return true;
+}
+
+bool gamerscore_is_unlocked(const gamerscore_t *gamerscore, const char *id) {
+
+    if (!gamerscore || !id || gamerscore->unlocked_ids_capacity == 0) {
+        return false;
+    }
+
+    size_t slot = find_slot(gamerscore->unlocked_ids, gamerscore->unlocked_ids_capacity, id);
+
+    return gamerscore->unlocked_ids[slot] != NULL;
+}
+
 /**
  * @brief Computes the total gamerscore.
  *
- * Returns the base gamerscore plus the sum of values from all unlocked
- * achievements.
+ * Returns the base gamerscore plus the running total of the unlocked
+ * achievements, without walking the list.
  *
  * @param gamerscore Gamerscore container (may be NULL).
  *
@@ -67,14 +233,5 @@ int gamerscore_compute(const gamerscore_t *gamerscore) {
         return 0;
     }
 
-    int total_value = gamerscore->base_value;
-
-    const unlocked_achievement_t *current = gamerscore->unlocked_achievements;
-
-    while (current) {
-        total_value += current->value;
-        current = current->next;
-    }
-
-    return total_value;
+    return gamerscore->base_value + gamerscore->unlocked_value;
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <stdbool.h>
+#include <stddef.h>
+
 #include "common/unlocked_achievement.h"
 
 #ifdef __cplusplus
@@ -15,6 +18,11 @@ extern "C" {
  * When an achievement is unlocked, the gamerscore is not immediately updated on the server so retrieving it
  * via the API is not working. Instead, I chose to keep track of all the unlocked achievements locally.
  *
+ * Unlocked achievements are added with @ref gamerscore_add_unlocked_achievement,
+ * which keeps a running total of their values and a hash set of their ids so that
+ * computing the total and rejecting an already unlocked achievement are both
+ * constant time.
+ *
  * Ownership:
  * - Instances returned by @ref copy_gamerscore are owned by the caller and must
  *   be freed with @ref free_gamerscore.
@@ -26,6 +34,16 @@ typedef struct gamerscore {
     int                     base_value;
     /** Linked list of unlocked achievements used to compute additional score. */
     unlocked_achievement_t *unlocked_achievements;
+    /** Last node of @c unlocked_achievements, used to append in constant time. */
+    unlocked_achievement_t *last_unlocked_achievement;
+    /** Sum of the values of @c unlocked_achievements. */
+    int                     unlocked_value;
+    /** Number of nodes in @c unlocked_achievements. */
+    size_t                  unlocked_count;
+    /** Open-addressing set of the unlocked ids (pointing into the list nodes). */
+    const char            **unlocked_ids;
+    /** Number of slots of @c unlocked_ids (a power of two, or 0). */
+    size_t                  unlocked_ids_capacity;
 } gamerscore_t;
 
 /**
@@ -39,10 +57,37 @@ typedef struct gamerscore {
  */
 gamerscore_t *copy_gamerscore(const gamerscore_t *gamerscore);
 
+/**
+ * @brief Records an unlocked achievement.
+ *
+ * Appends the achievement to @c unlocked_achievements and adds its value to the
+ * running total. Achievements already recorded (ids are compared case-insensitively)
+ * are ignored, so replayed unlock events do not count twice.
+ *
+ * @param gamerscore Gamerscore container.
+ * @param id Id of the unlocked achievement (copied).
+ * @param value Gamerscore value of the achievement.
+ *
+ * @return true if the achievement was recorded, false if it was already recorded,
+ *         if an argument is NULL or on allocation failure.
+ */
+bool gamerscore_add_unlocked_achievement(gamerscore_t *gamerscore, const char *id, int value);
+
+/**
+ * @brief Tells whether an achievement has already been recorded as unlocked.
+ *
+ * @param gamerscore Gamerscore container (may be NULL).
+ * @param id Achievement id (may be NULL).
+ *
+ * @return true if @p id was recorded with @ref gamerscore_add_unlocked_achievement.
+ */
+bool gamerscore_is_unlocked(const gamerscore_t *gamerscore, const char *id);
+
 /**
  * @brief Computes the total gamerscore.
  *
- * Returns @c base_value plus the sum of values from all unlocked achievements.
+ * Returns @c base_value plus the running total of the achievements recorded with
+ * @ref gamerscore_add_unlocked_achievement.
  *
  * @param gamerscore Gamerscore container (may be NULL).
  *
@@ -0,0 +1,35 @@
+#include "recent_title.h"
+
+#include "memory.h"
+#include <obs-module.h>
+
+/**
+ * @brief Frees a list of recent titles and sets the caller's pointer to NULL.
+ *
+ * Frees every node of the list along with its strings.
+ *
+ * Safe to call with NULL or with @c *titles == NULL.
+ *
+ * @param[in,out] titles Address of the head of the list to free.
+ */
+void free_recent_titles(recent_title_t **titles) {
+
+    if (!titles) {
+        return;
+    }
+
+    recent_title_t *current = *titles;
+
+    while (current) {
+        recent_title_t *next = current->next;
+
+        free_memory((void **)&current->id);
+        free_memory((void **)&current->title);
+        free_memory((void **)&current->cover_url);
+        bfree(current);
+
+        current = next;
+    }
+
+    *titles = NULL;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Game recently played by the user, as listed by the title history.
+ *
+ * Ownership:
+ * - Lists returned by the parsers are owned by the caller and must be freed
+ *   with @ref free_recent_titles.
+ * - String fields are owned by their node and freed by @ref free_recent_titles.
+ */
+typedef struct recent_title {
+    /** Game identifier (service-provided). */
+    const char          *id;
+    /** Human-readable title. */
+    const char          *title;
+    /** URL of the cover art of the game, or NULL if it has none. */
+    const char          *cover_url;
+    /** Next title in the list (less recently played), or NULL. */
+    struct recent_title *next;
+} recent_title_t;
+
+/**
+ * @brief Frees a list of recent titles and sets the caller's pointer to NULL.
+ *
+ * Safe to call with NULL or with @c *titles == NULL.
+ *
+ * @param[in,out] titles Address of the head of the list to free.
+ */
+void free_recent_titles(recent_title_t **titles);
+
+#ifdef __cplusplus
+}
+#endif
@@ -90,3 +90,12 @@ bool token_is_expired(const token_t *token) {
 
     return will_expire;
 }
+
+bool token_expires_within(const token_t *token, int64_t seconds) {
+
+    if (!token) {
+        return true;
+    }
+
+    return (int64_t)now() + seconds >= token->expires;
+}
@@ -51,6 +51,18 @@ void free_token(token_t **token);
  */
 bool token_is_expired(const token_t *token);
 
+/**
+ * @brief Checks whether a token expires within a given number of seconds.
+ *
+ * Unlike @ref token_is_expired, no safety margin is applied and nothing is logged.
+ *
+ * @param token   Token to check (may be NULL).
+ * @param seconds Number of seconds from now.
+ *
+ * @return True if the token expires in @p seconds or less (or @p token is NULL), false otherwise.
+ */
+bool token_expires_within(const token_t *token, int64_t seconds);
+
 #ifdef __cplusplus
 }
 #endif
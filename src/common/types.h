@@ -8,9 +8,11 @@
 // consumers can include a single header.
 #include "common/memory.h"
 #include "common/achievement.h"
+#include "common/achievement_catalog.h"
 #include "common/achievement_progress.h"
 #include "common/device.h"
 #include "common/game.h"
+#include "common/recent_title.h"
 #include "common/gamerscore.h"
 #include "common/token.h"
 #include "common/unlocked_achievement.h"
@@ -3,10 +3,11 @@
 #include <obs-module.h>
 
 /**
- * @brief Creates a deep copy of an Xbox session.
+ * @brief Creates a copy of an Xbox session.
  *
- * Performs a deep copy of the session container and its nested objects:
- * game, gamerscore, and achievements.
+ * Deep-copies the game and the gamerscore, which change while the game is
+ * played, and shares the achievement catalog, which does not, so copying a
+ * session does not duplicate every achievement of the game.
  *
  * @param session Source session to copy (may be NULL).
  *
@@ -23,7 +24,7 @@ xbox_session_t *copy_xbox_session(const xbox_session_t *session) {
     xbox_session_t *copy = bzalloc(sizeof(xbox_session_t));
     copy->game           = copy_game(session->game);
     copy->gamerscore     = copy_gamerscore(session->gamerscore);
-    copy->achievements   = copy_achievement(session->achievements);
+    copy->achievements   = retain_achievement_catalog(session->achievements);
 
     return copy;
 }
@@ -31,8 +32,8 @@ xbox_session_t *copy_xbox_session(const xbox_session_t *session) {
 /**
  * @brief Frees an Xbox session and sets the caller's pointer to NULL.
  *
- * Frees nested allocations (game, gamerscore, achievements) and then frees the
- * session container.
+ * Frees the game and the gamerscore, releases the session's reference to the
+ * achievement catalog and then frees the session container.
  *
  * Safe to call with NULL or with @c *session == NULL.
  *
@@ -48,7 +49,7 @@ void free_xbox_session(xbox_session_t **session) {
 
     free_game(&current->game);
     free_gamerscore(&current->gamerscore);
-    free_achievement(&current->achievements);
+    free_achievement_catalog(&current->achievements);
 
     bfree(current);
     *session = NULL;
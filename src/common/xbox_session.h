@@ -1,6 +1,6 @@
 #pragma once
 
-#include "common/achievement.h"
+#include "common/achievement_catalog.h"
 #include "common/game.h"
 #include "common/gamerscore.h"
 
@@ -11,26 +11,31 @@ extern "C" {
 /**
  * @brief Container for a user's current Xbox session state.
  *
- * Groups together the currently selected game, the gamerscore data, and the list
- * of achievements.
+ * Groups together the currently selected game, the gamerscore data, and the
+ * catalog of achievements.
  *
  * Ownership:
  * - Instances returned by @ref copy_xbox_session are owned by the caller and must
  *   be freed with @ref free_xbox_session.
- * - Nested pointers (@c game, @c gamerscore, @c achievements) are deep-copied by
- *   @ref copy_xbox_session and freed by @ref free_xbox_session.
+ * - @c game and @c gamerscore are deep-copied by @ref copy_xbox_session and freed
+ *   by @ref free_xbox_session.
+ * - @c achievements is shared by @ref copy_xbox_session (see
+ *   @ref retain_achievement_catalog) and released by @ref free_xbox_session, so
+ *   it must not be modified once the session has been copied.
  */
 typedef struct xbox_session {
     /** Current game information. */
-    game_t        *game;
+    game_t                *game;
     /** Gamerscore container (base value + unlocked achievements). */
-    gamerscore_t  *gamerscore;
-    /** Linked list of achievements for the game. */
-    achievement_t *achievements;
+    gamerscore_t          *gamerscore;
+    /** Catalog of achievements for the game, indexed by id. */
+    achievement_catalog_t *achievements;
 } xbox_session_t;
 
 /**
- * @brief Creates a deep copy of an Xbox session.
+ * @brief Creates a copy of an Xbox session.
+ *
+ * The game and the gamerscore are deep-copied; the achievement catalog is shared.
  *
  * @param session Source session to copy (may be NULL).
  *
@@ -16,6 +16,10 @@
 #include <diagnostics/log.h>
 
 #include "common/types.h"
+#include "crypto/crypto.h"
+
+/** Largest DER encoding of an ECDSA P-256 signature: SEQUENCE of two 33-byte INTEGERs */
+#define ECDSA_P256_MAX_DER_SIZE 72
 
 /**
  * @brief Debug helper that exports an EC keypair to PEM and logs/prints it.
@@ -640,92 +644,140 @@ static bool parse_url_path_and_query(const char *url, const char **out_begin, si
 }
 
 /**
- * @brief Sign a buffer with ECDSA P-256 + SHA-256 and output a P1363 signature.
+ * @brief Read one DER INTEGER of an ECDSA signature into a fixed 32-byte field.
  *
- * OpenSSL produces ECDSA signatures as DER-encoded (r,s). This helper signs using
- * EVP_DigestSign* then converts the DER signature into the fixed-width IEEE P1363
- * representation: r (32 bytes big-endian) || s (32 bytes big-endian).
+ * @param p      Cursor into the DER signature, advanced past the INTEGER.
+ * @param end    End of the DER signature.
+ * @param out32  Receives the value, big-endian and left-padded with zeros.
+ * @return true on success, false if the INTEGER is malformed or too large.
+ */
+static bool read_der_integer(const uint8_t **p, const uint8_t *end, uint8_t out32[32]) {
+
+    if (end - *p < 2 || (*p)[0] != 0x02) {
+        return false;
+    }
+
+    size_t length = (*p)[1];
+    *p += 2;
+
+    if (length == 0 || (size_t)(end - *p) < length) {
+        return false;
+    }
+
+    const uint8_t *value = *p;
+    *p += length;
+
+    /* Positive integers get a leading zero when their top bit is set */
+    while (length > 0 && *value == 0) {
+        value++;
+        length--;
+    }
+
+    if (length > 32) {
+        return false;
+    }
+
+    memset(out32, 0, 32 - length);
+    memcpy(out32 + 32 - length, value, length);
+
+    return true;
+}
+
+/**
+ * @brief Convert a DER-encoded ECDSA P-256 signature into its P1363 form.
  *
- * @param pkey      Private key.
- * @param data      Data to sign.
- * @param data_len  Data length.
+ * OpenSSL produces ECDSA signatures as DER: SEQUENCE { INTEGER r, INTEGER s }.
+ * The Xbox policy expects the fixed-width IEEE P1363 representation instead:
+ * r (32 bytes big-endian) || s (32 bytes big-endian). A P-256 signature is
+ * short enough for every DER length to use the short form.
+ *
+ * @param der       DER signature.
+ * @param der_len   Length of @p der.
  * @param out_sig64 Output signature buffer (64 bytes).
- * @return true on success, false on failure.
+ * @return true on success, false if @p der is malformed.
  */
-static bool ecdsa_sign_p1363_sha256(const EVP_PKEY *pkey, const uint8_t *data, size_t data_len, uint8_t out_sig64[64]) {
-
-    bool           ok       = false;
-    EVP_MD_CTX    *mdctx    = NULL;
-    EVP_PKEY_CTX  *pkey_ctx = NULL;
-    unsigned char *der      = NULL;
-    size_t         der_len  = 0;
-    ECDSA_SIG     *sig      = NULL;
-    const BIGNUM  *r        = NULL;
-    const BIGNUM  *s        = NULL;
-
-    if (!pkey || !data || !out_sig64)
+static bool der_to_p1363(const uint8_t *der, size_t der_len, uint8_t out_sig64[64]) {
+
+    if (der_len < 2 || der[0] != 0x30 || der[1] != der_len - 2) {
         return false;
+    }
 
-    mdctx = EVP_MD_CTX_new();
-    if (!mdctx)
-        goto done;
+    const uint8_t *p   = der + 2;
+    const uint8_t *end = der + der_len;
 
-    if (EVP_DigestSignInit(mdctx, &pkey_ctx, EVP_sha256(), NULL, (EVP_PKEY *)pkey) != 1)
-        goto done;
+    return read_der_integer(&p, end, out_sig64) && read_der_integer(&p, end, out_sig64 + 32) && p == end;
+}
 
-    if (EVP_DigestSignUpdate(mdctx, data, data_len) != 1)
-        goto done;
+/**
+ * @brief Feed a NUL-terminated field of the "to-be-signed" data to a digest.
+ */
+static bool update_field(EVP_MD_CTX *ctx, const void *data, size_t length) {
 
-    /* Get DER signature size, then signature */
-    if (EVP_DigestSignFinal(mdctx, NULL, &der_len) != 1)
-        goto done;
+    static const uint8_t delimiter = 0;
 
-    der = (unsigned char *)bzalloc(der_len);
+    return EVP_DigestSignUpdate(ctx, data, length) == 1 && EVP_DigestSignUpdate(ctx, &delimiter, 1) == 1;
+}
 
-    if (!der)
-        goto done;
+/**
+ * @brief Reusable signer bound to one private key.
+ *
+ * @c template_ctx is initialized once for ECDSA P-256 + SHA-256; each signature
+ * starts from a copy of it in @c ctx, which is allocated once as well.
+ */
+struct crypto_signer {
+    /** Signing key (one reference held by the signer) */
+    EVP_PKEY *key;
 
-    if (EVP_DigestSignFinal(mdctx, der, &der_len) != 1)
-        goto done;
+    /** Digest context initialized for signing with @c key */
+    EVP_MD_CTX *template_ctx;
 
-    const unsigned char *der_p = der;
+    /** Context the signatures are computed in */
+    EVP_MD_CTX *ctx;
+};
 
-    sig = d2i_ECDSA_SIG(NULL, &der_p, (long)der_len);
-    if (!sig)
-        goto done;
+crypto_signer_t *crypto_signer_create(const EVP_PKEY *private_key) {
 
-    ECDSA_SIG_get0(sig, &r, &s);
+    if (!private_key) {
+        return NULL;
+    }
 
-    if (!r || !s)
-        goto done;
+    crypto_signer_t *signer = bzalloc(sizeof(crypto_signer_t));
 
-    /* Convert r,s into fixed 32-byte big-endian each (P-256). */
-    memset(out_sig64, 0, 64);
-    int rlen = BN_num_bytes(r);
-    int slen = BN_num_bytes(s);
+    signer->template_ctx = EVP_MD_CTX_new();
+    signer->ctx          = EVP_MD_CTX_new();
 
-    if (rlen < 0 || rlen > 32 || slen < 0 || slen > 32)
-        goto done;
+    if (!signer->template_ctx || !signer->ctx) {
+        goto failure;
+    }
 
-    BN_bn2bin(r, out_sig64 + (32 - rlen));
-    BN_bn2bin(s, out_sig64 + 32 + (32 - slen));
+    if (EVP_PKEY_up_ref((EVP_PKEY *)private_key) != 1) {
+        goto failure;
+    }
 
-    ok = true;
+    signer->key = (EVP_PKEY *)private_key;
 
-done:
-    if (sig)
-        ECDSA_SIG_free(sig);
-    if (der)
-        bfree(der);
-    if (mdctx)
-        EVP_MD_CTX_free(mdctx);
-    return ok;
+    if (EVP_DigestSignInit(signer->template_ctx, NULL, EVP_sha256(), NULL, signer->key) != 1) {
+        goto failure;
+    }
+
+    return signer;
+
+failure:
+    obs_log(LOG_ERROR, "Unable to create the signer");
+    crypto_signer_free(&signer);
+
+    return NULL;
+}
+
+bool crypto_signer_uses_key(const crypto_signer_t *signer, const EVP_PKEY *private_key) {
+
+    return signer && signer->key == private_key;
 }
 
 /**
  * @brief Create the binary signature header required by the Xbox request policy.
  *
- * This function builds the "to-be-signed" buffer from:
+ * The "to-be-signed" data is made of:
  *  - policy version (u32, BE)
  *  - a 0 byte delimiter
  *  - timestamp (u64, BE) in Windows 100ns units
@@ -735,28 +787,24 @@ done:
  *  - authorization token + NUL
  *  - JSON payload + NUL
  *
- * It then signs the buffer using ECDSA over P-256 with SHA-256, and returns a
- * header blob:
+ * The fields are fed to the digest one by one rather than copied into a buffer,
+ * and the DER signature is converted on the stack: nothing is allocated by the
+ * signer itself.
+ *
+ * The header written to @p out_header is made of:
  *  - policy version (u32, BE)
  *  - timestamp (u64, BE)
  *  - signature (64 bytes, P1363)
- *
- * @param private_key         EC P-256 private key.
- * @param url                 Full request URL.
- * @param authorization_token Authorization token string.
- * @param payload             Request payload string.
- * @param out_len             Receives the length of the returned header.
- * @return Newly allocated header buffer (caller must bfree()), or NULL on error.
  */
-uint8_t *crypto_sign(const EVP_PKEY *private_key, const char *url, const char *authorization_token, const char *payload,
-                     size_t *out_len) {
+bool crypto_signer_sign(crypto_signer_t *signer,
+                        const char      *url,
+                        const char      *authorization_token,
+                        const char      *payload,
+                        uint8_t          out_header[CRYPTO_SIGNATURE_HEADER_SIZE]) {
 
-    if (out_len)
-        *out_len = 0;
-
-    if (!private_key || !url || !authorization_token || !payload || !out_len) {
+    if (!signer || !url || !authorization_token || !payload || !out_header) {
         obs_log(LOG_ERROR, "Unable to create signature: invalid parameters");
-        return NULL;
+        return false;
     }
 
     const uint32_t policy_version   = 1;
@@ -768,86 +816,92 @@ uint8_t *crypto_sign(const EVP_PKEY *private_key, const char *url, const char *a
 
     if (!parse_url_path_and_query(url, &path_begin, &path_len)) {
         obs_log(LOG_ERROR, "Unable to create signature: unable to retrieve the URL's path");
-        return NULL;
+        return false;
     }
 
-    const char   method[]    = "POST";
-    const size_t method_len  = 4;
-    const size_t auth_len    = strlen(authorization_token);
-    const size_t payload_len = strlen(payload);
-
-    /* Buffer: u32 + u8 + u64 + u8 + method\0 + path\0 + auth\0 + payload\0 */
-    const size_t buf_len = 4 + 1 + 8 + 1 + (method_len + 1) + (path_len + 1) + (auth_len + 1) + (payload_len + 1);
-    uint8_t     *buf     = (uint8_t *)bzalloc(buf_len);
+    /* u32 + u8 + u64 + u8 */
+    uint8_t prefix[4 + 1 + 8 + 1] = {0};
+    write_u32_be(prefix, policy_version);
+    write_u64_be(prefix + 5, windows_ts_100ns);
 
-    if (!buf) {
-        obs_log(LOG_ERROR, "Unable to create signature: unable to allocate memory for the buffer");
-        return NULL;
+    if (EVP_MD_CTX_copy_ex(signer->ctx, signer->template_ctx) != 1 ||
+        EVP_DigestSignUpdate(signer->ctx, prefix, sizeof(prefix)) != 1 || !update_field(signer->ctx, "POST", 4) ||
+        !update_field(signer->ctx, path_begin, path_len) ||
+        !update_field(signer->ctx, authorization_token, strlen(authorization_token)) ||
+        !update_field(signer->ctx, payload, strlen(payload))) {
+        obs_log(LOG_ERROR, "Unable to create signature: unable to hash the request");
+        return false;
     }
 
-    size_t off = 0;
-    write_u32_be(buf + off, policy_version);
-    off += 4;
-    buf[off++] = 0;
-    write_u64_be(buf + off, windows_ts_100ns);
-    off += 8;
-    buf[off++] = 0;
+    uint8_t der[ECDSA_P256_MAX_DER_SIZE];
+    size_t  der_len = sizeof(der);
 
-    memcpy(buf + off, method, method_len);
-    off += method_len;
-    buf[off++] = 0;
+    if (EVP_DigestSignFinal(signer->ctx, der, &der_len) != 1 ||
+        !der_to_p1363(der, der_len, out_header + CRYPTO_SIGNATURE_HEADER_SIZE - 64)) {
+        obs_log(LOG_ERROR, "Unable to create signature: the signing of the buffer failed");
+        return false;
+    }
 
-    memcpy(buf + off, path_begin, path_len);
-    off += path_len;
-    buf[off++] = 0;
+    write_u32_be(out_header, policy_version);
+    write_u64_be(out_header + 4, windows_ts_100ns);
 
-    memcpy(buf + off, authorization_token, auth_len);
-    off += auth_len;
-    buf[off++] = 0;
+    return true;
+}
 
-    memcpy(buf + off, payload, payload_len);
-    off += payload_len;
-    buf[off++] = 0;
+void crypto_signer_free(crypto_signer_t **signer) {
 
-    if (off != buf_len) {
-        obs_log(LOG_ERROR, "Unable to create signature: the size of the buffer does not match the expectation");
-        bfree(buf);
-        return NULL;
+    if (!signer || !*signer) {
+        return;
     }
 
-    /* Debug: print the buffer right before signing */
-    char *hex = bzalloc(buf_len * 2 + 1);
-    if (hex) {
-        for (size_t i = 0; i < buf_len; i++) {
-            sprintf(hex + i * 2, "%02x", buf[i]);
-        }
-        obs_log(LOG_DEBUG, "[sign] Buffer to sign (hex): %s\n", hex);
-        obs_log(LOG_DEBUG, "[sign] Buffer to sign (length): %zu\n\n", buf_len);
-        bfree(hex);
-    }
+    EVP_MD_CTX_free((*signer)->ctx);
+    EVP_MD_CTX_free((*signer)->template_ctx);
+    EVP_PKEY_free((*signer)->key);
 
-    uint8_t sig64[64];
-    if (!ecdsa_sign_p1363_sha256(private_key, buf, buf_len, sig64)) {
-        obs_log(LOG_ERROR, "Unable to create signature: the signing of the buffer failed");
-        bfree(buf);
+    bfree(*signer);
+    *signer = NULL;
+}
+
+/**
+ * @brief Create the binary signature header required by the Xbox request policy.
+ *
+ * One-shot counterpart of crypto_signer_sign(): a signer is created for the
+ * call and freed afterwards.
+ *
+ * @param private_key         EC P-256 private key.
+ * @param url                 Full request URL.
+ * @param authorization_token Authorization token string.
+ * @param payload             Request payload string.
+ * @param out_len             Receives the length of the returned header.
+ * @return Newly allocated header buffer (caller must bfree()), or NULL on error.
+ */
+uint8_t *crypto_sign(const EVP_PKEY *private_key, const char *url, const char *authorization_token, const char *payload,
+                     size_t *out_len) {
+
+    if (out_len)
+        *out_len = 0;
+
+    if (!private_key || !url || !authorization_token || !payload || !out_len) {
+        obs_log(LOG_ERROR, "Unable to create signature: invalid parameters");
         return NULL;
     }
 
-    bfree(buf);
+    crypto_signer_t *signer = crypto_signer_create(private_key);
 
-    /* Header: u32 + u64 + sig */
-    const size_t header_len = 4 + 8 + sizeof(sig64);
-    uint8_t     *header     = (uint8_t *)bzalloc(header_len);
-    if (!header) {
-        obs_log(LOG_ERROR, "Unable to create signature: unable to allocate memory for the header");
+    if (!signer) {
         return NULL;
     }
 
-    write_u32_be(header, policy_version);
-    write_u64_be(header + 4, windows_ts_100ns);
-    memcpy(header + 12, sig64, sizeof(sig64));
+    uint8_t *header = (uint8_t *)bzalloc(CRYPTO_SIGNATURE_HEADER_SIZE);
+
+    if (!crypto_signer_sign(signer, url, authorization_token, payload, header)) {
+        bfree(header);
+        header = NULL;
+    } else {
+        *out_len = CRYPTO_SIGNATURE_HEADER_SIZE;
+    }
 
-    *out_len = header_len;
+    crypto_signer_free(&signer);
 
     return header;
 }
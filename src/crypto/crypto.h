@@ -71,6 +71,63 @@ EVP_PKEY *crypto_generate_keys(void);
 uint8_t *crypto_sign(const EVP_PKEY *private_key, const char *url, const char *authorization_token, const char *payload,
                      size_t *out_len);
 
+/** Size of the signature header: policy version (u32) + timestamp (u64) + P1363 signature (64 bytes). */
+#define CRYPTO_SIGNATURE_HEADER_SIZE 76
+
+/**
+ * @brief Reusable signer bound to one private key (opaque).
+ *
+ * Creating a signer initializes the signing context once; each signature then
+ * starts from a copy of it, with no allocation made by the signer. A signer
+ * must not be used by several threads at once.
+ */
+typedef struct crypto_signer crypto_signer_t;
+
+/**
+ * @brief Create a signer for a key.
+ *
+ * The signer keeps its own reference to @p private_key, which can therefore be
+ * shared with other signers and released by the caller.
+ *
+ * @param private_key EC P-256 private key.
+ * @return Newly created signer (free with crypto_signer_free()), or NULL on failure.
+ */
+crypto_signer_t *crypto_signer_create(const EVP_PKEY *private_key);
+
+/**
+ * @brief Check whether a signer signs with a given key.
+ *
+ * @param signer      Signer (may be NULL).
+ * @param private_key Key to compare with.
+ * @return true if @p signer was created for @p private_key.
+ */
+bool crypto_signer_uses_key(const crypto_signer_t *signer, const EVP_PKEY *private_key);
+
+/**
+ * @brief Create the binary signature header required by the Xbox request policy.
+ *
+ * Same header as crypto_sign(), written into a caller-provided buffer.
+ *
+ * @param signer              Signer created with crypto_signer_create().
+ * @param url                 Full request URL.
+ * @param authorization_token Authorization token string.
+ * @param payload             Request payload string.
+ * @param out_header          Receives the header.
+ * @return true on success, false on error.
+ */
+bool crypto_signer_sign(crypto_signer_t *signer,
+                        const char      *url,
+                        const char      *authorization_token,
+                        const char      *payload,
+                        uint8_t          out_header[CRYPTO_SIGNATURE_HEADER_SIZE]);
+
+/**
+ * @brief Free a signer and set the caller's pointer to NULL.
+ *
+ * @param signer Address of the signer to free (may be NULL or point to NULL).
+ */
+void crypto_signer_free(crypto_signer_t **signer);
+
 #ifdef __cplusplus
 }
 #endif
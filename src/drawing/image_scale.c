@@ -0,0 +1,83 @@
+#include "drawing/image_scale.h"
+
+#include <util/bmem.h>
+
+#define BYTES_PER_PIXEL 4
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Range of source indices covered by a target index.
+ *
+ * The range always holds at least one source index, so upscaling repeats the
+ * nearest source pixel.
+ */
+static void source_range(uint32_t index, uint32_t size, uint32_t target_size, uint32_t *first, uint32_t *last) {
+
+    *first = (uint32_t)((uint64_t)index * size / target_size);
+    *last  = (uint32_t)((uint64_t)(index + 1) * size / target_size);
+
+    if (*last <= *first) {
+        *last = *first + 1;
+    }
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+uint8_t *scale_image(const uint8_t *pixels,
+                     uint32_t       width,
+                     uint32_t       height,
+                     uint32_t       target_width,
+                     uint32_t       target_height) {
+
+    if (!pixels || width == 0 || height == 0 || target_width == 0 || target_height == 0) {
+        return NULL;
+    }
+
+    uint8_t *target = bmalloc((size_t)target_width * target_height * BYTES_PER_PIXEL);
+
+    if (!target) {
+        return NULL;
+    }
+
+    const size_t stride = (size_t)width * BYTES_PER_PIXEL;
+    uint8_t     *output = target;
+
+    for (uint32_t y = 0; y < target_height; y++) {
+
+        uint32_t first_row, last_row;
+        source_range(y, height, target_height, &first_row, &last_row);
+
+        for (uint32_t x = 0; x < target_width; x++) {
+
+            uint32_t first_column, last_column;
+            source_range(x, width, target_width, &first_column, &last_column);
+
+            uint64_t sums[BYTES_PER_PIXEL] = {0};
+
+            for (uint32_t row = first_row; row < last_row; row++) {
+
+                const uint8_t *input = pixels + row * stride + (size_t)first_column * BYTES_PER_PIXEL;
+
+                for (uint32_t column = first_column; column < last_column; column++) {
+                    for (int channel = 0; channel < BYTES_PER_PIXEL; channel++) {
+                        sums[channel] += *input++;
+                    }
+                }
+            }
+
+            const uint64_t count = (uint64_t)(last_row - first_row) * (last_column - first_column);
+
+            for (int channel = 0; channel < BYTES_PER_PIXEL; channel++) {
+                /* Rounded to the nearest value */
+                *output++ = (uint8_t)((sums[channel] + count / 2) / count);
+            }
+        }
+    }
+
+    return target;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Resizes an image made of 4-byte pixels (RGBA, BGRA...).
+ *
+ * Each target pixel is the average of the source pixels it covers, channel by
+ * channel, so the channel order does not matter. Downscaling therefore filters
+ * out aliasing; upscaling repeats the source pixels.
+ *
+ * The function only touches memory: it can run on any thread, which keeps the
+ * resizing cost out of the render thread.
+ *
+ * @param pixels        Source pixels, row by row, without padding.
+ * @param width         Source width in pixels.
+ * @param height        Source height in pixels.
+ * @param target_width  Width of the resized image in pixels.
+ * @param target_height Height of the resized image in pixels.
+ *
+ * @return Newly allocated pixels of the resized image (caller must bfree()), or
+ *         NULL if an argument is NULL or 0, or on allocation failure.
+ */
+uint8_t *scale_image(const uint8_t *pixels,
+                     uint32_t       width,
+                     uint32_t       height,
+                     uint32_t       target_width,
+                     uint32_t       target_height);
+
+#ifdef __cplusplus
+}
+#endif
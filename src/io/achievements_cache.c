@@ -0,0 +1,425 @@
+#include "io/achievements_cache.h"
+
+#include <obs-module.h>
+#include <diagnostics/log.h>
+#include <util/platform.h>
+
+#include "common/types.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#define CACHE_DIRECTORY "achievements-cache"
+
+#define ETAG "etag"
+#define LAST_MODIFIED "last_modified"
+#define ACHIEVEMENTS "achievements"
+
+#define ACHIEVEMENT_ID "id"
+#define ACHIEVEMENT_SERVICE_CONFIG_ID "service_config_id"
+#define ACHIEVEMENT_NAME "name"
+#define ACHIEVEMENT_PROGRESS_STATE "progress_state"
+#define ACHIEVEMENT_DESCRIPTION "description"
+#define ACHIEVEMENT_LOCKED_DESCRIPTION "locked_description"
+#define ACHIEVEMENT_IS_SECRET "is_secret"
+#define ACHIEVEMENT_MEDIA_ASSETS "media_assets"
+#define ACHIEVEMENT_REWARDS "rewards"
+
+#define MEDIA_ASSET_URL "url"
+#define REWARD_VALUE "value"
+
+/**
+ * @brief Sizes of the catalog needed to hold the achievements of a cache entry.
+ */
+typedef struct catalog_size {
+    size_t achievement_count;
+    size_t media_asset_count;
+    size_t reward_count;
+    size_t text_size;
+} catalog_size_t;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Build the path of the cache entry of a game.
+ *
+ * The cache directory is created if it doesn't exist. Title ids are numeric: any
+ * other character is rejected so the id can never escape the cache directory.
+ *
+ * @return Newly allocated path string (caller must bfree()), or NULL on failure.
+ */
+static char *get_entry_path(const char *title_id) {
+
+    if (!title_id || !*title_id) {
+        return NULL;
+    }
+
+    for (const char *c = title_id; *c; c++) {
+        if (!isdigit((unsigned char)*c)) {
+            obs_log(LOG_WARNING, "Achievements cache | Ignoring invalid title id '%s'", title_id);
+            return NULL;
+        }
+    }
+
+    char *dir = obs_module_config_path(CACHE_DIRECTORY);
+
+    if (!dir) {
+        return NULL;
+    }
+
+    os_mkdirs(dir);
+
+    char *path = (char *)bzalloc(1024);
+    snprintf(path, 1024, "%s/%s.json", dir, title_id);
+    bfree(dir);
+
+    return path;
+}
+
+/**
+ * @brief Read a string member, telling an absent member apart from an empty one.
+ *
+ * @return The value owned by @p data, or NULL if the member is absent.
+ */
+static const char *get_optional_string(obs_data_t *data, const char *name) {
+    return obs_data_has_user_value(data, name) ? obs_data_get_string(data, name) : NULL;
+}
+
+static void set_optional_string(obs_data_t *data, const char *name, const char *value) {
+    if (value) {
+        obs_data_set_string(data, name, value);
+    }
+}
+
+static size_t text_size(const char *text) {
+    return text ? strlen(text) + 1 : 0;
+}
+
+/**
+ * @brief Add the sizes needed by the items of an array holding one string each.
+ */
+static void measure_string_array(obs_data_t     *entry,
+                                 const char     *array_name,
+                                 const char     *member_name,
+                                 size_t         *count,
+                                 catalog_size_t *size) {
+
+    obs_data_array_t *array = obs_data_get_array(entry, array_name);
+
+    for (size_t i = 0; i < obs_data_array_count(array); i++) {
+        obs_data_t *item = obs_data_array_item(array, i);
+        size->text_size += text_size(get_optional_string(item, member_name));
+        (*count)++;
+        obs_data_release(item);
+    }
+
+    obs_data_array_release(array);
+}
+
+static catalog_size_t measure_achievements(obs_data_array_t *achievements) {
+
+    catalog_size_t size = {0};
+
+    for (size_t i = 0; i < obs_data_array_count(achievements); i++) {
+        obs_data_t *entry = obs_data_array_item(achievements, i);
+
+        size.achievement_count++;
+        size.text_size += text_size(get_optional_string(entry, ACHIEVEMENT_ID));
+        size.text_size += text_size(get_optional_string(entry, ACHIEVEMENT_SERVICE_CONFIG_ID));
+        size.text_size += text_size(get_optional_string(entry, ACHIEVEMENT_NAME));
+        size.text_size += text_size(get_optional_string(entry, ACHIEVEMENT_PROGRESS_STATE));
+        size.text_size += text_size(get_optional_string(entry, ACHIEVEMENT_DESCRIPTION));
+        size.text_size += text_size(get_optional_string(entry, ACHIEVEMENT_LOCKED_DESCRIPTION));
+
+        measure_string_array(entry, ACHIEVEMENT_MEDIA_ASSETS, MEDIA_ASSET_URL, &size.media_asset_count, &size);
+        measure_string_array(entry, ACHIEVEMENT_REWARDS, REWARD_VALUE, &size.reward_count, &size);
+
+        obs_data_release(entry);
+    }
+
+    return size;
+}
+
+/**
+ * @brief Append one cached achievement to a catalog.
+ */
+static void read_achievement(achievement_catalog_t *catalog, obs_data_t *entry) {
+
+    achievement_t *achievement = achievement_catalog_add(catalog, get_optional_string(entry, ACHIEVEMENT_ID));
+
+    if (!achievement) {
+        return;
+    }
+
+    achievement->service_config_id =
+        achievement_catalog_store_text(catalog, get_optional_string(entry, ACHIEVEMENT_SERVICE_CONFIG_ID));
+    achievement->name = achievement_catalog_store_text(catalog, get_optional_string(entry, ACHIEVEMENT_NAME));
+    achievement->progress_state =
+        achievement_catalog_store_text(catalog, get_optional_string(entry, ACHIEVEMENT_PROGRESS_STATE));
+    achievement->description =
+        achievement_catalog_store_text(catalog, get_optional_string(entry, ACHIEVEMENT_DESCRIPTION));
+    achievement->locked_description =
+        achievement_catalog_store_text(catalog, get_optional_string(entry, ACHIEVEMENT_LOCKED_DESCRIPTION));
+    achievement->is_secret = obs_data_get_bool(entry, ACHIEVEMENT_IS_SECRET);
+
+    obs_data_array_t *media_assets = obs_data_get_array(entry, ACHIEVEMENT_MEDIA_ASSETS);
+
+    for (size_t i = 0; i < obs_data_array_count(media_assets); i++) {
+        obs_data_t *media_asset = obs_data_array_item(media_assets, i);
+        achievement_catalog_add_media_asset(catalog, achievement, get_optional_string(media_asset, MEDIA_ASSET_URL));
+        obs_data_release(media_asset);
+    }
+
+    obs_data_array_release(media_assets);
+
+    obs_data_array_t *rewards = obs_data_get_array(entry, ACHIEVEMENT_REWARDS);
+
+    for (size_t i = 0; i < obs_data_array_count(rewards); i++) {
+        obs_data_t *reward = obs_data_array_item(rewards, i);
+        achievement_catalog_add_reward(catalog, achievement, get_optional_string(reward, REWARD_VALUE));
+        obs_data_release(reward);
+    }
+
+    obs_data_array_release(rewards);
+}
+
+/**
+ * @brief Convert an achievement into a cache entry.
+ *
+ * @return New object (caller must release it).
+ */
+static obs_data_t *write_achievement(const achievement_t *achievement) {
+
+    obs_data_t *entry = obs_data_create();
+
+    set_optional_string(entry, ACHIEVEMENT_ID, achievement->id);
+    set_optional_string(entry, ACHIEVEMENT_SERVICE_CONFIG_ID, achievement->service_config_id);
+    set_optional_string(entry, ACHIEVEMENT_NAME, achievement->name);
+    set_optional_string(entry, ACHIEVEMENT_PROGRESS_STATE, achievement->progress_state);
+    set_optional_string(entry, ACHIEVEMENT_DESCRIPTION, achievement->description);
+    set_optional_string(entry, ACHIEVEMENT_LOCKED_DESCRIPTION, achievement->locked_description);
+    obs_data_set_bool(entry, ACHIEVEMENT_IS_SECRET, achievement->is_secret);
+
+    obs_data_array_t *media_assets = obs_data_array_create();
+
+    for (const media_asset_t *media_asset = achievement->media_assets; media_asset; media_asset = media_asset->next) {
+        obs_data_t *item = obs_data_create();
+        set_optional_string(item, MEDIA_ASSET_URL, media_asset->url);
+        obs_data_array_push_back(media_assets, item);
+        obs_data_release(item);
+    }
+
+    obs_data_set_array(entry, ACHIEVEMENT_MEDIA_ASSETS, media_assets);
+    obs_data_array_release(media_assets);
+
+    obs_data_array_t *rewards = obs_data_array_create();
+
+    for (const reward_t *reward = achievement->rewards; reward; reward = reward->next) {
+        obs_data_t *item = obs_data_create();
+        set_optional_string(item, REWARD_VALUE, reward->value);
+        obs_data_array_push_back(rewards, item);
+        obs_data_release(item);
+    }
+
+    obs_data_set_array(entry, ACHIEVEMENT_REWARDS, rewards);
+    obs_data_array_release(rewards);
+
+    return entry;
+}
+
+static char *copy_optional_string(const char *value) {
+    return value && *value ? bstrdup(value) : NULL;
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Load the cached achievements of a game.
+ *
+ * The entry is read twice: once to size the catalog, once to fill it, so the
+ * catalog is built with a single allocation.
+ */
+achievement_catalog_t *achievements_cache_load(const char *title_id, char **out_etag, char **out_last_modified) {
+
+    achievement_catalog_t *catalog      = NULL;
+    obs_data_t            *data         = NULL;
+    obs_data_array_t      *achievements = NULL;
+
+    if (out_etag) {
+        *out_etag = NULL;
+    }
+
+    if (out_last_modified) {
+        *out_last_modified = NULL;
+    }
+
+    char *path = get_entry_path(title_id);
+
+    if (!path) {
+        goto cleanup;
+    }
+
+    data = obs_data_create_from_json_file(path);
+
+    if (!data) {
+        /* Not cached yet */
+        goto cleanup;
+    }
+
+    achievements = obs_data_get_array(data, ACHIEVEMENTS);
+
+    if (!achievements) {
+        obs_log(LOG_WARNING, "Achievements cache | Ignoring invalid entry %s", path);
+        goto cleanup;
+    }
+
+    catalog_size_t size = measure_achievements(achievements);
+    catalog = create_achievement_catalog(size.achievement_count, size.media_asset_count, size.reward_count, size.text_size);
+
+    if (!catalog) {
+        goto cleanup;
+    }
+
+    for (size_t i = 0; i < obs_data_array_count(achievements); i++) {
+        obs_data_t *entry = obs_data_array_item(achievements, i);
+        read_achievement(catalog, entry);
+        obs_data_release(entry);
+    }
+
+    if (out_etag) {
+        *out_etag = copy_optional_string(obs_data_get_string(data, ETAG));
+    }
+
+    if (out_last_modified) {
+        *out_last_modified = copy_optional_string(obs_data_get_string(data, LAST_MODIFIED));
+    }
+
+    obs_log(LOG_DEBUG,
+            "Achievements cache | Loaded %zu achievements of game %s",
+            achievement_catalog_count(catalog),
+            title_id);
+
+cleanup:
+    obs_data_array_release(achievements);
+    obs_data_release(data);
+    bfree(path);
+
+    return catalog;
+}
+
+bool achievements_cache_contains(const char *title_id) {
+
+    char *path = get_entry_path(title_id);
+
+    if (!path) {
+        return false;
+    }
+
+    bool contained = os_file_exists(path);
+    bfree(path);
+
+    return contained;
+}
+
+/**
+ * @brief Store the achievements of a game.
+ *
+ * Written with obs_data_save_json_safe() so an interrupted write never leaves a
+ * truncated entry behind.
+ */
+bool achievements_cache_store(const char                  *title_id,
+                              const achievement_catalog_t *achievements,
+                              const char                  *etag,
+                              const char                  *last_modified) {
+
+    if (!achievements) {
+        return false;
+    }
+
+    char *path = get_entry_path(title_id);
+
+    if (!path) {
+        return false;
+    }
+
+    obs_data_t       *data    = obs_data_create();
+    obs_data_array_t *entries = obs_data_array_create();
+
+    set_optional_string(data, ETAG, etag);
+    set_optional_string(data, LAST_MODIFIED, last_modified);
+
+    for (const achievement_t *achievement = achievement_catalog_get_achievements(achievements); achievement;
+         achievement                      = achievement->next) {
+        obs_data_t *entry = write_achievement(achievement);
+        obs_data_array_push_back(entries, entry);
+        obs_data_release(entry);
+    }
+
+    obs_data_set_array(data, ACHIEVEMENTS, entries);
+
+    bool stored = obs_data_save_json_safe(data, path, ".tmp", ".bak");
+
+    if (!stored) {
+        obs_log(LOG_WARNING, "Achievements cache | Unable to write %s", path);
+    }
+
+    obs_data_array_release(entries);
+    obs_data_release(data);
+    bfree(path);
+
+    return stored;
+}
+
+/**
+ * @brief Update the progress state of one cached achievement.
+ */
+bool achievements_cache_set_progress(const char *title_id, const char *achievement_id, const char *progress_state) {
+
+    bool              updated      = false;
+    obs_data_t       *data         = NULL;
+    obs_data_array_t *achievements = NULL;
+
+    if (!achievement_id || !progress_state) {
+        return false;
+    }
+
+    char *path = get_entry_path(title_id);
+
+    if (!path) {
+        goto cleanup;
+    }
+
+    data = obs_data_create_from_json_file(path);
+
+    if (!data) {
+        goto cleanup;
+    }
+
+    achievements = obs_data_get_array(data, ACHIEVEMENTS);
+
+    for (size_t i = 0; i < obs_data_array_count(achievements) && !updated; i++) {
+        obs_data_t *entry = obs_data_array_item(achievements, i);
+
+        if (strcasecmp(obs_data_get_string(entry, ACHIEVEMENT_ID), achievement_id) == 0) {
+            obs_data_set_string(entry, ACHIEVEMENT_PROGRESS_STATE, progress_state);
+            updated = true;
+        }
+
+        obs_data_release(entry);
+    }
+
+    if (updated) {
+        obs_data_save_json_safe(data, path, ".tmp", ".bak");
+    }
+
+cleanup:
+    obs_data_array_release(achievements);
+    obs_data_release(data);
+    bfree(path);
+
+    return updated;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "common/achievement_catalog.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file achievements_cache.h
+ * @brief On-disk cache of the achievements of each game.
+ *
+ * The achievements of a game rarely change, yet retrieving them is the largest
+ * request made when switching games. The cache keeps, per title id, the last
+ * retrieved catalog together with the validators of the response it came from
+ * (ETag and Last-Modified), so a game switch can be served from disk right away
+ * and the catalog revalidated with a conditional request.
+ *
+ * The entries live next to the persisted state, one JSON file per game:
+ *   <OBS config dir>/plugins/<plugin_name>/achievements-cache/<title id>.json
+ *
+ * The functions perform disk IO: they must not be called from the lws thread
+ * or from the render thread.
+ */
+
+/**
+ * @brief Loads the cached achievements of a game.
+ *
+ * @param title_id          Title id of the game.
+ * @param out_etag          Optional output for the cached ETag (caller must bfree(), may receive NULL).
+ * @param out_last_modified Optional output for the cached Last-Modified value (caller must bfree(),
+ *                          may receive NULL).
+ *
+ * @return Newly allocated catalog, or NULL if the game is not cached. The caller
+ *         owns the catalog and must free it with @ref free_achievement_catalog.
+ */
+achievement_catalog_t *achievements_cache_load(const char *title_id, char **out_etag, char **out_last_modified);
+
+/**
+ * @brief Checks whether the achievements of a game are cached.
+ *
+ * Cheaper than @ref achievements_cache_load: the entry is not read.
+ *
+ * @param title_id Title id of the game.
+ *
+ * @return true if an entry exists for the game.
+ */
+bool achievements_cache_contains(const char *title_id);
+
+/**
+ * @brief Stores the achievements of a game, replacing any cached entry.
+ *
+ * @param title_id      Title id of the game.
+ * @param achievements  Achievements to store.
+ * @param etag          ETag of the response the achievements came from (may be NULL).
+ * @param last_modified Last-Modified value of that response (may be NULL).
+ *
+ * @return true if the entry was written.
+ */
+bool achievements_cache_store(const char                  *title_id,
+                              const achievement_catalog_t *achievements,
+                              const char                  *etag,
+                              const char                  *last_modified);
+
+/**
+ * @brief Updates the progress state of one cached achievement.
+ *
+ * Keeps the cached entry in line with the progress notifications received in
+ * real time, so it does not have to be downloaded again when an achievement is
+ * unlocked. The validators of the entry are left untouched.
+ *
+ * @param title_id       Title id of the game.
+ * @param achievement_id Id of the achievement.
+ * @param progress_state New progress state (e.g. "Achieved").
+ *
+ * @return true if the achievement was found in the cache and updated.
+ */
+bool achievements_cache_set_progress(const char *title_id, const char *achievement_id, const char *progress_state);
+
+#ifdef __cplusplus
+}
+#endif
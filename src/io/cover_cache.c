@@ -0,0 +1,386 @@
+#include "io/cover_cache.h"
+
+#include <obs-module.h>
+#include <diagnostics/log.h>
+#include <util/platform.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CACHE_DIRECTORY "covers"
+
+/** Total size of the cached images above which the least recently used ones are evicted */
+#define MAX_CACHE_SIZE (64 * 1024 * 1024)
+
+/** Length of a cache key: 64-bit hash in hexadecimal */
+#define KEY_LENGTH 16
+
+/**
+ * @brief Cached image.
+ */
+typedef struct cover_entry {
+    /** File name of the image (hash of its URL) */
+    char key[KEY_LENGTH + 1];
+
+    /** Size of the image file in bytes */
+    int64_t size;
+
+    /** Value of the use counter the last time the image was used (0: not used by this run) */
+    uint64_t last_used;
+} cover_entry_t;
+
+/**
+ * @brief In-memory index of the cached images.
+ */
+typedef struct cover_cache {
+    /** Protects every member */
+    pthread_mutex_t mutex;
+
+    /** True once the cache directory has been scanned */
+    bool loaded;
+
+    /** Absolute path of the cache directory */
+    char *directory;
+
+    cover_entry_t *entries;
+    size_t         count;
+    size_t         capacity;
+
+    /** Sum of the sizes of the cached images */
+    int64_t total_size;
+
+    /** Incremented on every use, to order the entries by recency */
+    uint64_t use_counter;
+} cover_cache_t;
+
+static cover_cache_t g_cache = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+};
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Compute the cache key of a URL (64-bit FNV-1a hash, in hexadecimal).
+ */
+static void compute_key(const char *url, char key[KEY_LENGTH + 1]) {
+
+    uint64_t hash = 14695981039346656037ull;
+
+    for (const char *c = url; *c; c++) {
+        hash ^= (uint8_t)*c;
+        hash *= 1099511628211ull;
+    }
+
+    snprintf(key, KEY_LENGTH + 1, "%016llx", (unsigned long long)hash);
+}
+
+static bool is_key(const char *name) {
+
+    if (strlen(name) != KEY_LENGTH) {
+        return false;
+    }
+
+    for (const char *c = name; *c; c++) {
+        if (!((*c >= '0' && *c <= '9') || (*c >= 'a' && *c <= 'f'))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static char *get_entry_path(const char *key) {
+
+    char *path = (char *)bzalloc(1024);
+    snprintf(path, 1024, "%s/%s", g_cache.directory, key);
+
+    return path;
+}
+
+static cover_entry_t *find_entry(const char *key) {
+
+    for (size_t i = 0; i < g_cache.count; i++) {
+        if (strcmp(g_cache.entries[i].key, key) == 0) {
+            return &g_cache.entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+static cover_entry_t *add_entry(const char *key, int64_t size) {
+
+    if (g_cache.count == g_cache.capacity) {
+        size_t         capacity = g_cache.capacity ? g_cache.capacity * 2 : 32;
+        cover_entry_t *entries  = brealloc(g_cache.entries, capacity * sizeof(cover_entry_t));
+
+        if (!entries) {
+            return NULL;
+        }
+
+        g_cache.entries  = entries;
+        g_cache.capacity = capacity;
+    }
+
+    cover_entry_t *entry = &g_cache.entries[g_cache.count++];
+
+    snprintf(entry->key, sizeof(entry->key), "%s", key);
+    entry->size      = size;
+    entry->last_used = 0;
+
+    g_cache.total_size += size;
+
+    return entry;
+}
+
+static void remove_entry(cover_entry_t *entry) {
+
+    char *path = get_entry_path(entry->key);
+    os_unlink(path);
+    bfree(path);
+
+    g_cache.total_size -= entry->size;
+
+    /* The order of the entries does not matter: move the last one into the hole */
+    *entry = g_cache.entries[--g_cache.count];
+}
+
+/**
+ * @brief Build the index from the images found in the cache directory.
+ *
+ * Must be called with the mutex held.
+ */
+static bool load_index(void) {
+
+    if (g_cache.loaded) {
+        return true;
+    }
+
+    g_cache.directory = obs_module_config_path(CACHE_DIRECTORY);
+
+    if (!g_cache.directory) {
+        return false;
+    }
+
+    os_mkdirs(g_cache.directory);
+
+    os_dir_t *dir = os_opendir(g_cache.directory);
+
+    if (dir) {
+        struct os_dirent *dirent;
+
+        while ((dirent = os_readdir(dir)) != NULL) {
+
+            if (dirent->directory || !is_key(dirent->d_name)) {
+                continue;
+            }
+
+            char   *path = get_entry_path(dirent->d_name);
+            int64_t size = os_get_file_size(path);
+            bfree(path);
+
+            if (size > 0) {
+                add_entry(dirent->d_name, size);
+            }
+        }
+
+        os_closedir(dir);
+    }
+
+    g_cache.loaded = true;
+
+    obs_log(LOG_DEBUG,
+            "Cover cache | %zu images found (%lld bytes)",
+            g_cache.count,
+            (long long)g_cache.total_size);
+
+    return true;
+}
+
+/**
+ * @brief Delete the least recently used images until the cache fits its cap.
+ *
+ * @p kept is never evicted, even if it alone exceeds the cap. Must be called with
+ * the mutex held.
+ */
+static void evict(const char *kept) {
+
+    while (g_cache.total_size > MAX_CACHE_SIZE) {
+
+        cover_entry_t *oldest = NULL;
+
+        for (size_t i = 0; i < g_cache.count; i++) {
+            cover_entry_t *entry = &g_cache.entries[i];
+
+            if (strcmp(entry->key, kept) != 0 && (!oldest || entry->last_used < oldest->last_used)) {
+                oldest = entry;
+            }
+        }
+
+        if (!oldest) {
+            return;
+        }
+
+        obs_log(LOG_DEBUG, "Cover cache | Evicting %s", oldest->key);
+        remove_entry(oldest);
+    }
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+char *cover_cache_get_path(const char *url) {
+
+    char *path = NULL;
+
+    if (!url || !*url) {
+        return NULL;
+    }
+
+    char key[KEY_LENGTH + 1];
+    compute_key(url, key);
+
+    pthread_mutex_lock(&g_cache.mutex);
+
+    if (!load_index()) {
+        goto cleanup;
+    }
+
+    cover_entry_t *entry = find_entry(key);
+
+    if (!entry) {
+        goto cleanup;
+    }
+
+    path = get_entry_path(key);
+
+    if (!os_file_exists(path)) {
+        /* Deleted behind our back */
+        remove_entry(entry);
+        bfree(path);
+        path = NULL;
+        goto cleanup;
+    }
+
+    entry->last_used = ++g_cache.use_counter;
+
+cleanup:
+    pthread_mutex_unlock(&g_cache.mutex);
+
+    return path;
+}
+
+bool cover_cache_contains(const char *url) {
+
+    bool contained = false;
+
+    if (!url || !*url) {
+        return false;
+    }
+
+    char key[KEY_LENGTH + 1];
+    compute_key(url, key);
+
+    pthread_mutex_lock(&g_cache.mutex);
+
+    contained = load_index() && find_entry(key) != NULL;
+
+    pthread_mutex_unlock(&g_cache.mutex);
+
+    return contained;
+}
+
+/**
+ * @brief Store an image in the cache.
+ *
+ * The image is written to a temporary file first and then renamed, so a reader
+ * never sees a partially written image.
+ */
+char *cover_cache_store(const char *url, const uint8_t *data, size_t size) {
+
+    char *path      = NULL;
+    char *temp_path = NULL;
+    FILE *file      = NULL;
+
+    if (!url || !*url || !data || size == 0) {
+        return NULL;
+    }
+
+    char key[KEY_LENGTH + 1];
+    compute_key(url, key);
+
+    pthread_mutex_lock(&g_cache.mutex);
+
+    if (!load_index()) {
+        goto cleanup;
+    }
+
+    path      = get_entry_path(key);
+    temp_path = bzalloc(1024);
+    snprintf(temp_path, 1024, "%s.tmp", path);
+
+    file = os_fopen(temp_path, "wb");
+
+    if (!file) {
+        obs_log(LOG_WARNING, "Cover cache | Unable to create %s", temp_path);
+        goto failure;
+    }
+
+    bool written = fwrite(data, 1, size, file) == size;
+    written      = fclose(file) == 0 && written;
+
+    if (!written || os_rename(temp_path, path) != 0) {
+        obs_log(LOG_WARNING, "Cover cache | Unable to write %s", path);
+        os_unlink(temp_path);
+        goto failure;
+    }
+
+    cover_entry_t *entry = find_entry(key);
+
+    if (entry) {
+        g_cache.total_size += (int64_t)size - entry->size;
+        entry->size = (int64_t)size;
+    } else {
+        entry = add_entry(key, (int64_t)size);
+    }
+
+    if (entry) {
+        entry->last_used = ++g_cache.use_counter;
+    }
+
+    evict(key);
+
+    goto cleanup;
+
+failure:
+    bfree(path);
+    path = NULL;
+
+cleanup:
+    pthread_mutex_unlock(&g_cache.mutex);
+    bfree(temp_path);
+
+    return path;
+}
+
+void cover_cache_cleanup(void) {
+
+    pthread_mutex_lock(&g_cache.mutex);
+
+    bfree(g_cache.entries);
+    bfree(g_cache.directory);
+
+    g_cache.entries     = NULL;
+    g_cache.directory   = NULL;
+    g_cache.count       = 0;
+    g_cache.capacity    = 0;
+    g_cache.total_size  = 0;
+    g_cache.use_counter = 0;
+    g_cache.loaded      = false;
+
+    pthread_mutex_unlock(&g_cache.mutex);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file cover_cache.h
+ * @brief On-disk, size-capped cache of downloaded cover art.
+ *
+ * Cover art URLs are immutable: the same URL always serves the same image. The
+ * cache therefore keys each image by a hash of its URL and never revalidates it,
+ * so a game played again is shown without any network request.
+ *
+ * The images live next to the persisted state:
+ *   <OBS config dir>/plugins/<plugin_name>/covers/<url hash>
+ *
+ * When the total size of the images exceeds the cap, the least recently used
+ * ones are deleted. Recency is tracked in memory: images left by a previous run
+ * are evicted before any image used during the current one.
+ *
+ * The functions are thread-safe but perform disk IO: they must not be called
+ * from the render thread.
+ */
+
+/**
+ * @brief Looks up the cached image of a URL.
+ *
+ * A hit marks the image as the most recently used.
+ *
+ * @param url URL the image was downloaded from.
+ *
+ * @return Path of the cached image (caller must bfree()), or NULL if the image
+ *         is not cached.
+ */
+char *cover_cache_get_path(const char *url);
+
+/**
+ * @brief Checks whether the image of a URL is cached.
+ *
+ * Unlike @ref cover_cache_get_path, the recency of the image is left untouched.
+ *
+ * @param url URL the image was downloaded from.
+ *
+ * @return true if the image is cached.
+ */
+bool cover_cache_contains(const char *url);
+
+/**
+ * @brief Stores the image downloaded from a URL.
+ *
+ * Evicts the least recently used images if the cache grows beyond its cap.
+ *
+ * @param url  URL the image was downloaded from.
+ * @param data Image bytes (encoded, as downloaded).
+ * @param size Number of bytes in @p data.
+ *
+ * @return Path of the cached image (caller must bfree()), or NULL if it could
+ *         not be written.
+ */
+char *cover_cache_store(const char *url, const uint8_t *data, size_t size);
+
+/**
+ * @brief Releases the in-memory index of the cache.
+ *
+ * The cached images are kept on disk. Typically called when the module is unloaded.
+ */
+void cover_cache_cleanup(void);
+
+#ifdef __cplusplus
+}
+#endif
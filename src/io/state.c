@@ -4,12 +4,18 @@
 #include <diagnostics/log.h>
 #include <util/config-file.h>
 #include <util/platform.h>
+#include <util/threading.h>
+
+#include <pthread.h>
 
 #include "crypto/crypto.h"
 #include "util/uuid.h"
 
 #define PERSIST_FILE "achievements-tracker-state.json"
 
+/** Changes made within this window after the first one are written together */
+#define FLUSH_DELAY_MS 500
+
 #define USER_ACCESS_TOKEN "user_access_token"
 #define USER_ACCESS_TOKEN_EXPIRY "user_access_token_expiry"
 #define USER_REFRESH_TOKEN "user_refresh_token"
@@ -27,17 +33,66 @@
 #define XBOX_TOKEN "xbox_token"
 #define XBOX_TOKEN_EXPIRY "xbox_token_expiry"
 
+#define PREFETCH_RECENT_GAMES "prefetch_recent_games"
+
 /**
  * @brief Global in-memory persisted state.
  *
  * The state is backed by an OBS obs_data_t object loaded from and saved to
- * JSON on disk. Most getters return pointers to strings owned by this object.
+ * JSON on disk. Getters return copies: the strings of this object are
+ * reallocated whenever they change.
  *
  * @note This must be initialized by calling io_load() before any state_* APIs
  *       are used.
  */
 static obs_data_t *g_state = NULL;
 
+/**
+ * @brief Write-behind persistence of @c g_state.
+ *
+ * Setters only update @c g_state and mark it dirty; the flusher thread writes
+ * it to disk once the changes settle, so a burst of changes (e.g. the tokens
+ * of an authentication flow) costs a single write and never blocks the caller
+ * on disk IO.
+ */
+typedef struct state_flusher {
+    /** Protects @c g_state and @c dirty: taken to read the state as well as to change it */
+    pthread_mutex_t mutex;
+
+    /** True when @c g_state has changes that are not on disk yet */
+    bool dirty;
+
+    /** Signaled when @c g_state becomes dirty */
+    os_event_t *changed;
+
+    /** Signaled when the flusher must stop */
+    os_event_t *stopping;
+
+    /** Thread writing the state to disk */
+    pthread_t thread;
+
+    /** True while @c thread is running */
+    bool running;
+} state_flusher_t;
+
+static state_flusher_t g_flusher = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+};
+
+/** Incremented every time the Xbox identity is set or cleared */
+static volatile long g_identity_version = 0;
+
+/**
+ * @brief Device key pair imported from @c DEVICE_KEYS.
+ *
+ * Importing the serialized keys is costly (JSON parsing, base64url decoding and
+ * key construction), so they are imported once and the key pair is shared by
+ * every device_t returned by state_get_device(). It is only replaced when
+ * create_device_keys() generates a new pair.
+ */
+static EVP_PKEY       *g_device_keys       = NULL;
+static pthread_mutex_t g_device_keys_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 /**
  * @brief Build the full path to the persisted JSON state file.
  *
@@ -97,27 +152,140 @@ static obs_data_t *load_state(void) {
 }
 
 /**
- * @brief Persist the current state to disk.
+ * @brief Persist the current state to disk if it has unsaved changes.
  *
- * Uses obs_data_save_json_safe() to write the JSON file with a temporary file and
- * backup.
- *
- * @param data State object to save. No-op if NULL.
+ * The state is serialized with the mutex held, then written without it so the
+ * setters never wait for the disk. The file is written with a temporary file
+ * and a backup, like obs_data_save_json_safe() does.
  */
-static void save_state(obs_data_t *data) {
+static void flush_state(void) {
 
-    if (!data) {
+    pthread_mutex_lock(&g_flusher.mutex);
+
+    if (!g_flusher.dirty || !g_state) {
+        pthread_mutex_unlock(&g_flusher.mutex);
         return;
     }
 
+    const char *json = obs_data_get_json(g_state);
+    char       *copy = json ? bstrdup(json) : NULL;
+
+    g_flusher.dirty = false;
+
+    pthread_mutex_unlock(&g_flusher.mutex);
+
     char *path = get_state_path();
 
-    if (!path) {
-        return;
+    if (copy && path && !os_quick_write_utf8_file_safe(path, copy, strlen(copy), false, "tmp", "bak")) {
+        obs_log(LOG_WARNING, "unable to save the state to %s", path);
     }
 
-    obs_data_save_json_safe(data, path, ".tmp", ".bak");
     bfree(path);
+    bfree(copy);
+}
+
+/**
+ * @brief Flusher thread entry point.
+ *
+ * Waits for a change, lets the following ones accumulate for FLUSH_DELAY_MS,
+ * then writes them all at once. Returns once asked to stop.
+ */
+static void *flusher_thread(void *arg) {
+    UNUSED_PARAMETER(arg);
+
+    for (;;) {
+
+        os_event_wait(g_flusher.changed);
+
+        /* Interrupted by a stop request: the remaining changes are flushed by io_unload() */
+        if (os_event_timedwait(g_flusher.stopping, FLUSH_DELAY_MS) == 0) {
+            break;
+        }
+
+        flush_state();
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Start the flusher thread.
+ *
+ * If it cannot be started, every change is written right away instead.
+ */
+static void start_flusher(void) {
+
+    if (os_event_init(&g_flusher.changed, OS_EVENT_TYPE_AUTO) != 0 ||
+        os_event_init(&g_flusher.stopping, OS_EVENT_TYPE_MANUAL) != 0) {
+        goto failure;
+    }
+
+    if (pthread_create(&g_flusher.thread, NULL, flusher_thread, NULL) != 0) {
+        goto failure;
+    }
+
+    g_flusher.running = true;
+    return;
+
+failure:
+    obs_log(LOG_WARNING, "unable to start the state flusher: the state will be saved synchronously");
+
+    os_event_destroy(g_flusher.changed);
+    os_event_destroy(g_flusher.stopping);
+    g_flusher.changed  = NULL;
+    g_flusher.stopping = NULL;
+}
+
+/**
+ * @brief Lock the state before changing it.
+ */
+static void begin_change(void) {
+    pthread_mutex_lock(&g_flusher.mutex);
+}
+
+/**
+ * @brief Unlock the state and schedule the changes to be written.
+ */
+static void end_change(void) {
+
+    g_flusher.dirty = true;
+
+    pthread_mutex_unlock(&g_flusher.mutex);
+
+    if (g_flusher.running) {
+        os_event_signal(g_flusher.changed);
+    } else {
+        flush_state();
+    }
+}
+
+/**
+ * @brief Lock the state before reading it.
+ */
+static void begin_read(void) {
+    pthread_mutex_lock(&g_flusher.mutex);
+}
+
+/**
+ * @brief Unlock the state once read.
+ */
+static void end_read(void) {
+    pthread_mutex_unlock(&g_flusher.mutex);
+}
+
+/**
+ * @brief Copy a string of the state.
+ *
+ * Must be called between begin_read() and end_read().
+ *
+ * @param name Name of the string.
+ * @return A copy owned by the caller, or NULL if the string is missing or empty.
+ */
+static char *copy_string(const char *name) {
+
+    const char *value = obs_data_get_string(g_state, name);
+
+    return value && strlen(value) > 0 ? bstrdup(value) : NULL;
 }
 
 /**
@@ -130,6 +298,8 @@ static void save_state(obs_data_t *data) {
 void io_load(void) {
     g_state = load_state();
 
+    start_flusher();
+
     /* Read values */
     const char *token     = obs_data_get_string(g_state, "oauth_token");
     int64_t     last_sync = obs_data_get_int(g_state, "last_sync_unix");
@@ -138,6 +308,35 @@ void io_load(void) {
     (void)last_sync;
 }
 
+/**
+ * @brief Write the pending changes and stop the state subsystem.
+ *
+ * Stops the flusher thread, then writes any change it has not written yet.
+ *
+ * @note Call once during plugin shutdown, after the last state_set_* call.
+ */
+void io_unload(void) {
+
+    if (g_flusher.running) {
+        os_event_signal(g_flusher.stopping);
+        os_event_signal(g_flusher.changed);
+        pthread_join(g_flusher.thread, NULL);
+
+        os_event_destroy(g_flusher.changed);
+        os_event_destroy(g_flusher.stopping);
+        g_flusher.changed  = NULL;
+        g_flusher.stopping = NULL;
+        g_flusher.running  = false;
+    }
+
+    flush_state();
+
+    pthread_mutex_lock(&g_device_keys_mutex);
+    EVP_PKEY_free(g_device_keys);
+    g_device_keys = NULL;
+    pthread_mutex_unlock(&g_device_keys_mutex);
+}
+
 /**
  * @brief Clear volatile/authentication state.
  *
@@ -151,6 +350,7 @@ void state_clear(void) {
     /*obs_data_set_string(g_state, DEVICE_SERIAL_NUMBER, "");*/
     /*obs_data_set_string(g_state, DEVICE_KEYS, "");*/
 
+    begin_change();
     obs_data_set_string(g_state, USER_ACCESS_TOKEN, "");
     obs_data_set_int(g_state, USER_ACCESS_TOKEN_EXPIRY, 0);
     obs_data_set_string(g_state, USER_REFRESH_TOKEN, "");
@@ -160,65 +360,91 @@ void state_clear(void) {
     obs_data_set_string(g_state, XBOX_IDENTITY_ID, "");
     obs_data_set_string(g_state, XBOX_TOKEN, "");
     obs_data_set_string(g_state, XBOX_TOKEN_EXPIRY, "");
-    save_state(g_state);
+    end_change();
+
+    os_atomic_inc_long(&g_identity_version);
 }
 
 /**
  * @brief Generate and persist a new device UUID.
  *
- * @return Pointer to the stored UUID string owned by the internal state object.
+ * @return Copy of the new UUID, owned by the caller.
  */
-static const char *create_device_uuid() {
+static char *create_device_uuid() {
     /* Generate a random device UUID */
     char new_device_uuid[37];
     uuid_get_random(new_device_uuid);
 
+    begin_change();
     obs_data_set_string(g_state, DEVICE_UUID, new_device_uuid);
-    save_state(g_state);
+    end_change();
 
-    /* Retrieves it from the state */
-    return obs_data_get_string(g_state, DEVICE_UUID);
+    return bstrdup(new_device_uuid);
 }
 
 /**
  * @brief Generate and persist a new device serial number.
  *
- * @return Pointer to the stored serial number string owned by the internal state object.
+ * @return Copy of the new serial number, owned by the caller.
  */
-static const char *create_device_serial_number() {
+static char *create_device_serial_number() {
     /* Generate a random device UUID */
     char new_device_serial_number[37];
     uuid_get_random(new_device_serial_number);
 
+    begin_change();
     obs_data_set_string(g_state, DEVICE_SERIAL_NUMBER, new_device_serial_number);
-    save_state(g_state);
+    end_change();
 
-    /* Retrieves it from the state */
-    return obs_data_get_string(g_state, DEVICE_SERIAL_NUMBER);
+    return bstrdup(new_device_serial_number);
 }
 
 /**
  * @brief Generate and persist a new EC keypair for the emulated device.
  *
  * Generates a P-256 keypair, serializes it to JSON (including the private part)
- * and stores it in the state.
+ * and stores it in the state. The new pair replaces the cached one.
+ *
+ * Must be called with @c g_device_keys_mutex held.
  *
- * @return Pointer to the stored serialized key string owned by the internal state object.
+ * @return The new key pair, owned by the cache.
  */
-static const char *create_device_keys() {
+static EVP_PKEY *create_device_keys() {
     /* Generate a random key pair */
     EVP_PKEY *device_key = crypto_generate_keys();
 
+    if (!device_key) {
+        return NULL;
+    }
+
     char *serialized_keys = crypto_to_string(device_key, true);
 
+    begin_change();
     obs_data_set_string(g_state, DEVICE_KEYS, serialized_keys);
-    save_state(g_state);
+    end_change();
 
     bfree(serialized_keys);
-    EVP_PKEY_free(device_key);
 
-    /* Retrieves it from the state */
-    return obs_data_get_string(g_state, DEVICE_KEYS);
+    EVP_PKEY_free(g_device_keys);
+    g_device_keys = device_key;
+
+    return g_device_keys;
+}
+
+/**
+ * @brief Get the cached device key pair, importing it from the state first if needed.
+ *
+ * Must be called with @c g_device_keys_mutex held.
+ *
+ * @return The key pair owned by the cache, or NULL if the stored keys cannot be imported.
+ */
+static EVP_PKEY *get_device_keys(const char *serialized_keys) {
+
+    if (!g_device_keys) {
+        g_device_keys = crypto_from_string(serialized_keys, true);
+    }
+
+    return g_device_keys;
 }
 
 /**
@@ -229,43 +455,54 @@ static const char *create_device_keys() {
  *
  * Ownership/lifetime:
  *  - The returned device_t is allocated with bzalloc() and must be freed by the
- *    caller.
- *  - device->uuid and device->serial_number point to strings owned by the
- *    internal obs_data_t state; they must not be freed and remain valid while
- *    g_state remains loaded.
- *  - device->keys is a newly created EVP_PKEY that must be freed by the caller
- *    with EVP_PKEY_free().
+ *    caller with free_device().
+ *  - device->uuid and device->serial_number are copies owned by the device.
+ *  - device->keys points to the cached key pair shared by every device_t; it
+ *    must not be freed and remains valid until io_unload().
  *
  * @return Newly allocated device_t on success, or NULL on failure.
  */
 device_t *state_get_device(void) {
 
-    /* Retrieves the device UUID & serial number */
-    const char *device_uuid          = obs_data_get_string(g_state, DEVICE_UUID);
-    const char *device_serial_number = obs_data_get_string(g_state, DEVICE_SERIAL_NUMBER);
+    /* Held across the read and the creation so that a single device is ever created */
+    pthread_mutex_lock(&g_device_keys_mutex);
 
-    /* Retrieves the device's public & private keys */
-    const char *device_keys = obs_data_get_string(g_state, DEVICE_KEYS);
+    /* Retrieves the device UUID, serial number and public & private keys */
+    begin_read();
+    char *device_uuid          = copy_string(DEVICE_UUID);
+    char *device_serial_number = copy_string(DEVICE_SERIAL_NUMBER);
+    char *device_keys          = copy_string(DEVICE_KEYS);
+    end_read();
 
-    if (!device_uuid || strlen(device_uuid) == 0) {
+    EVP_PKEY *device_evp_pkeys = NULL;
+
+    if (!device_uuid) {
         obs_log(LOG_INFO, "No device UUID found. Creating new one");
+        free_memory((void **)&device_serial_number);
+
         device_uuid          = create_device_uuid();
         device_serial_number = create_device_serial_number();
 
         /* Forces the keys to be recreated if the device UUID is new */
-        device_keys = NULL;
+        free_memory((void **)&device_keys);
     }
 
-    if (!device_keys || strlen(device_keys) == 0) {
+    if (!device_keys) {
         obs_log(LOG_INFO, "No device keys found. Creating new one pair");
-        device_keys = create_device_keys();
+        device_evp_pkeys = create_device_keys();
+    } else {
+        /* Retrieves the keys from the serialized string, once */
+        device_evp_pkeys = get_device_keys(device_keys);
     }
 
-    /* Retrieves the keys from the serialized string */
-    EVP_PKEY *device_evp_pkeys = crypto_from_string(device_keys, true);
+    pthread_mutex_unlock(&g_device_keys_mutex);
+
+    free_memory((void **)&device_keys);
 
     if (!device_evp_pkeys) {
         obs_log(LOG_ERROR, "Could not load device keys from state");
+        free_memory((void **)&device_uuid);
+        free_memory((void **)&device_serial_number);
         return NULL;
     }
 
@@ -283,24 +520,27 @@ device_t *state_get_device(void) {
  * @param device_token Token to store. The value is persisted.
  */
 void state_set_device_token(const token_t *device_token) {
+    begin_change();
     obs_data_set_string(g_state, DEVICE_TOKEN, device_token->value);
-    save_state(g_state);
+    end_change();
 }
 
 /**
  * @brief Retrieve the device token from the state.
  *
  * Ownership/lifetime:
- *  - Returns a token_t allocated with bzalloc() that the caller must free.
- *  - token->value points to a string owned by the internal state object.
+ *  - Returns a token_t allocated with bzalloc() that the caller must free with
+ *    free_token(), value included.
  *
  * @return Token wrapper, or NULL if missing/expired.
  */
 token_t *state_get_device_token(void) {
 
-    const char *device_token = obs_data_get_string(g_state, DEVICE_TOKEN);
+    begin_read();
+    char *device_token = copy_string(DEVICE_TOKEN);
+    end_read();
 
-    if (!device_token || strlen(device_token) == 0) {
+    if (!device_token) {
         obs_log(LOG_INFO, "No device token found in the cache");
         return NULL;
     }
@@ -317,20 +557,23 @@ token_t *state_get_device_token(void) {
  * @param sisu_token Token to store. The value is persisted.
  */
 void state_set_sisu_token(const token_t *sisu_token) {
+    begin_change();
     obs_data_set_string(g_state, SISU_TOKEN, sisu_token->value);
-    save_state(g_state);
+    end_change();
 }
 
 /**
  * @brief Retrieve the SISU token from the state.
  *
- * @return Token wrapper allocated with bzalloc(), or NULL if missing/expired.
+ * @return Token owned by the caller (free with free_token()), or NULL if missing/expired.
  */
 token_t *state_get_sisu_token(void) {
 
-    const char *sisu_token = obs_data_get_string(g_state, SISU_TOKEN);
+    begin_read();
+    char *sisu_token = copy_string(SISU_TOKEN);
+    end_read();
 
-    if (!sisu_token || strlen(sisu_token) == 0) {
+    if (!sisu_token) {
         obs_log(LOG_INFO, "No sisu token found in the cache");
         return NULL;
     }
@@ -348,22 +591,25 @@ token_t *state_get_sisu_token(void) {
  * @param refresh_token Refresh token.
  */
 void state_set_user_token(const token_t *user_token, const token_t *refresh_token) {
+    begin_change();
     obs_data_set_string(g_state, USER_ACCESS_TOKEN, user_token->value);
     obs_data_set_int(g_state, USER_ACCESS_TOKEN_EXPIRY, user_token->expires);
     obs_data_set_string(g_state, USER_REFRESH_TOKEN, refresh_token->value);
-    save_state(g_state);
+    end_change();
 }
 
 /**
  * @brief Retrieve the user access token from the state.
  *
- * @return Token wrapper allocated with bzalloc(), or NULL if missing/expired.
+ * @return Token owned by the caller (free with free_token()), or NULL if missing/expired.
  */
 token_t *state_get_user_token(void) {
 
-    const char *user_token = obs_data_get_string(g_state, USER_ACCESS_TOKEN);
+    begin_read();
+    char *user_token = copy_string(USER_ACCESS_TOKEN);
+    end_read();
 
-    if (!user_token || strlen(user_token) == 0) {
+    if (!user_token) {
         obs_log(LOG_INFO, "No user token found in the cache");
         return NULL;
     }
@@ -377,12 +623,15 @@ token_t *state_get_user_token(void) {
 /**
  * @brief Retrieve the user refresh token from the state.
  *
- * @return Token wrapper allocated with bzalloc(), or NULL if missing.
+ * @return Token owned by the caller (free with free_token()), or NULL if missing.
  */
 token_t *state_get_user_refresh_token(void) {
-    const char *refresh_token = obs_data_get_string(g_state, USER_REFRESH_TOKEN);
 
-    if (!refresh_token || strlen(refresh_token) == 0) {
+    begin_read();
+    char *refresh_token = copy_string(USER_REFRESH_TOKEN);
+    end_read();
+
+    if (!refresh_token) {
         obs_log(LOG_INFO, "No refresh token found in the cache");
         return NULL;
     }
@@ -401,60 +650,64 @@ token_t *state_get_user_refresh_token(void) {
  * @param xbox_identity Identity object containing user details and token.
  */
 void state_set_xbox_identity(const xbox_identity_t *xbox_identity) {
+    begin_change();
     obs_data_set_string(g_state, XBOX_IDENTITY_GTG, xbox_identity->gamertag);
     obs_data_set_string(g_state, XBOX_IDENTITY_ID, xbox_identity->xid);
     obs_data_set_string(g_state, XBOX_IDENTITY_UHS, xbox_identity->uhs);
     obs_data_set_string(g_state, XBOX_TOKEN, xbox_identity->token->value);
     obs_data_set_int(g_state, XBOX_TOKEN_EXPIRY, xbox_identity->token->expires);
-    save_state(g_state);
+    end_change();
+
+    os_atomic_inc_long(&g_identity_version);
 }
 
 /**
  * @brief Retrieve the Xbox identity from the state.
  *
+ * All the fields are read at once, so the identity is never a mix of an old
+ * and a new one.
+ *
  * Ownership/lifetime:
  *  - Returns an xbox_identity_t allocated with bzalloc() which the caller must
- *    free, plus a nested token_t allocated with bzalloc().
- *  - identity->gamertag/xid/uhs and token->value point to strings owned by the
- *    internal state object.
+ *    free with free_identity(); its strings and token are copies it owns.
  *
  * @return Identity object on success, or NULL if missing fields.
  */
 xbox_identity_t *state_get_xbox_identity(void) {
 
-    const char *gtg = obs_data_get_string(g_state, XBOX_IDENTITY_GTG);
+    xbox_identity_t *identity = NULL;
 
-    if (!gtg || strlen(gtg) == 0) {
+    begin_read();
+    char   *gtg               = copy_string(XBOX_IDENTITY_GTG);
+    char   *xid               = copy_string(XBOX_IDENTITY_ID);
+    char   *uhs               = copy_string(XBOX_IDENTITY_UHS);
+    char   *xbox_token        = copy_string(XBOX_TOKEN);
+    int64_t xbox_token_expiry = (int64_t)obs_data_get_int(g_state, XBOX_TOKEN_EXPIRY);
+    end_read();
+
+    if (!gtg) {
         obs_log(LOG_INFO, "No gamertag found in the cache");
-        return NULL;
+        goto cleanup;
     }
 
-    const char *xid = obs_data_get_string(g_state, XBOX_IDENTITY_ID);
-
-    if (!xid || strlen(xid) == 0) {
+    if (!xid) {
         obs_log(LOG_INFO, "No user ID found in the cache");
-        return NULL;
+        goto cleanup;
     }
 
-    const char *uhs = obs_data_get_string(g_state, XBOX_IDENTITY_UHS);
-
-    if (!uhs || strlen(uhs) == 0) {
+    if (!uhs) {
         obs_log(LOG_INFO, "No user hash found in the cache");
-        return NULL;
+        goto cleanup;
     }
 
-    const char *xbox_token = obs_data_get_string(g_state, XBOX_TOKEN);
-
-    if (!xbox_token || strlen(xbox_token) == 0) {
+    if (!xbox_token) {
         obs_log(LOG_INFO, "No xbox token found in the cache");
-        return NULL;
+        goto cleanup;
     }
 
-    int64_t xbox_token_expiry = (int64_t)obs_data_get_int(g_state, XBOX_TOKEN_EXPIRY);
-
     if (xbox_token_expiry == 0) {
         obs_log(LOG_INFO, "No xbox token expiry found in the cache");
-        return NULL;
+        goto cleanup;
     }
 
     obs_log(LOG_DEBUG, "Xbox identity found in the cache: %s (%s)", gtg, xid);
@@ -463,11 +716,49 @@ xbox_identity_t *state_get_xbox_identity(void) {
     token->value   = xbox_token;
     token->expires = xbox_token_expiry;
 
-    xbox_identity_t *identity = bzalloc(sizeof(xbox_identity_t));
-    identity->gamertag        = gtg;
-    identity->xid             = xid;
-    identity->uhs             = uhs;
-    identity->token           = token;
+    identity           = bzalloc(sizeof(xbox_identity_t));
+    identity->gamertag = gtg;
+    identity->xid      = xid;
+    identity->uhs      = uhs;
+    identity->token    = token;
+
+    return identity;
+
+cleanup:
+    free_memory((void **)&gtg);
+    free_memory((void **)&xid);
+    free_memory((void **)&uhs);
+    free_memory((void **)&xbox_token);
 
     return identity;
 }
+
+long state_get_xbox_identity_version(void) {
+
+    return os_atomic_load_long(&g_identity_version);
+}
+
+/**
+ * @brief Store whether the recently played games are prefetched.
+ *
+ * This is a preference rather than a credential: state_clear() keeps it.
+ */
+void state_set_prefetch_enabled(bool enabled) {
+    begin_change();
+    obs_data_set_bool(g_state, PREFETCH_RECENT_GAMES, enabled);
+    end_change();
+}
+
+/**
+ * @brief Retrieve whether the recently played games are prefetched.
+ *
+ * @return The stored preference, false if it was never set.
+ */
+bool state_get_prefetch_enabled(void) {
+
+    begin_read();
+    bool enabled = obs_data_get_bool(g_state, PREFETCH_RECENT_GAMES);
+    end_read();
+
+    return enabled;
+}
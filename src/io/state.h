@@ -17,11 +17,25 @@ extern "C" {
  */
 void io_load(void);
 
+/**
+ * @brief Write any pending state change to disk and stop the state subsystem.
+ *
+ * State changes are written in the background, shortly after they are made.
+ * This function waits for the background writer to stop and writes whatever
+ * it had not written yet.
+ *
+ * This function is expected to be called during plugin shutdown.
+ */
+void io_unload(void);
+
 /**
  * @brief Get the current device information associated with the state.
  *
- * @return Pointer to the in-memory device object, or NULL if no device is
- *         available/loaded.
+ * The device key pair is imported from the state once and then shared, read
+ * only, by every returned device: @c keys must not be freed by the caller.
+ *
+ * @return Copy of the device, owned by the caller and freed with free_device(),
+ *         or NULL if no device is available/loaded.
  */
 device_t *state_get_device(void);
 
@@ -39,14 +53,16 @@ void state_set_user_token(const token_t *user_token, const token_t *refresh_toke
 /**
  * @brief Get the current user's access token.
  *
- * @return Pointer to the stored token, or NULL if none is set.
+ * @return Copy of the stored token, or NULL if none is set.
+ *         The caller owns it and frees it with free_token().
  */
 token_t *state_get_user_token(void);
 
 /**
  * @brief Get the current user's refresh token.
  *
- * @return Pointer to the stored refresh token, or NULL if none is set.
+ * @return Copy of the stored refresh token, or NULL if none is set.
+ *         The caller owns it and frees it with free_token().
  */
 token_t *state_get_user_refresh_token(void);
 
@@ -60,7 +76,8 @@ void state_set_device_token(const token_t *device_token);
 /**
  * @brief Get the currently stored device token.
  *
- * @return Pointer to the stored device token, or NULL if none is set.
+ * @return Copy of the stored device token, or NULL if none is set.
+ *         The caller owns it and frees it with free_token().
  */
 token_t *state_get_device_token(void);
 
@@ -74,7 +91,8 @@ void state_set_sisu_token(const token_t *sisu_token);
 /**
  * @brief Get the currently stored SISU token.
  *
- * @return Pointer to the stored SISU token, or NULL if none is set.
+ * @return Copy of the stored SISU token, or NULL if none is set.
+ *         The caller owns it and frees it with free_token().
  */
 token_t *state_get_sisu_token(void);
 
@@ -88,10 +106,37 @@ void state_set_xbox_identity(const xbox_identity_t *xbox_identity);
 /**
  * @brief Get the currently stored Xbox identity information.
  *
- * @return Pointer to the stored identity, or NULL if none is set.
+ * @return Copy of the stored identity, or NULL if none is set. The caller owns
+ *         it and frees it with free_identity().
  */
 xbox_identity_t *state_get_xbox_identity(void);
 
+/**
+ * @brief Get the version of the stored Xbox identity.
+ *
+ * The version changes every time the identity is set or cleared, which lets
+ * callers keep a copy of the identity and detect when it becomes stale.
+ *
+ * @return Current version of the stored identity.
+ */
+long state_get_xbox_identity_version(void);
+
+/**
+ * @brief Set whether the recently played games are prefetched.
+ *
+ * The preference is shared by every source and kept across sign-outs.
+ *
+ * @param enabled True to prefetch the recently played games.
+ */
+void state_set_prefetch_enabled(bool enabled);
+
+/**
+ * @brief Get whether the recently played games are prefetched.
+ *
+ * @return The stored preference; false (the default) if it was never set.
+ */
+bool state_get_prefetch_enabled(void);
+
 /**
  * @brief Clear all in-memory state (and typically any persisted state).
  *
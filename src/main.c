@@ -5,7 +5,10 @@
 #include "sources/xbox/game_cover.h"
 #include "sources/xbox/gamerscore.h"
 
+#include "io/cover_cache.h"
 #include "io/state.h"
+#include "net/http/http.h"
+#include "oauth/xbox-live.h"
 
 OBS_DECLARE_MODULE()
 OBS_MODULE_USE_DEFAULT_LOCALE(PLUGIN_NAME, "en-US")
@@ -13,6 +16,7 @@ OBS_MODULE_USE_DEFAULT_LOCALE(PLUGIN_NAME, "en-US")
 bool obs_module_load(void) {
     obs_log(LOG_INFO, "loading plugin (version %s)", PLUGIN_VERSION);
     io_load();
+    xbox_live_start_refresher();
 
     xbox_account_source_register();
     xbox_game_cover_source_register();
@@ -24,5 +28,14 @@ bool obs_module_load(void) {
 }
 
 void obs_module_unload(void) {
+    /* Threads waiting for a throttled request to be retried give up right away */
+    http_interrupt_waits();
+
+    /* The token refresher uses the device key and the state flusher: it must stop first */
+    xbox_live_cleanup();
+    io_unload();
+    http_cleanup();
+    cover_cache_cleanup();
+
     obs_log(LOG_INFO, "plugin unloaded");
 }
@@ -1,57 +1,275 @@
 #include "net/http/http.h"
+#include "net/http/http_buffer.h"
+#include "net/http/http_throttle.h"
+#include "net/http/http_timings.h"
 
 #include <obs-module.h>
 #include <diagnostics/log.h>
 
+#include <util/platform.h>
+#include <util/threading.h>
+
 #include <curl/curl.h>
+#include <pthread.h>
+#include <stdlib.h>
 #include <string.h>
 
 #define VERBOSE 0L
 #define DEFAULT_USER_AGENT "achievements-tracker-obs-plugin/1.0"
 
+/** Longest time a transfer may take, in seconds, so a stalled connection never blocks its caller forever */
+#define TIMEOUT_SECONDS 30L
+
+/** Longest time establishing a connection may take, in seconds */
+#define CONNECT_TIMEOUT_SECONDS 10L
+
+/** Content-Length values above this are not trusted to presize response buffers */
+#define MAX_PRESIZED_BODY (16 * 1024 * 1024)
+
+/** Maximum number of idle easy handles kept around for reuse */
+#define MAX_POOLED_HANDLES 8
+
+/** Attempts made for a throttled or transiently failing request, the first one included */
+#define MAX_ATTEMPTS 4
+
+/** Retry-After delays longer than this are not waited for: the response is reported instead */
+#define MAX_RETRY_AFTER_MS (15 * 1000)
+
+/**
+ * Longest time a request may take, in milliseconds, its transfers, throttling slots and retries included. Retries
+ * only get the time left: timed out transfers are not retried.
+ */
+#define MAX_REQUEST_TIME_MS (45 * 1000)
+
+/**
+ * @brief Process-wide pool of reusable libcurl easy handles.
+ *
+ * All the handles are attached to the same CURLSH object so that the DNS cache,
+ * the connection cache and the TLS session cache are shared by every request,
+ * whichever thread performs it (auth flow, monitor worker, cover downloads...).
+ * A handle returned to the pool keeps its live connections, so the next request
+ * to the same host skips the DNS lookup as well as the TCP and TLS handshakes.
+ */
+typedef struct http_pool {
+    /** Share object holding the DNS, connection and TLS session caches */
+    CURLSH *share;
+
+    /** One lock per kind of shared data, as required by libcurl */
+    pthread_mutex_t share_locks[CURL_LOCK_DATA_LAST];
+
+    /** Protects @c idle_handles and @c idle_count */
+    pthread_mutex_t mutex;
+
+    /** Idle handles ready to be reused (LIFO so the warmest handle is reused first) */
+    CURL  *idle_handles[MAX_POOLED_HANDLES];
+    size_t idle_count;
+} http_pool_t;
+
+static http_pool_t    g_pool;
+static pthread_once_t g_pool_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Header lines shared by several requests.
+ *
+ * The list is never modified once a request uses it: requests link their own
+ * header lines in front of it instead of copying it.
+ */
+struct http_headers {
+    struct curl_slist *list;
+    struct curl_slist *tail;
+    volatile long      refs;
+};
+
 /**
- * @brief Growable NUL-terminated character buffer used for HTTP response bodies.
+ * @brief Request being built.
  */
-struct http_buffer {
-    char  *ptr;
-    size_t len;
+struct http_request {
+    char *url;
+    char *body;
+
+    /** Header lines owned by the request */
+    struct curl_slist *headers;
+    struct curl_slist *tail;
+
+    /** Shared header lines, linked after @c tail while the request runs (reference held) */
+    http_headers_t *shared_headers;
 };
 
 /**
- * @brief Growable byte buffer used for binary downloads.
+ * @brief Asynchronous request tracked by the event loop.
+ */
+typedef struct http_async_request {
+    CURL               *curl;
+    http_request_t     *definition;
+    http_buffer_t       response;
+    char               *etag;
+    char               *last_modified;
+    http_completed_t    on_completed;
+    void               *user_data;
+
+    /** Number of attempts completed so far */
+    uint32_t attempts;
+
+    /** Time the first attempt was started at, which the time of the retries is counted from (0 until then) */
+    int64_t started_ms;
+
+    /** Time the request may be started at, while it waits in the delayed list */
+    int64_t due_ms;
+
+    /** URL and header lines of a GET, identifying the requests that can share its response (NULL otherwise) */
+    char *dedup_key;
+
+    /** Identical GETs submitted while this one was pending: they complete with a copy of its response */
+    struct http_async_request *followers;
+
+    struct http_async_request *next;
+} http_async_request_t;
+
+/**
+ * @brief Event loop driving a curl_multi handle on a dedicated thread.
+ *
+ * Requests are submitted from any thread into @c submitted, then picked up by
+ * the loop thread which owns the multi handle. curl_multi_wakeup() interrupts
+ * curl_multi_poll() whenever something is submitted or the loop must stop.
+ */
+typedef struct http_event_loop {
+    CURLM    *multi;
+    pthread_t thread;
+    bool      started;
+
+    /** Protects @c submitted and @c running */
+    pthread_mutex_t mutex;
+    bool            running;
+
+    /** Requests waiting to be added to the multi handle */
+    http_async_request_t *submitted;
+
+    /** Requests added to the multi handle (only touched by the loop thread) */
+    http_async_request_t *in_flight;
+
+    /** Requests waiting for their throttling or retry delay (only touched by the loop thread) */
+    http_async_request_t *delayed;
+} http_event_loop_t;
+
+static http_event_loop_t g_loop;
+static pthread_once_t    g_loop_once = PTHREAD_ONCE_INIT;
+
+/** Signaled to cut short the waits of the blocking requests (manual reset) */
+static os_event_t    *g_interrupted;
+static pthread_once_t g_interrupted_once = PTHREAD_ONCE_INIT;
+
+/** Totals of the response bodies received since the module was loaded */
+static http_transfer_stats_t g_stats;
+static pthread_mutex_t       g_stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Completion state shared between a waiting thread and the event loop.
  */
-struct image_buffer {
-    uint8_t *data;
-    size_t   size;
-    size_t   capacity;
+struct http_future {
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    bool            completed;
+    long            http_code;
+    char           *body;
+    char           *etag;
+    char           *last_modified;
 };
 
 /**
- * @brief libcurl write callback that appends received bytes into a growable buffer.
+ * @brief libcurl write callback that appends received bytes into a response buffer.
  *
- * The callback assumes @p userp points to a struct with a `ptr` member that is
- * managed via OBS' allocators (brealloc/bfree). The buffer is always kept
- * NUL-terminated so it can be treated as a C string.
+ * @p userp points to an http_buffer_t. The buffer grows geometrically, so a body
+ * delivered in many chunks only costs a few reallocations.
  *
  * @return Number of bytes taken. Returning 0 signals an out-of-memory condition
  *         to libcurl.
  */
 static size_t curl_write_cb(void *contents, size_t size, size_t nmemb, void *userp) {
-    size_t              realsize = size * nmemb;
-    struct http_buffer *mem      = userp;
-
-    char *p = brealloc(mem->ptr, mem->len + realsize + 1);
+    size_t         realsize = size * nmemb;
+    http_buffer_t *buffer   = userp;
 
-    if (!p)
+    if (!http_buffer_append(buffer, contents, realsize))
         return 0;
 
-    mem->ptr = p;
-    memcpy(&(mem->ptr[mem->len]), contents, realsize);
-    mem->len += realsize;
-    mem->ptr[mem->len] = 0;
     return realsize;
 }
 
+/**
+ * @brief libcurl header callback that presizes the response buffer from Content-Length.
+ *
+ * @p userp points to the http_buffer_t the body will be written into. Headers of
+ * intermediate responses (redirects, 100 Continue) may reserve more than needed,
+ * which is harmless. The Content-Length of a compressed body is its compressed
+ * size: the buffer then grows past the reservation as the body is decompressed.
+ */
+static size_t curl_header_cb(char *buffer, size_t size, size_t nitems, void *userp) {
+    size_t realsize       = size * nitems;
+    size_t content_length = 0;
+
+    if (http_buffer_parse_content_length(buffer, realsize, &content_length) && content_length <= MAX_PRESIZED_BODY) {
+        http_buffer_reserve(userp, content_length);
+    }
+
+    return realsize;
+}
+
+/**
+ * @brief Copy the value of a @p name header line into @p out_value.
+ *
+ * @return true if @p line was a @p name header.
+ */
+static bool capture_header(const char *line, size_t length, const char *name, char **out_value) {
+
+    const char *value        = NULL;
+    size_t      value_length = 0;
+
+    if (!http_buffer_parse_header(line, length, name, &value, &value_length)) {
+        return false;
+    }
+
+    bfree(*out_value);
+    *out_value = value_length > 0 ? bstrdup_n(value, value_length) : NULL;
+
+    return true;
+}
+
+/**
+ * @brief libcurl header callback of asynchronous requests.
+ *
+ * @p userp points to the http_async_request_t. Besides presizing the response
+ * buffer, keeps the cache validators (ETag, Last-Modified) of the final response:
+ * a status line starts a new response and drops those of intermediate ones.
+ */
+static size_t curl_async_header_cb(char *buffer, size_t size, size_t nitems, void *userp) {
+    size_t                realsize = size * nitems;
+    http_async_request_t *request  = userp;
+
+    if (realsize > 5 && strncmp(buffer, "HTTP/", 5) == 0) {
+        bfree(request->etag);
+        bfree(request->last_modified);
+        request->etag          = NULL;
+        request->last_modified = NULL;
+        return realsize;
+    }
+
+    if (capture_header(buffer, realsize, "etag", &request->etag) ||
+        capture_header(buffer, realsize, "last-modified", &request->last_modified)) {
+        return realsize;
+    }
+
+    return curl_header_cb(buffer, size, nitems, &request->response);
+}
+
+/**
+ * @brief Route the response body of @p curl into @p buffer.
+ */
+static void set_response_buffer(CURL *curl, http_buffer_t *buffer) {
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curl_write_cb);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)buffer);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, curl_header_cb);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, (void *)buffer);
+}
+
 /**
  * @brief libcurl debug callback used when CURLOPT_VERBOSE is enabled.
  *
@@ -77,358 +295,1271 @@ static int curl_debug_cb(CURL *handle, curl_infotype type, char *data, size_t si
 }
 
 /**
- * @brief POST application/x-www-form-urlencoded data.
+ * @brief Append a "Name: value" line to a header list in constant time.
  *
- * @param url           Target URL.
- * @param post_fields   Form-encoded request body.
- * @param out_http_code Optional output for HTTP status code.
- * @return Response body allocated with bzalloc/brealloc (caller must bfree()),
- *         or NULL on libcurl failure.
+ * An empty @p value removes the header libcurl would otherwise add itself.
+ *
+ * @return false if the line could not be allocated.
  */
-char *http_post_form(const char *url, const char *post_fields, long *out_http_code) {
-    if (out_http_code)
-        *out_http_code = 0;
-
-    CURL *curl = curl_easy_init();
-
-    if (!curl)
-        return NULL;
-
-    struct http_buffer chunk = {0};
-    chunk.ptr                = bzalloc(1);
-    chunk.len                = 0;
+static bool append_header(struct curl_slist **list,
+                          struct curl_slist **tail,
+                          const char         *name,
+                          const char         *value) {
 
-    struct curl_slist *headers = NULL;
-    headers                    = curl_slist_append(headers, "Content-Type: application/x-www-form-urlencoded");
+    char   line[512];
+    char  *buffer = line;
+    size_t length = strlen(name) + strlen(value) + 3;
 
-    curl_easy_setopt(curl, CURLOPT_VERBOSE, VERBOSE);
-    curl_easy_setopt(curl, CURLOPT_DEBUGFUNCTION, curl_debug_cb);
-    curl_easy_setopt(curl, CURLOPT_DEBUGDATA, NULL);
+    if (length > sizeof(line)) {
+        buffer = bmalloc(length);
+    }
 
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, post_fields);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curl_write_cb);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&chunk);
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, DEFAULT_USER_AGENT);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
-    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 0L);
+    /* "Name:" with nothing after the colon tells libcurl not to send its own Name header */
+    snprintf(buffer, length, *value ? "%s: %s" : "%s:", name, value);
 
-    CURLcode res = curl_easy_perform(curl);
+    /* A one-node list: linked by hand so the list is not walked on every append */
+    struct curl_slist *node = curl_slist_append(NULL, buffer);
 
-    if (res != CURLE_OK) {
-        obs_log(LOG_WARNING, "curl POST form failed: %s", curl_easy_strerror(res));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        bfree(chunk.ptr);
-        return NULL;
+    if (buffer != line) {
+        bfree(buffer);
     }
 
-    long http_code = 0;
-
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+    if (!node) {
+        return false;
+    }
 
-    if (out_http_code)
-        *out_http_code = http_code;
+    if (*tail) {
+        (*tail)->next = node;
+    } else {
+        *list = node;
+    }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+    *tail = node;
 
-    return chunk.ptr;
+    return true;
 }
 
 /**
- * @brief POST a raw request body with optional extra headers.
+ * @brief Add headers given as text to a request.
  *
- * @param url           Target URL.
- * @param body          Request body (may be NULL).
- * @param extra_headers Optional additional headers, one per line (LF or CRLF).
- * @param out_http_code Optional output for HTTP status code.
- * @return Response body allocated with bzalloc/brealloc (caller must bfree()),
- *         or NULL on libcurl failure.
+ * @param request       Request to add the headers to.
+ * @param extra_headers Headers, one per line (LF or CRLF). May be NULL.
  */
-char *http_post(const char *url, const char *body, const char *extra_headers, long *out_http_code) {
-    if (out_http_code)
-        *out_http_code = 0;
+static void add_header_lines(http_request_t *request, const char *extra_headers) {
 
-    CURL *curl = curl_easy_init();
-
-    if (!curl)
-        return NULL;
+    if (!extra_headers || !*extra_headers) {
+        return;
+    }
 
-    struct http_buffer chunk = {0};
-    chunk.ptr                = bzalloc(1);
-    chunk.len                = 0;
+    for (const char *line = extra_headers; *line;) {
+        size_t length = strcspn(line, "\r\n");
+        size_t colon  = strcspn(line, ":");
 
-    struct curl_slist *headers = NULL;
+        if (length > 0 && colon < length) {
+            char  *name  = bstrdup_n(line, colon);
+            size_t start = colon + 1;
 
-    /* Avoid 100-continue edge cases that can hide error bodies on some proxies
-     */
-    headers = curl_slist_append(headers, "Expect:");
-
-    if (extra_headers && *extra_headers) {
-        /* extra_headers contains one header per line (CRLF or LF). */
-        char *dup = bstrdup(extra_headers);
-
-        for (char *line = dup; line && *line;) {
-            char *next = strpbrk(line, "\r\n");
-
-            if (next) {
-                *next   = '\0';
-                /* Skip consecutive line breaks */
-                char *p = next + 1;
-                while (*p == '\r' || *p == '\n')
-                    p++;
-                next = p;
-            } else {
-                next = NULL;
+            while (start < length && line[start] == ' ') {
+                start++;
             }
 
-            if (*line)
-                headers = curl_slist_append(headers, line);
-            line = next;
-        }
-        bfree(dup);
-    }
+            char *value = bstrdup_n(line + start, length - start);
+            http_request_add_header(request, name, value);
 
-    curl_easy_setopt(curl, CURLOPT_VERBOSE, VERBOSE);
-    curl_easy_setopt(curl, CURLOPT_DEBUGFUNCTION, curl_debug_cb);
-    curl_easy_setopt(curl, CURLOPT_DEBUGDATA, NULL);
+            bfree(name);
+            bfree(value);
+        }
 
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curl_write_cb);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&chunk);
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, DEFAULT_USER_AGENT);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
-    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 0L);
+        line += length;
 
-    CURLcode res = curl_easy_perform(curl);
-    if (res != CURLE_OK) {
-        obs_log(LOG_WARNING, "curl POST failed: %s", curl_easy_strerror(res));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        bfree(chunk.ptr);
-        return NULL;
+        /* Skip consecutive line breaks */
+        while (*line == '\r' || *line == '\n') {
+            line++;
+        }
     }
+}
+
+/**
+ * @brief Link the shared header lines of a request after its own ones.
+ *
+ * @return The complete header list to give to libcurl.
+ */
+static struct curl_slist *link_headers(http_request_t *request) {
 
-    long http_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+    struct curl_slist *shared = request->shared_headers ? request->shared_headers->list : NULL;
 
-    if (out_http_code)
-        *out_http_code = http_code;
+    if (!request->tail) {
+        return shared;
+    }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+    request->tail->next = shared;
 
-    return chunk.ptr;
+    return request->headers;
 }
 
 /**
- * @brief POST a JSON request body with optional extra headers.
- *
- * Automatically adds "Content-Type: application/json".
+ * @brief Build the key identifying a GET: its URL followed by its header lines.
  *
- * @param url           Target URL.
- * @param json_body     JSON request body.
- * @param extra_headers Optional additional headers, one per line (LF or CRLF).
- * @param out_http_code Optional output for HTTP status code.
- * @return Response body allocated with bzalloc/brealloc (caller must bfree()),
- *         or NULL on libcurl failure.
+ * @return The key (caller must bfree()), or NULL if the request has a body: its
+ *         response must not be shared.
  */
-char *http_post_json(const char *url, const char *json_body, const char *extra_headers, long *out_http_code) {
-    if (out_http_code)
-        *out_http_code = 0;
+static char *build_dedup_key(const http_request_t *request) {
 
-    CURL *curl = curl_easy_init();
-
-    if (!curl)
+    if (request->body) {
         return NULL;
+    }
+
+    /* The own lines may already be linked to the shared ones: stop at the tail */
+    const struct curl_slist *own    = request->tail ? request->headers : NULL;
+    const struct curl_slist *shared = request->shared_headers ? request->shared_headers->list : NULL;
+    size_t                   size   = strlen(request->url) + 1;
 
-    struct http_buffer chunk = {0};
-    chunk.ptr                = bzalloc(1);
-    chunk.len                = 0;
+    for (const struct curl_slist *node = own; node; node = node == request->tail ? NULL : node->next) {
+        size += strlen(node->data) + 1;
+    }
 
-    struct curl_slist *headers = NULL;
-    headers                    = curl_slist_append(headers, "Content-Type: application/json");
+    for (const struct curl_slist *node = shared; node; node = node->next) {
+        size += strlen(node->data) + 1;
+    }
 
-    /* Avoid 100-continue edge cases that can hide error bodies on some proxies
-     */
-    headers = curl_slist_append(headers, "Expect:");
-
-    if (extra_headers && *extra_headers) {
-        /* extra_headers contains one header per line (CRLF or LF). */
-        char *dup = bstrdup(extra_headers);
-
-        for (char *line = dup; line && *line;) {
-            char *next = strpbrk(line, "\r\n");
-
-            if (next) {
-                *next   = '\0';
-                /* Skip consecutive line breaks */
-                char *p = next + 1;
-                while (*p == '\r' || *p == '\n')
-                    p++;
-                next = p;
-            } else {
-                next = NULL;
-            }
+    char  *key    = bmalloc(size);
+    size_t length = (size_t)snprintf(key, size, "%s", request->url);
 
-            if (*line)
-                headers = curl_slist_append(headers, line);
-            line = next;
-        }
-        bfree(dup);
+    for (const struct curl_slist *node = own; node; node = node == request->tail ? NULL : node->next) {
+        length += (size_t)snprintf(key + length, size - length, "\n%s", node->data);
     }
 
-    curl_easy_setopt(curl, CURLOPT_VERBOSE, VERBOSE);
-    curl_easy_setopt(curl, CURLOPT_DEBUGFUNCTION, curl_debug_cb);
-    curl_easy_setopt(curl, CURLOPT_DEBUGDATA, NULL);
+    for (const struct curl_slist *node = shared; node; node = node->next) {
+        length += (size_t)snprintf(key + length, size - length, "\n%s", node->data);
+    }
 
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, json_body);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curl_write_cb);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&chunk);
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, DEFAULT_USER_AGENT);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
-    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 0L);
+    return key;
+}
 
-    CURLcode res = curl_easy_perform(curl);
+/**
+ * @brief Apply the definition of a request to an easy handle.
+ *
+ * The request is a GET, or a POST when it has a body.
+ */
+static void configure_handle(CURL *curl, http_request_t *request, http_buffer_t *response) {
 
-    if (res != CURLE_OK) {
-        obs_log(LOG_WARNING, "curl POST json failed: %s", curl_easy_strerror(res));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        bfree(chunk.ptr);
-        return NULL;
+    curl_easy_setopt(curl, CURLOPT_URL, request->url);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, link_headers(request));
+    set_response_buffer(curl, response);
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 0L);
+
+    if (request->body) {
+        curl_easy_setopt(curl, CURLOPT_POST, 1L);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request->body);
+    } else {
+        curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
     }
+}
 
-    long http_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+//  --------------------------------------------------------------------------------------------------------------------
+//  Handle pool
+//  --------------------------------------------------------------------------------------------------------------------
 
-    if (out_http_code)
-        *out_http_code = http_code;
+static void share_lock_cb(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr) {
+    (void)handle;
+    (void)access;
+    (void)userptr;
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+    pthread_mutex_lock(&g_pool.share_locks[data]);
+}
+
+static void share_unlock_cb(CURL *handle, curl_lock_data data, void *userptr) {
+    (void)handle;
+    (void)userptr;
 
-    return chunk.ptr;
+    pthread_mutex_unlock(&g_pool.share_locks[data]);
 }
 
 /**
- * @brief Perform an HTTP GET request with optional headers.
- *
- * @param url           Target URL.
- * @param extra_headers Optional additional headers, one per line (LF or CRLF).
- * @param post_fields   Optional body passed to libcurl via CURLOPT_POSTFIELDS.
- * @param out_http_code Optional output for HTTP status code.
- * @return Response body allocated with bzalloc/brealloc (caller must bfree()),
- *         or NULL on libcurl failure.
+ * @brief Initialize libcurl and the shared caches. Runs once per process.
  */
-char *http_get(const char *url, const char *extra_headers, const char *post_fields, long *out_http_code) {
-    if (out_http_code)
-        *out_http_code = 0;
+static void pool_init(void) {
 
-    CURL *curl = curl_easy_init();
-
-    if (!curl)
-        return NULL;
+    curl_global_init(CURL_GLOBAL_DEFAULT);
 
-    struct http_buffer chunk = {0};
-    chunk.ptr                = bzalloc(1);
-    chunk.len                = 0;
+    const curl_version_info_data *version = curl_version_info(CURLVERSION_NOW);
 
-    struct curl_slist *headers = NULL;
+    if (!version || !(version->features & CURL_VERSION_HTTP2)) {
+        obs_log(LOG_INFO, "libcurl was built without HTTP/2: requests will use HTTP/1.1");
+    }
 
-    /* Avoid 100-continue edge cases that can hide error bodies on some proxies
-     */
-    headers = curl_slist_append(headers, "Expect:");
+    pthread_mutex_init(&g_pool.mutex, NULL);
 
-    if (extra_headers && *extra_headers) {
-        /* extra_headers contains one header per line (CRLF or LF). */
-        char *dup = bstrdup(extra_headers);
+    for (int i = 0; i < CURL_LOCK_DATA_LAST; i++) {
+        pthread_mutex_init(&g_pool.share_locks[i], NULL);
+    }
 
-        for (char *line = dup; line && *line;) {
+    g_pool.share = curl_share_init();
 
-            char *next = strpbrk(line, "\r\n");
+    if (!g_pool.share) {
+        obs_log(LOG_WARNING, "Failed to create the curl share object: connections will not be reused");
+        return;
+    }
 
-            if (next) {
-                *next   = '\0';
-                /* Skip consecutive line breaks */
-                char *p = next + 1;
-                while (*p == '\r' || *p == '\n')
-                    p++;
-                next = p;
-            } else {
-                next = NULL;
-            }
+    curl_share_setopt(g_pool.share, CURLSHOPT_LOCKFUNC, share_lock_cb);
+    curl_share_setopt(g_pool.share, CURLSHOPT_UNLOCKFUNC, share_unlock_cb);
+    curl_share_setopt(g_pool.share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(g_pool.share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    curl_share_setopt(g_pool.share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+}
 
-            if (*line)
-                headers = curl_slist_append(headers, line);
-            line = next;
-        }
-        bfree(dup);
-    }
+/**
+ * @brief Apply the options shared by every request.
+ *
+ * Called on freshly created handles as well as on recycled ones, since
+ * curl_easy_reset() restores the libcurl defaults.
+ */
+static void apply_default_options(CURL *curl) {
 
     curl_easy_setopt(curl, CURLOPT_VERBOSE, VERBOSE);
     curl_easy_setopt(curl, CURLOPT_DEBUGFUNCTION, curl_debug_cb);
     curl_easy_setopt(curl, CURLOPT_DEBUGDATA, NULL);
-
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curl_write_cb);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&chunk);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
     curl_easy_setopt(curl, CURLOPT_USERAGENT, DEFAULT_USER_AGENT);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
-    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 0L);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, TIMEOUT_SECONDS);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, CONNECT_TIMEOUT_SECONDS);
 
-    if (post_fields)
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, post_fields);
+    /*
+     * Offers every encoding libcurl was built with (gzip, deflate, brotli...).
+     * Bodies are decompressed on the fly, so the write callbacks only ever see
+     * the decoded bytes.
+     */
+    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
 
-    CURLcode res = curl_easy_perform(curl);
+    /* HTTP/2 when the server agrees to it during the TLS handshake (ALPN), HTTP/1.1 otherwise */
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
 
-    if (res != CURLE_OK) {
-        obs_log(LOG_WARNING, "curl GET failed: %s", curl_easy_strerror(res));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        bfree(chunk.ptr);
-        return NULL;
+    if (g_pool.share) {
+        curl_easy_setopt(curl, CURLOPT_SHARE, g_pool.share);
     }
+}
+
+/**
+ * @brief Add a completed transfer to the statistics and to the timings of its endpoint.
+ *
+ * Must be called before the handle is released, which resets its counters.
+ *
+ * @param curl         Handle the transfer was performed with.
+ * @param decoded_size Size of the body once decompressed.
+ */
+static void record_transfer(CURL *curl, size_t decoded_size) {
+
+    curl_off_t received_size = 0;
+    curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &received_size);
+
+    /* The times are reported in microseconds */
+    curl_off_t name_lookup_time = 0;
+    curl_off_t connect_time     = 0;
+    curl_off_t tls_time         = 0;
+    curl_off_t first_byte_time  = 0;
+    curl_off_t total_time       = 0;
+    curl_off_t sent_size        = 0;
+    long       new_connections  = 0;
+    char      *url              = NULL;
+
+    curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME_T, &name_lookup_time);
+    curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &connect_time);
+    curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &tls_time);
+    curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME_T, &first_byte_time);
+    curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &total_time);
+    curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD_T, &sent_size);
+    curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &new_connections);
+    curl_easy_getinfo(curl, CURLINFO_EFFECTIVE_URL, &url);
+
+    http_timing_sample_t sample = {
+        .name_lookup_us  = (int64_t)name_lookup_time,
+        .connect_us      = (int64_t)connect_time,
+        .tls_us          = (int64_t)tls_time,
+        .first_byte_us   = (int64_t)first_byte_time,
+        .total_us        = (int64_t)total_time,
+        .new_connections = new_connections,
+        .sent_bytes      = sent_size > 0 ? (uint64_t)sent_size : 0,
+        .received_bytes  = received_size > 0 ? (uint64_t)received_size : 0,
+    };
+
+    http_timings_record(url, &sample);
+
+    pthread_mutex_lock(&g_stats_mutex);
+
+    g_stats.responses++;
+    g_stats.received_bytes += received_size > 0 ? (uint64_t)received_size : 0;
+    g_stats.decoded_bytes += decoded_size;
+
+    pthread_mutex_unlock(&g_stats_mutex);
+}
 
-    long http_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+static int64_t now_ms(void) {
+    return (int64_t)(os_gettime_ns() / 1000000);
+}
 
-    if (out_http_code)
-        *out_http_code = http_code;
+/**
+ * @brief Random bits for the jitter of the backoff delays.
+ *
+ * The low bits of the monotonic clock differ from one call and one process to
+ * the next, which is all the jitter needs to spread the retries of clients that
+ * failed together.
+ */
+static uint32_t get_jitter(void) {
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+    uint64_t ns = os_gettime_ns();
 
-    return chunk.ptr;
+    return (uint32_t)(ns ^ (ns >> 32));
 }
 
 /**
- * @brief URL-encode a string (percent-encoding).
- *
- * Uses libcurl's escaping rules and returns a copy allocated with bstrdup.
+ * @brief Shorten the timeout of the next transfer so the request does not take longer than MAX_REQUEST_TIME_MS.
  *
- * @param in Input string.
- * @return Newly allocated encoded string (caller must bfree()), or NULL on error.
+ * @param curl       Handle of the transfer.
+ * @param elapsed_ms Milliseconds the request already took.
  */
-char *http_urlencode(const char *in) {
-    if (!in)
-        return NULL;
+static void limit_transfer_time(CURL *curl, int64_t elapsed_ms) {
 
-    CURL *curl = curl_easy_init();
+    int64_t remaining_ms = MAX_REQUEST_TIME_MS - elapsed_ms;
 
-    if (!curl)
-        return NULL;
+    if (remaining_ms < TIMEOUT_SECONDS * 1000) {
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, (long)(remaining_ms > 0 ? remaining_ms : 1));
+    }
+}
+
+/**
+ * @brief Decide whether a completed attempt is made again, and when.
+ *
+ * Throttled responses (429, 503) are retried whatever the method, since the
+ * service did not process them. Transport failures are only retried for GETs,
+ * which are idempotent, and neither timeouts nor interrupted transfers are: the
+ * request already used up its time. A Retry-After delay also holds back the
+ * other requests to the host, and the limits reported by a 429 tune its token
+ * bucket.
+ *
+ * Must be called before the handle is released.
+ *
+ * @param curl      Handle the attempt was performed with.
+ * @param request   Request that was sent.
+ * @param result    Outcome of the transfer.
+ * @param http_code HTTP status code of the response.
+ * @param body      Body of the response (may be NULL).
+ * @param attempts  Number of attempts made, the completed one included.
+ * @param elapsed_ms Milliseconds the request already took, its transfers included.
+ *
+ * @return Delay before the next attempt in milliseconds, or -1 if the outcome
+ *         must be reported as is.
+ */
+static int64_t get_retry_delay(CURL                 *curl,
+                               const http_request_t *request,
+                               CURLcode              result,
+                               long                  http_code,
+                               const char           *body,
+                               uint32_t              attempts,
+                               int64_t               elapsed_ms) {
+
+    bool throttled = result == CURLE_OK && (http_code == 429 || http_code == 503);
+    bool transient = result != CURLE_OK && result != CURLE_OPERATION_TIMEDOUT && result != CURLE_ABORTED_BY_CALLBACK &&
+                     !request->body;
+
+    if (!throttled && !transient) {
+        return -1;
+    }
+
+    int64_t delay_ms       = http_throttle_backoff_ms(attempts, get_jitter());
+    int64_t retry_after_ms = 0;
+
+    if (throttled) {
+        curl_off_t retry_after = 0;
+        curl_easy_getinfo(curl, CURLINFO_RETRY_AFTER, &retry_after);
+
+        retry_after_ms = (int64_t)retry_after * 1000;
+
+        if (retry_after_ms > 0) {
+            http_throttle_defer(request->url, now_ms() + retry_after_ms);
+        }
+
+        uint32_t max_requests   = 0;
+        uint32_t period_seconds = 0;
+
+        if (http_code == 429 && http_throttle_parse_limit(body, &max_requests, &period_seconds)) {
+            obs_log(LOG_INFO,
+                    "HTTP | %s accepts %u requests every %u seconds",
+                    request->url,
+                    max_requests,
+                    period_seconds);
+            http_throttle_set_limit(request->url, max_requests, period_seconds);
+        }
+    }
+
+    if (attempts >= MAX_ATTEMPTS || retry_after_ms > MAX_RETRY_AFTER_MS) {
+        return -1;
+    }
+
+    if (retry_after_ms > delay_ms) {
+        delay_ms = retry_after_ms;
+    }
+
+    if (elapsed_ms + delay_ms > MAX_REQUEST_TIME_MS) {
+        return -1;
+    }
+
+    obs_log(LOG_INFO,
+            "HTTP | %s %s: attempt %u %s, retrying in %lld ms",
+            request->body ? "POST" : "GET",
+            request->url,
+            attempts,
+            throttled ? "throttled" : "failed",
+            (long long)delay_ms);
+
+    return delay_ms;
+}
+
+static void interrupted_init(void) {
+
+    if (os_event_init(&g_interrupted, OS_EVENT_TYPE_MANUAL) != 0) {
+        obs_log(LOG_ERROR, "HTTP | Failed to create the interruption event: waits cannot be interrupted");
+        g_interrupted = NULL;
+    }
+}
+
+/**
+ * @brief Wait before sending a blocking request, unless the waits are interrupted.
+ *
+ * @param delay_ms Milliseconds to wait.
+ *
+ * @return true once the delay has elapsed, false if the wait was interrupted by
+ *         http_interrupt_waits().
+ */
+static bool wait_before_sending(int64_t delay_ms) {
+
+    pthread_once(&g_interrupted_once, interrupted_init);
+
+    if (!g_interrupted) {
+        os_sleep_ms((uint32_t)delay_ms);
+        return true;
+    }
+
+    return os_event_timedwait(g_interrupted, (unsigned long)delay_ms) != 0;
+}
+
+/**
+ * @brief libcurl progress callback aborting a blocking transfer once the waits are interrupted.
+ *
+ * @return Non-zero to abort the transfer.
+ */
+static int curl_interrupt_cb(void       *clientp,
+                             curl_off_t  download_total,
+                             curl_off_t  downloaded,
+                             curl_off_t  upload_total,
+                             curl_off_t  uploaded) {
+    (void)clientp;
+    (void)download_total;
+    (void)downloaded;
+    (void)upload_total;
+    (void)uploaded;
+
+    return os_event_try(g_interrupted) == 0;
+}
+
+/**
+ * @brief Let http_interrupt_waits() abort the transfer of a blocking request.
+ *
+ * A stalled transfer would otherwise hold its thread until it times out.
+ */
+static void make_interruptible(CURL *curl) {
+
+    pthread_once(&g_interrupted_once, interrupted_init);
+
+    if (!g_interrupted) {
+        return;
+    }
+
+    curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, curl_interrupt_cb);
+    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+}
+
+/**
+ * @brief Take an easy handle from the pool, creating one if none is idle.
+ *
+ * The returned handle has the default options applied.
+ *
+ * @return Easy handle to give back with release_handle(), or NULL on failure.
+ */
+static CURL *acquire_handle(void) {
+
+    pthread_once(&g_pool_once, pool_init);
+
+    CURL *curl = NULL;
+
+    pthread_mutex_lock(&g_pool.mutex);
+
+    if (g_pool.idle_count > 0) {
+        curl = g_pool.idle_handles[--g_pool.idle_count];
+    }
+
+    pthread_mutex_unlock(&g_pool.mutex);
+
+    if (!curl) {
+        curl = curl_easy_init();
+
+        if (!curl) {
+            return NULL;
+        }
+    }
+
+    apply_default_options(curl);
+
+    return curl;
+}
+
+/**
+ * @brief Give an easy handle back to the pool.
+ *
+ * The handle is reset (its live connections and caches are kept) and parked for
+ * the next request, or destroyed if the pool is already full.
+ */
+static void release_handle(CURL *curl) {
+
+    if (!curl) {
+        return;
+    }
+
+    curl_easy_reset(curl);
+
+    pthread_mutex_lock(&g_pool.mutex);
+
+    if (g_pool.idle_count < MAX_POOLED_HANDLES) {
+        g_pool.idle_handles[g_pool.idle_count++] = curl;
+        curl                                     = NULL;
+    }
+
+    pthread_mutex_unlock(&g_pool.mutex);
+
+    if (curl) {
+        curl_easy_cleanup(curl);
+    }
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Event loop
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Invoke the completion callback of a request and free it.
+ *
+ * @param http_code HTTP status code, or 0 if the transfer failed.
+ */
+static void complete_request(http_async_request_t *request, long http_code, bool succeeded) {
+
+    /* The identical GETs that joined the request get their own copy of the response */
+    while (request->followers) {
+        http_async_request_t *follower = request->followers;
+        request->followers             = follower->next;
+
+        if (succeeded) {
+            if (request->response.size > 0) {
+                http_buffer_append(&follower->response, request->response.data, request->response.size);
+            }
+
+            follower->etag          = request->etag ? bstrdup(request->etag) : NULL;
+            follower->last_modified = request->last_modified ? bstrdup(request->last_modified) : NULL;
+        }
+
+        complete_request(follower, http_code, succeeded);
+    }
+
+    http_response_t response = {
+        .http_code = http_code,
+    };
+
+    if (succeeded) {
+        /* The callback may take ownership of the body and of the validators */
+        response.body          = http_buffer_detach(&request->response, &response.body_size);
+        response.etag          = request->etag;
+        response.last_modified = request->last_modified;
+        request->etag          = NULL;
+        request->last_modified = NULL;
+    }
+
+    if (request->on_completed) {
+        request->on_completed(&response, request->user_data);
+    }
+
+    bfree(response.body);
+    bfree(response.etag);
+    bfree(response.last_modified);
+    bfree(request->etag);
+    bfree(request->last_modified);
+    bfree(request->dedup_key);
+    http_buffer_free(&request->response);
+    http_request_free(&request->definition);
+    bfree(request);
+}
+
+/**
+ * @brief Configure the easy handle of a request and add it to the multi handle.
+ */
+static void start_request(http_async_request_t *request) {
+
+    CURL *curl = acquire_handle();
+
+    if (!curl) {
+        obs_log(LOG_WARNING, "curl async %s failed: unable to get a handle", request->definition->url);
+        complete_request(request, 0, false);
+        return;
+    }
+
+    request->curl = curl;
+
+    if (request->started_ms == 0) {
+        request->started_ms = now_ms();
+    }
+
+    configure_handle(curl, request->definition, &request->response);
+    limit_transfer_time(curl, now_ms() - request->started_ms);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, curl_async_header_cb);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, (void *)request);
+    curl_easy_setopt(curl, CURLOPT_PRIVATE, request);
+
+    /*
+     * While the first connection to an origin is being set up, the requests
+     * started alongside wait to learn whether it multiplexes instead of each
+     * opening their own connection.
+     */
+    curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+
+    CURLMcode code = curl_multi_add_handle(g_loop.multi, curl);
+
+    if (code != CURLM_OK) {
+        obs_log(LOG_WARNING, "curl async %s failed: %s", request->definition->url, curl_multi_strerror(code));
+        request->curl = NULL;
+        release_handle(curl);
+        complete_request(request, 0, false);
+        return;
+    }
+
+    request->next    = g_loop.in_flight;
+    g_loop.in_flight = request;
+}
+
+/**
+ * @brief Remove a request from the in-flight list and give its handle back to the pool.
+ */
+static void finish_request(http_async_request_t *request) {
+
+    http_async_request_t **link = &g_loop.in_flight;
+
+    while (*link && *link != request) {
+        link = &(*link)->next;
+    }
+
+    if (*link) {
+        *link = request->next;
+    }
+
+    curl_multi_remove_handle(g_loop.multi, request->curl);
+    release_handle(request->curl);
+    request->curl = NULL;
+}
+
+/**
+ * @brief Start a request after a delay.
+ *
+ * @param delay_ms Milliseconds to wait; the request is started right away if 0 or less.
+ */
+static void delay_request(http_async_request_t *request, int64_t delay_ms) {
+
+    if (delay_ms <= 0) {
+        start_request(request);
+        return;
+    }
+
+    request->due_ms = now_ms() + delay_ms;
+    request->next   = g_loop.delayed;
+    g_loop.delayed  = request;
+}
+
+/**
+ * @brief Find a pending GET identical to the one of @p key.
+ */
+static http_async_request_t *find_identical_request(const char *key) {
+
+    http_async_request_t *lists[] = {g_loop.in_flight, g_loop.delayed};
+
+    for (size_t i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+        for (http_async_request_t *request = lists[i]; request; request = request->next) {
+            if (request->dedup_key && strcmp(request->dedup_key, key) == 0) {
+                return request;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Schedule a submitted request.
+ *
+ * A GET identical to a pending one joins it instead of being sent. Otherwise the
+ * request waits for a slot of its host's token bucket.
+ */
+static void schedule_request(http_async_request_t *request) {
+
+    request->dedup_key = build_dedup_key(request->definition);
+
+    http_async_request_t *identical = request->dedup_key ? find_identical_request(request->dedup_key) : NULL;
+
+    if (identical) {
+        obs_log(LOG_DEBUG, "HTTP | GET %s is already pending: sharing its response", request->definition->url);
+        request->next        = identical->followers;
+        identical->followers = request;
+        return;
+    }
+
+    delay_request(request, http_throttle_reserve(request->definition->url, now_ms()));
+}
+
+/**
+ * @brief Send a request again after a throttled or failed attempt.
+ */
+static void retry_request(http_async_request_t *request, int64_t delay_ms) {
+
+    http_buffer_free(&request->response);
+    http_buffer_init(&request->response, false);
+
+    bfree(request->etag);
+    bfree(request->last_modified);
+    request->etag          = NULL;
+    request->last_modified = NULL;
+
+    /* The new attempt takes a slot like any other request to the host */
+    int64_t throttle_ms = http_throttle_reserve(request->definition->url, now_ms());
+
+    if (throttle_ms > delay_ms) {
+        delay_ms = throttle_ms;
+    }
+
+    delay_request(request, delay_ms);
+}
+
+/**
+ * @brief Start the delayed requests whose time has come.
+ *
+ * @return Milliseconds until the next delayed request is due, or -1 if none is left.
+ */
+static int64_t start_due_requests(void) {
+
+    int64_t                now     = now_ms();
+    int64_t                next_ms = -1;
+    http_async_request_t **link    = &g_loop.delayed;
+
+    while (*link) {
+        http_async_request_t *request = *link;
+
+        if (request->due_ms <= now) {
+            *link         = request->next;
+            request->next = NULL;
+            start_request(request);
+            continue;
+        }
+
+        if (next_ms < 0 || request->due_ms - now < next_ms) {
+            next_ms = request->due_ms - now;
+        }
+
+        link = &request->next;
+    }
+
+    return next_ms;
+}
+
+/**
+ * @brief Complete every transfer reported as done by the multi handle.
+ */
+static void process_finished_transfers(void) {
+
+    CURLMsg *message;
+    int      remaining = 0;
+
+    while ((message = curl_multi_info_read(g_loop.multi, &remaining))) {
+
+        if (message->msg != CURLMSG_DONE) {
+            continue;
+        }
+
+        CURL                 *curl    = message->easy_handle;
+        CURLcode              result  = message->data.result;
+        http_async_request_t *request = NULL;
+        long                  code    = 0;
+
+        curl_easy_getinfo(curl, CURLINFO_PRIVATE, (char **)&request);
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
+
+        record_transfer(curl, request->response.size);
+
+        int64_t retry_delay_ms = get_retry_delay(curl,
+                                                 request->definition,
+                                                 result,
+                                                 code,
+                                                 request->response.data,
+                                                 ++request->attempts,
+                                                 now_ms() - request->started_ms);
+
+        finish_request(request);
+
+        if (retry_delay_ms >= 0) {
+            retry_request(request, retry_delay_ms);
+            continue;
+        }
+
+        if (result != CURLE_OK) {
+            obs_log(LOG_WARNING, "curl async %s failed: %s", request->definition->url, curl_easy_strerror(result));
+            complete_request(request, 0, false);
+            continue;
+        }
+
+        complete_request(request, code, true);
+    }
+}
+
+/**
+ * @brief Event loop thread entry point.
+ */
+static void *event_loop_thread(void *arg) {
+    (void)arg;
+
+    while (true) {
+
+        pthread_mutex_lock(&g_loop.mutex);
+        bool                  running   = g_loop.running;
+        http_async_request_t *submitted = g_loop.submitted;
+        g_loop.submitted                = NULL;
+        pthread_mutex_unlock(&g_loop.mutex);
+
+        /* Requests were pushed at the head: restore the submission order */
+        http_async_request_t *ordered = NULL;
+
+        while (submitted) {
+            http_async_request_t *next = submitted->next;
+            submitted->next            = ordered;
+            ordered                    = submitted;
+            submitted                  = next;
+        }
+
+        while (ordered) {
+            http_async_request_t *next = ordered->next;
+
+            if (running) {
+                schedule_request(ordered);
+            } else {
+                complete_request(ordered, 0, false);
+            }
+
+            ordered = next;
+        }
+
+        if (!running) {
+            break;
+        }
+
+        int running_transfers = 0;
+        curl_multi_perform(g_loop.multi, &running_transfers);
+
+        process_finished_transfers();
+
+        int64_t next_due_ms = start_due_requests();
+
+        /* Wakes up in time for the next delayed request */
+        int timeout_ms = next_due_ms >= 0 && next_due_ms < 1000 ? (int)next_due_ms : 1000;
+
+        curl_multi_poll(g_loop.multi, NULL, 0, timeout_ms, NULL);
+    }
+
+    /* Transfers still in flight or waiting are abandoned */
+    while (g_loop.in_flight) {
+        http_async_request_t *request = g_loop.in_flight;
+        finish_request(request);
+        complete_request(request, 0, false);
+    }
+
+    while (g_loop.delayed) {
+        http_async_request_t *request = g_loop.delayed;
+        g_loop.delayed                = request->next;
+        complete_request(request, 0, false);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Create the multi handle and start the event loop thread. Runs once per process.
+ */
+static void event_loop_init(void) {
+
+    pthread_once(&g_pool_once, pool_init);
+
+    pthread_mutex_init(&g_loop.mutex, NULL);
+
+    g_loop.multi = curl_multi_init();
+
+    if (!g_loop.multi) {
+        obs_log(LOG_ERROR, "Failed to create the curl multi handle");
+        return;
+    }
+
+    /* Concurrent requests to the same origin share one HTTP/2 connection */
+    curl_multi_setopt(g_loop.multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+    g_loop.running = true;
+
+    if (pthread_create(&g_loop.thread, NULL, event_loop_thread, NULL) != 0) {
+        obs_log(LOG_ERROR, "Failed to create the HTTP event loop thread");
+        g_loop.running = false;
+        curl_multi_cleanup(g_loop.multi);
+        g_loop.multi = NULL;
+        return;
+    }
+
+    g_loop.started = true;
+}
+
+/**
+ * @brief Stop the event loop thread. Pending requests complete with a failure.
+ */
+static void event_loop_stop(void) {
+
+    if (!g_loop.started) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_loop.mutex);
+    g_loop.running = false;
+    pthread_mutex_unlock(&g_loop.mutex);
+
+    curl_multi_wakeup(g_loop.multi);
+    pthread_join(g_loop.thread, NULL);
+
+    curl_multi_cleanup(g_loop.multi);
+    g_loop.multi   = NULL;
+    g_loop.started = false;
+}
+
+static void on_future_completed(http_response_t *response, void *user_data) {
+
+    http_future_t *future = user_data;
+
+    pthread_mutex_lock(&future->mutex);
+
+    future->http_code     = response->http_code;
+    future->body          = response->body;
+    future->etag          = response->etag;
+    future->last_modified = response->last_modified;
+    future->completed     = true;
+
+    /* The body and the validators now belong to the future */
+    response->body          = NULL;
+    response->etag          = NULL;
+    response->last_modified = NULL;
+
+    pthread_cond_signal(&future->cond);
+    pthread_mutex_unlock(&future->mutex);
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+http_headers_t *http_headers_create(void) {
+
+    http_headers_t *headers = bzalloc(sizeof(http_headers_t));
+    headers->refs           = 1;
+
+    return headers;
+}
+
+bool http_headers_add(http_headers_t *headers, const char *name, const char *value) {
+
+    if (!headers || !name || !value) {
+        return false;
+    }
+
+    return append_header(&headers->list, &headers->tail, name, value);
+}
+
+void http_headers_release(http_headers_t **headers) {
+
+    if (!headers || !*headers) {
+        return;
+    }
+
+    http_headers_t *current = *headers;
+    *headers                = NULL;
+
+    if (os_atomic_dec_long(&current->refs) > 0) {
+        return;
+    }
+
+    curl_slist_free_all(current->list);
+    bfree(current);
+}
+
+http_request_t *http_request_create(const char *url) {
+
+    if (!url) {
+        return NULL;
+    }
+
+    http_request_t *request = bzalloc(sizeof(http_request_t));
+    request->url            = bstrdup(url);
+
+    return request;
+}
+
+bool http_request_add_header(http_request_t *request, const char *name, const char *value) {
+
+    if (!request || !name || !value) {
+        return false;
+    }
+
+    return append_header(&request->headers, &request->tail, name, value);
+}
+
+void http_request_use_headers(http_request_t *request, http_headers_t *headers) {
+
+    if (!request) {
+        return;
+    }
+
+    if (headers) {
+        os_atomic_inc_long(&headers->refs);
+    }
+
+    http_headers_release(&request->shared_headers);
+    request->shared_headers = headers;
+}
+
+void http_request_set_body(http_request_t *request, const char *body, const char *content_type) {
+
+    if (!request || !body) {
+        return;
+    }
+
+    bfree(request->body);
+    request->body = bstrdup(body);
+
+    if (content_type) {
+        http_request_add_header(request, "Content-Type", content_type);
+    }
+
+    /* Avoid 100-continue edge cases that can hide error bodies on some proxies */
+    append_header(&request->headers, &request->tail, "Expect", "");
+}
+
+void http_request_free(http_request_t **request) {
+
+    if (!request || !*request) {
+        return;
+    }
+
+    http_request_t *current = *request;
+
+    /* The shared lines are not the request's to free */
+    if (current->tail) {
+        current->tail->next = NULL;
+    }
+
+    curl_slist_free_all(current->headers);
+    http_headers_release(&current->shared_headers);
+    bfree(current->url);
+    bfree(current->body);
+    bfree(current);
+
+    *request = NULL;
+}
+
+/**
+ * @brief Perform a request on the calling thread.
+ */
+char *http_request_perform(http_request_t *request, long *out_http_code) {
+
+    char *response = NULL;
+
+    if (out_http_code)
+        *out_http_code = 0;
+
+    if (!request)
+        return NULL;
+
+    int64_t started_ms = now_ms();
+
+    for (uint32_t attempts = 1;; attempts++) {
+
+        /* Blocking requests wait for their slot on the calling thread */
+        int64_t throttle_ms = http_throttle_reserve(request->url, now_ms());
+
+        if (throttle_ms > 0) {
+            if (now_ms() - started_ms + throttle_ms > MAX_REQUEST_TIME_MS) {
+                obs_log(LOG_WARNING, "HTTP | %s: too many requests queued for the host, giving up", request->url);
+                goto cleanup;
+            }
+
+            if (!wait_before_sending(throttle_ms)) {
+                obs_log(LOG_INFO, "HTTP | %s: wait interrupted, giving up", request->url);
+                goto cleanup;
+            }
+        }
+
+        CURL *curl = acquire_handle();
+
+        if (!curl)
+            goto cleanup;
+
+        /* Blocking requests complete on the calling thread: borrow its arena */
+        http_buffer_t chunk;
+        http_buffer_init(&chunk, true);
+
+        configure_handle(curl, request, &chunk);
+        limit_transfer_time(curl, now_ms() - started_ms);
+        make_interruptible(curl);
+
+        CURLcode res       = curl_easy_perform(curl);
+        long     http_code = 0;
+
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+        record_transfer(curl, chunk.size);
+
+        int64_t retry_delay_ms =
+            get_retry_delay(curl, request, res, http_code, chunk.data, attempts, now_ms() - started_ms);
+
+        release_handle(curl);
+
+        if (retry_delay_ms >= 0) {
+            http_buffer_free(&chunk);
+
+            if (!wait_before_sending(retry_delay_ms)) {
+                obs_log(LOG_INFO, "HTTP | %s: wait interrupted, giving up", request->url);
+                goto cleanup;
+            }
+
+            continue;
+        }
+
+        if (res != CURLE_OK) {
+            obs_log(LOG_WARNING,
+                    "curl %s %s failed: %s",
+                    request->body ? "POST" : "GET",
+                    request->url,
+                    curl_easy_strerror(res));
+            http_buffer_free(&chunk);
+            goto cleanup;
+        }
+
+        if (out_http_code)
+            *out_http_code = http_code;
+
+        response = http_buffer_detach(&chunk, NULL);
+        break;
+    }
+
+cleanup:
+    http_request_free(&request);
+
+    return response;
+}
+
+/**
+ * @brief POST application/x-www-form-urlencoded data.
+ *
+ * @param url           Target URL.
+ * @param post_fields   Form-encoded request body.
+ * @param out_http_code Optional output for HTTP status code.
+ * @return Response body allocated with bzalloc/brealloc (caller must bfree()),
+ *         or NULL on libcurl failure.
+ */
+char *http_post_form(const char *url, const char *post_fields, long *out_http_code) {
+
+    http_request_t *request = http_request_create(url);
+    http_request_set_body(request, post_fields ? post_fields : "", "application/x-www-form-urlencoded");
+
+    return http_request_perform(request, out_http_code);
+}
+
+/**
+ * @brief POST a raw request body with optional extra headers.
+ *
+ * @param url           Target URL.
+ * @param body          Request body (may be NULL).
+ * @param extra_headers Optional additional headers, one per line (LF or CRLF).
+ * @param out_http_code Optional output for HTTP status code.
+ * @return Response body allocated with bzalloc/brealloc (caller must bfree()),
+ *         or NULL on libcurl failure.
+ */
+char *http_post(const char *url, const char *body, const char *extra_headers, long *out_http_code) {
+
+    http_request_t *request = http_request_create(url);
+    add_header_lines(request, extra_headers);
+    http_request_set_body(request, body ? body : "", NULL);
+
+    return http_request_perform(request, out_http_code);
+}
+
+/**
+ * @brief POST a JSON request body with optional extra headers.
+ *
+ * Automatically adds "Content-Type: application/json".
+ *
+ * @param url           Target URL.
+ * @param json_body     JSON request body.
+ * @param extra_headers Optional additional headers, one per line (LF or CRLF).
+ * @param out_http_code Optional output for HTTP status code.
+ * @return Response body allocated with bzalloc/brealloc (caller must bfree()),
+ *         or NULL on libcurl failure.
+ */
+char *http_post_json(const char *url, const char *json_body, const char *extra_headers, long *out_http_code) {
+
+    http_request_t *request = http_request_create(url);
+    add_header_lines(request, extra_headers);
+    http_request_set_body(request, json_body ? json_body : "", "application/json");
+
+    return http_request_perform(request, out_http_code);
+}
+
+/**
+ * @brief Perform an HTTP GET request with optional headers.
+ *
+ * @param url           Target URL.
+ * @param extra_headers Optional additional headers, one per line (LF or CRLF).
+ * @param post_fields   Optional body. When given, the request is sent as a POST.
+ * @param out_http_code Optional output for HTTP status code.
+ * @return Response body allocated with bzalloc/brealloc (caller must bfree()),
+ *         or NULL on libcurl failure.
+ */
+char *http_get(const char *url, const char *extra_headers, const char *post_fields, long *out_http_code) {
+
+    http_request_t *request = http_request_create(url);
+    add_header_lines(request, extra_headers);
+    http_request_set_body(request, post_fields, NULL);
+
+    return http_request_perform(request, out_http_code);
+}
+
+/**
+ * @brief URL-encode a string (percent-encoding).
+ *
+ * Uses libcurl's escaping rules and returns a copy allocated with bstrdup.
+ *
+ * @param in Input string.
+ * @return Newly allocated encoded string (caller must bfree()), or NULL on error.
+ */
+char *http_urlencode(const char *in) {
+    if (!in)
+        return NULL;
+
+    CURL *curl = acquire_handle();
+
+    if (!curl)
+        return NULL;
 
     char *tmp = curl_easy_escape(curl, in, 0);
     char *out = tmp ? bstrdup(tmp) : NULL;
@@ -436,7 +1567,7 @@ char *http_urlencode(const char *in) {
     if (tmp)
         curl_free(tmp);
 
-    curl_easy_cleanup(curl);
+    release_handle(curl);
 
     return out;
 }
@@ -457,32 +1588,250 @@ bool http_download(const char *url, uint8_t **out_data, size_t *out_size) {
     *out_data = NULL;
     *out_size = 0;
 
-    CURL *curl = curl_easy_init();
+    CURL *curl = acquire_handle();
     if (!curl) {
         obs_log(LOG_ERROR, "Failed to init curl for download");
         return false;
     }
 
-    struct image_buffer buf = {0};
+    http_buffer_t buf;
+    http_buffer_init(&buf, true);
 
     curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curl_write_cb);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &buf);
+    set_response_buffer(curl, &buf);
     curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, DEFAULT_USER_AGENT);
+    make_interruptible(curl);
 
     CURLcode res = curl_easy_perform(curl);
-    curl_easy_cleanup(curl);
+    record_transfer(curl, buf.size);
+    release_handle(curl);
 
     if (res != CURLE_OK) {
         obs_log(LOG_ERROR, "Download failed: %s", curl_easy_strerror(res));
-        bfree(buf.data);
+        http_buffer_free(&buf);
+        return false;
+    }
+
+    *out_data = (uint8_t *)http_buffer_detach(&buf, out_size);
+
+    if (!*out_data) {
+        *out_size = 0;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Submit a request to the event loop.
+ */
+bool http_request_send_async(http_request_t *definition, http_completed_t on_completed, void *user_data) {
+
+    if (!definition) {
+        return false;
+    }
+
+    pthread_once(&g_loop_once, event_loop_init);
+
+    if (!g_loop.started) {
+        http_request_free(&definition);
+        return false;
+    }
+
+    http_async_request_t *request = bzalloc(sizeof(http_async_request_t));
+    request->definition           = definition;
+    request->on_completed         = on_completed;
+    request->user_data            = user_data;
+
+    /* Several requests are in flight on the loop thread: each owns its buffer */
+    http_buffer_init(&request->response, false);
+
+    pthread_mutex_lock(&g_loop.mutex);
+
+    bool running = g_loop.running;
+
+    if (running) {
+        request->next    = g_loop.submitted;
+        g_loop.submitted = request;
+    }
+
+    pthread_mutex_unlock(&g_loop.mutex);
+
+    if (!running) {
+        complete_request(request, 0, false);
         return false;
     }
 
-    *out_data = buf.data;
-    *out_size = buf.size;
+    curl_multi_wakeup(g_loop.multi);
 
     return true;
 }
+
+/**
+ * @brief Submit a request to the event loop and return a future to wait on.
+ */
+http_future_t *http_request_send(http_request_t *request) {
+
+    http_future_t *future = bzalloc(sizeof(http_future_t));
+
+    pthread_mutex_init(&future->mutex, NULL);
+    pthread_cond_init(&future->cond, NULL);
+
+    if (!http_request_send_async(request, on_future_completed, future)) {
+        /* Already completed (with a failure) or never submitted */
+        future->completed = true;
+    }
+
+    return future;
+}
+
+/**
+ * @brief Submit a request to the event loop.
+ *
+ * The request is copied; @p url, @p body and @p extra_headers may be released as
+ * soon as this returns.
+ */
+bool http_send_async(const char      *url,
+                     const char      *body,
+                     const char      *extra_headers,
+                     http_completed_t on_completed,
+                     void            *user_data) {
+
+    http_request_t *request = http_request_create(url);
+    add_header_lines(request, extra_headers);
+    http_request_set_body(request, body, NULL);
+
+    return http_request_send_async(request, on_completed, user_data);
+}
+
+/**
+ * @brief Submit a request to the event loop and return a future to wait on.
+ */
+http_future_t *http_send_future(const char *url, const char *body, const char *extra_headers) {
+
+    http_request_t *request = http_request_create(url);
+    add_header_lines(request, extra_headers);
+    http_request_set_body(request, body, NULL);
+
+    return http_request_send(request);
+}
+
+/**
+ * @brief Wait for a future to complete and release it, keeping the whole response.
+ */
+bool http_future_wait_response(http_future_t *future, http_response_t *out_response) {
+
+    if (!out_response)
+        return false;
+
+    memset(out_response, 0, sizeof(*out_response));
+
+    if (!future)
+        return false;
+
+    pthread_mutex_lock(&future->mutex);
+
+    while (!future->completed) {
+        pthread_cond_wait(&future->cond, &future->mutex);
+    }
+
+    pthread_mutex_unlock(&future->mutex);
+
+    out_response->http_code     = future->http_code;
+    out_response->body          = future->body;
+    out_response->body_size     = future->body ? strlen(future->body) : 0;
+    out_response->etag          = future->etag;
+    out_response->last_modified = future->last_modified;
+
+    pthread_cond_destroy(&future->cond);
+    pthread_mutex_destroy(&future->mutex);
+    bfree(future);
+
+    return out_response->body != NULL;
+}
+
+/**
+ * @brief Wait for a future to complete and release it.
+ */
+char *http_future_wait(http_future_t *future, long *out_http_code) {
+
+    http_response_t response;
+    http_future_wait_response(future, &response);
+
+    if (out_http_code)
+        *out_http_code = response.http_code;
+
+    bfree(response.etag);
+    bfree(response.last_modified);
+
+    return response.body;
+}
+
+void http_get_transfer_stats(http_transfer_stats_t *out_stats) {
+
+    if (!out_stats) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_stats_mutex);
+    *out_stats = g_stats;
+    pthread_mutex_unlock(&g_stats_mutex);
+}
+
+void http_interrupt_waits(void) {
+
+    pthread_once(&g_interrupted_once, interrupted_init);
+
+    if (g_interrupted) {
+        os_event_signal(g_interrupted);
+    }
+}
+
+void http_resume_waits(void) {
+
+    pthread_once(&g_interrupted_once, interrupted_init);
+
+    if (g_interrupted) {
+        os_event_reset(g_interrupted);
+    }
+}
+
+/**
+ * @brief Release the pooled handles, the shared caches and the thread arenas.
+ */
+void http_cleanup(void) {
+
+    /* Blocking requests waiting for their slot or retry give up right away */
+    http_interrupt_waits();
+
+    event_loop_stop();
+
+    http_transfer_stats_t stats;
+    http_get_transfer_stats(&stats);
+
+    obs_log(LOG_INFO,
+            "HTTP | %llu responses: %llu bytes received, %llu bytes once decompressed",
+            (unsigned long long)stats.responses,
+            (unsigned long long)stats.received_bytes,
+            (unsigned long long)stats.decoded_bytes);
+
+    http_timings_log();
+
+    pthread_once(&g_pool_once, pool_init);
+
+    pthread_mutex_lock(&g_pool.mutex);
+
+    while (g_pool.idle_count > 0) {
+        curl_easy_cleanup(g_pool.idle_handles[--g_pool.idle_count]);
+    }
+
+    pthread_mutex_unlock(&g_pool.mutex);
+
+    if (g_pool.share) {
+        curl_share_cleanup(g_pool.share);
+        g_pool.share = NULL;
+    }
+
+    /* The event-loop thread released its arena when it exited */
+    http_buffer_cleanup();
+}
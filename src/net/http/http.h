@@ -8,6 +8,221 @@
 extern "C" {
 #endif
 
+/**
+ * @file http.h
+ * @brief Blocking HTTP helpers built on libcurl.
+ *
+ * Connection reuse:
+ *  - Requests are performed with easy handles taken from a process-wide pool.
+ *    The handles share their DNS, connection and TLS session caches, so
+ *    consecutive requests to the same host reuse the existing connection.
+ *  - The helpers are safe to call concurrently from several threads.
+ *  - HTTP/2 is negotiated with the servers supporting it, HTTP/1.1 is used with
+ *    the others. Asynchronous requests in flight to the same origin are
+ *    multiplexed over a single connection.
+ *
+ * Request builder:
+ *  - http_request_create() and its companions build a request from typed
+ *    header name/value pairs. Headers sent with many requests (authorization,
+ *    contract version...) can be built once as an http_headers_t and attached
+ *    to each request without being copied or parsed again.
+ *  - Every request, whichever function sends it, goes through the same code
+ *    path: http_request_perform() on the calling thread, or the event loop for
+ *    http_request_send() and http_request_send_async().
+ *
+ * Throttling:
+ *  - Requests to a host are paced by a token bucket (see http_throttle.h): a
+ *    burst goes through, the requests beyond it wait for their slot.
+ *  - Responses 429 and 503 are retried after their Retry-After delay, or after
+ *    a jittered, exponentially growing one, up to a few attempts; GETs are also
+ *    retried after a transport failure other than a timeout. The attempts of a
+ *    request, with the delays between them, fit in 45 seconds. A Retry-After
+ *    delay holds back every request to the host, and the limits reported in a
+ *    429 body tune its bucket.
+ *  - An asynchronous GET identical (same URL and headers) to one still pending
+ *    is not sent: it completes with a copy of the pending one's response.
+ *  - http_download() is not throttled: the images come from CDNs.
+ *
+ * Compression:
+ *  - Every request offers the encodings libcurl supports (gzip, deflate,
+ *    brotli...). Response bodies are decompressed as they arrive; callers always
+ *    get the decoded body. See http_get_transfer_stats() for the savings.
+ *
+ * Timings:
+ *  - The phases of every transfer (DNS, connect, TLS, first byte, total) and
+ *    its sizes are aggregated per host; see http_timings.h to query, log or
+ *    display them.
+ *
+ * Asynchronous requests:
+ *  - http_send_async() and http_send_future() hand the request to a single
+ *    event-loop thread driving a curl_multi handle, so several requests can be
+ *    in flight at the same time without blocking the caller.
+ */
+
+/**
+ * @brief Outcome of an asynchronous request.
+ */
+typedef struct http_response {
+    /** HTTP status code, or 0 if the transfer failed */
+    long http_code;
+
+    /**
+     * NUL-terminated response body, or NULL if the transfer failed.
+     *
+     * Owned by the HTTP layer and freed once the completion callback returns.
+     * A callback may keep it by setting this member to NULL; it must then free
+     * it with bfree().
+     */
+    char *body;
+
+    /** Length of @c body in bytes */
+    size_t body_size;
+
+    /**
+     * Value of the ETag response header, or NULL if absent.
+     *
+     * Same ownership as @c body.
+     */
+    char *etag;
+
+    /**
+     * Value of the Last-Modified response header, or NULL if absent.
+     *
+     * Same ownership as @c body.
+     */
+    char *last_modified;
+} http_response_t;
+
+/**
+ * @brief Request being built (opaque).
+ */
+typedef struct http_request http_request_t;
+
+/**
+ * @brief Reference-counted list of header lines shared by several requests (opaque).
+ */
+typedef struct http_headers http_headers_t;
+
+/**
+ * @brief Totals of the response bodies received.
+ */
+typedef struct http_transfer_stats {
+    /** Number of completed transfers */
+    uint64_t responses;
+
+    /** Bytes of response bodies as received on the wire (compressed or not) */
+    uint64_t received_bytes;
+
+    /** Bytes of response bodies once decompressed */
+    uint64_t decoded_bytes;
+} http_transfer_stats_t;
+
+/**
+ * @brief Completion callback of an asynchronous request.
+ *
+ * Invoked exactly once, from the HTTP event-loop thread. It must not block:
+ * other transfers are not serviced while it runs.
+ *
+ * @param response  Outcome of the request.
+ * @param user_data Pointer given when the request was submitted.
+ */
+typedef void (*http_completed_t)(http_response_t *response, void *user_data);
+
+/**
+ * @brief Handle on an asynchronous request that a thread can wait for.
+ */
+typedef struct http_future http_future_t;
+
+/**
+ * @brief Create an empty list of shared header lines.
+ *
+ * Add the lines with http_headers_add() before attaching the list to a request:
+ * a list must not be modified once a request uses it.
+ *
+ * @return New list holding one reference (release it with http_headers_release()).
+ */
+http_headers_t *http_headers_create(void);
+
+/**
+ * @brief Add a header line to a shared list.
+ *
+ * @param headers List to add the line to.
+ * @param name    Header name (e.g. "Authorization").
+ * @param value   Header value.
+ * @return true on success.
+ */
+bool http_headers_add(http_headers_t *headers, const char *name, const char *value);
+
+/**
+ * @brief Release a reference on a shared list and set the caller's pointer to NULL.
+ *
+ * The list is freed once the last request using it has completed.
+ *
+ * @param headers Address of the list (may be NULL or point to NULL).
+ */
+void http_headers_release(http_headers_t **headers);
+
+/**
+ * @brief Create a request.
+ *
+ * The request is a GET, or a POST once it is given a body.
+ *
+ * @param url Target URL (copied).
+ * @return New request, or NULL if @p url is NULL. It is freed by the function
+ *         sending it, or with http_request_free() if it is never sent.
+ */
+http_request_t *http_request_create(const char *url);
+
+/**
+ * @brief Add a header to a request.
+ *
+ * @param request Request to add the header to.
+ * @param name    Header name (e.g. "Accept-Language").
+ * @param value   Header value. An empty value stops libcurl from sending its own
+ *                header of that name.
+ * @return true on success.
+ */
+bool http_request_add_header(http_request_t *request, const char *name, const char *value);
+
+/**
+ * @brief Send shared header lines with a request, after its own headers.
+ *
+ * The request holds a reference on @p headers until it is freed.
+ *
+ * @param request Request to attach the lines to.
+ * @param headers Shared lines (NULL detaches the current ones).
+ */
+void http_request_use_headers(http_request_t *request, http_headers_t *headers);
+
+/**
+ * @brief Set the body of a request, making it a POST.
+ *
+ * @param request      Request to set the body of.
+ * @param body         Body (copied). NULL leaves the request unchanged.
+ * @param content_type Value of the Content-Type header (may be NULL).
+ */
+void http_request_set_body(http_request_t *request, const char *body, const char *content_type);
+
+/**
+ * @brief Free a request that was not sent and set the caller's pointer to NULL.
+ *
+ * @param request Address of the request (may be NULL or point to NULL).
+ */
+void http_request_free(http_request_t **request);
+
+/**
+ * @brief Send a request and wait for its response on the calling thread.
+ *
+ * Blocks while the request waits for its throttling slot, is transferred and
+ * between retries, for 45 seconds at most in total. The waits and the transfer
+ * end early, failing the request, once http_interrupt_waits() is called.
+ *
+ * @param request       Request to send (freed by this function; may be NULL).
+ * @param out_http_code Optional output for HTTP status code.
+ * @return Response body (caller must bfree()), or NULL on libcurl failure.
+ */
+char *http_request_perform(http_request_t *request, long *out_http_code);
+
 /**
  * @brief POST application/x-www-form-urlencoded data.
  *
@@ -89,6 +304,123 @@ bool http_download(const char *url, uint8_t **out_data, size_t *out_size);
  */
 char *http_urlencode(const char *in);
 
+/**
+ * @brief Submit a request without waiting for its completion.
+ *
+ * @param request      Request to send (freed by this function; may be NULL).
+ * @param on_completed Callback invoked when the request completes (may be NULL).
+ * @param user_data    Opaque pointer passed to @p on_completed.
+ *
+ * @return true if the request was submitted. When false is returned,
+ *         @p on_completed may already have been invoked with a failure.
+ */
+bool http_request_send_async(http_request_t *request, http_completed_t on_completed, void *user_data);
+
+/**
+ * @brief Submit a request and get a future to wait for its result.
+ *
+ * @param request Request to send (freed by this function; may be NULL).
+ *
+ * @return Future that must be passed to http_future_wait() or
+ *         http_future_wait_response() exactly once.
+ */
+http_future_t *http_request_send(http_request_t *request);
+
+/**
+ * @brief Submit a request without waiting for its completion.
+ *
+ * The request is a GET, or a POST when @p body is non-NULL. All the arguments
+ * are copied.
+ *
+ * @param url           Target URL.
+ * @param body          Optional POST body.
+ * @param extra_headers Optional additional headers, one per line (LF or CRLF).
+ * @param on_completed  Callback invoked when the request completes (may be NULL).
+ * @param user_data     Opaque pointer passed to @p on_completed.
+ *
+ * @return true if the request was submitted. When false is returned,
+ *         @p on_completed may already have been invoked with a failure.
+ */
+bool http_send_async(const char      *url,
+                     const char      *body,
+                     const char      *extra_headers,
+                     http_completed_t on_completed,
+                     void            *user_data);
+
+/**
+ * @brief Submit a request and get a future to wait for its result.
+ *
+ * Lets a thread start several requests and then wait for all of them, so the
+ * total time is the one of the slowest request instead of the sum of all.
+ *
+ * @param url           Target URL.
+ * @param body          Optional POST body (NULL for a GET).
+ * @param extra_headers Optional additional headers, one per line (LF or CRLF).
+ *
+ * @return Future that must be passed to http_future_wait() or
+ *         http_future_wait_response() exactly once.
+ */
+http_future_t *http_send_future(const char *url, const char *body, const char *extra_headers);
+
+/**
+ * @brief Wait for a request started with http_send_future() and release the future.
+ *
+ * @param future        Future to wait for (may be NULL).
+ * @param out_http_code Optional output for HTTP status code (0 on failure).
+ *
+ * @return Response body (caller must bfree()), or NULL on failure.
+ */
+char *http_future_wait(http_future_t *future, long *out_http_code);
+
+/**
+ * @brief Wait for a request started with http_send_future() and release the future.
+ *
+ * Unlike http_future_wait(), also gives the cache validators of the response, so
+ * the caller can later revalidate the resource with a conditional request.
+ *
+ * @param future       Future to wait for (may be NULL).
+ * @param out_response Receives the outcome. The caller owns @c body, @c etag and
+ *                     @c last_modified and must free them with bfree().
+ *
+ * @return true if a response was received, whatever its status code.
+ */
+bool http_future_wait_response(http_future_t *future, http_response_t *out_response);
+
+/**
+ * @brief Get the totals of the response bodies received since the module was loaded.
+ *
+ * The difference between @c decoded_bytes and @c received_bytes is the amount of
+ * data saved by the compression.
+ *
+ * @param out_stats Receives the totals.
+ */
+void http_get_transfer_stats(http_transfer_stats_t *out_stats);
+
+/**
+ * @brief Interrupt the blocking requests waiting for their throttling slot or a retry.
+ *
+ * The waiting requests give up right away, and so do the ones that would have to
+ * wait later on, until http_resume_waits() is called. The transfers of the
+ * blocking requests and downloads in flight are aborted as well. Lets a thread
+ * performing blocking requests be stopped promptly.
+ */
+void http_interrupt_waits(void);
+
+/**
+ * @brief Let the blocking requests wait for their throttling slot and retries again.
+ */
+void http_resume_waits(void);
+
+/**
+ * @brief Release the pooled connections and shared caches.
+ *
+ * Stops the event-loop thread (pending asynchronous requests complete with a
+ * failure) and releases the response buffers kept by the threads (see
+ * http_buffer_cleanup()). Must be called once no blocking request is in flight
+ * anymore, typically when the module is unloaded.
+ */
+void http_cleanup(void);
+
 #ifdef __cplusplus
 }
 #endif
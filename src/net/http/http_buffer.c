@@ -0,0 +1,378 @@
+#include "net/http/http_buffer.h"
+
+#include <util/bmem.h>
+
+#include <ctype.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+/** Smallest capacity allocated for a non-empty buffer */
+#define MIN_CAPACITY 1024
+
+/** Bodies larger than this are handed out in the arena storage itself rather than copied */
+#define MAX_COPIED_SIZE (16 * 1024)
+
+/** Arenas grown beyond this size are released instead of being kept for the next request */
+#define MAX_RETAINED_ARENA_CAPACITY (4 * 1024 * 1024)
+
+/**
+ * @brief Scratch area owned by a thread and lent to one buffer at a time.
+ */
+typedef struct thread_arena {
+    char  *data;
+    size_t capacity;
+    bool   in_use;
+} thread_arena_t;
+
+static pthread_key_t  g_arena_key;
+static pthread_once_t g_arena_once = PTHREAD_ONCE_INIT;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+static void free_arena(void *value) {
+
+    thread_arena_t *arena = value;
+
+    if (!arena) {
+        return;
+    }
+
+    bfree(arena->data);
+    bfree(arena);
+}
+
+static void arena_key_init(void) {
+    pthread_key_create(&g_arena_key, free_arena);
+}
+
+/**
+ * @brief Borrow the arena of the calling thread.
+ *
+ * @return The arena, or NULL if it is already lent to another buffer.
+ */
+static thread_arena_t *borrow_arena(void) {
+
+    pthread_once(&g_arena_once, arena_key_init);
+
+    thread_arena_t *arena = pthread_getspecific(g_arena_key);
+
+    if (!arena) {
+        arena = bzalloc(sizeof(thread_arena_t));
+
+        if (!arena) {
+            return NULL;
+        }
+
+        pthread_setspecific(g_arena_key, arena);
+    }
+
+    if (arena->in_use) {
+        return NULL;
+    }
+
+    arena->in_use = true;
+
+    return arena;
+}
+
+/**
+ * @brief Give the arena back to its thread, trimming it if a large body made it grow too much.
+ */
+static void return_arena(http_buffer_t *buffer) {
+
+    thread_arena_t *arena = buffer->arena;
+
+    /* The arena may have been reallocated while it was borrowed */
+    arena->data     = buffer->data;
+    arena->capacity = buffer->capacity;
+    arena->in_use   = false;
+
+    if (arena->capacity > MAX_RETAINED_ARENA_CAPACITY) {
+        bfree(arena->data);
+        arena->data     = NULL;
+        arena->capacity = 0;
+    }
+
+    buffer->arena    = NULL;
+    buffer->data     = NULL;
+    buffer->size     = 0;
+    buffer->capacity = 0;
+}
+
+/**
+ * @brief Compute the capacity to grow to so that @p needed bytes fit.
+ *
+ * The capacity at least doubles so that appending n bytes in small chunks only
+ * triggers O(log n) reallocations.
+ */
+static size_t next_capacity(size_t capacity, size_t needed) {
+
+    size_t doubled = capacity > SIZE_MAX / 2 ? SIZE_MAX - 1 : capacity * 2;
+    size_t grown   = doubled > needed ? doubled : needed;
+
+    return grown < MIN_CAPACITY ? MIN_CAPACITY : grown;
+}
+
+static bool grow(http_buffer_t *buffer, size_t capacity) {
+
+    /* One extra byte for the NUL terminator */
+    char *data = brealloc(buffer->data, capacity + 1);
+
+    if (!data) {
+        return false;
+    }
+
+    buffer->data     = data;
+    buffer->capacity = capacity;
+
+    return true;
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+void http_buffer_init(http_buffer_t *buffer, bool use_thread_arena) {
+
+    if (!buffer) {
+        return;
+    }
+
+    memset(buffer, 0, sizeof(*buffer));
+
+    if (!use_thread_arena) {
+        return;
+    }
+
+    thread_arena_t *arena = borrow_arena();
+
+    if (!arena) {
+        return;
+    }
+
+    buffer->arena    = arena;
+    buffer->data     = arena->data;
+    buffer->capacity = arena->capacity;
+
+    if (buffer->data) {
+        buffer->data[0] = '\0';
+    }
+}
+
+bool http_buffer_reserve(http_buffer_t *buffer, size_t capacity) {
+
+    if (!buffer) {
+        return false;
+    }
+
+    if (capacity <= buffer->capacity && buffer->data) {
+        return true;
+    }
+
+    if (capacity >= SIZE_MAX) {
+        return false;
+    }
+
+    if (buffer->arena && buffer->size == 0) {
+        /* The final size is known: owning an exact-size block avoids the copy made when detaching from the arena */
+        return_arena(buffer);
+    }
+
+    if (!grow(buffer, capacity)) {
+        return false;
+    }
+
+    buffer->data[buffer->size] = '\0';
+
+    return true;
+}
+
+bool http_buffer_append(http_buffer_t *buffer, const void *data, size_t size) {
+
+    if (!buffer || (!data && size > 0)) {
+        return false;
+    }
+
+    if (size > SIZE_MAX - 1 - buffer->size) {
+        return false;
+    }
+
+    size_t needed = buffer->size + size;
+
+    if (needed > buffer->capacity || !buffer->data) {
+        if (!grow(buffer, next_capacity(buffer->capacity, needed))) {
+            return false;
+        }
+    }
+
+    if (size > 0) {
+        memcpy(buffer->data + buffer->size, data, size);
+    }
+
+    buffer->size               = needed;
+    buffer->data[buffer->size] = '\0';
+
+    return true;
+}
+
+char *http_buffer_detach(http_buffer_t *buffer, size_t *out_size) {
+
+    if (out_size) {
+        *out_size = 0;
+    }
+
+    if (!buffer) {
+        return NULL;
+    }
+
+    size_t size = buffer->size;
+    char  *data = NULL;
+
+    if (buffer->arena && size > MAX_COPIED_SIZE) {
+        /* Copying would cost more than regrowing the arena later: give its storage away */
+        thread_arena_t *arena = buffer->arena;
+
+        data            = buffer->data;
+        arena->data     = NULL;
+        arena->capacity = 0;
+        arena->in_use   = false;
+
+        buffer->arena    = NULL;
+        buffer->data     = NULL;
+        buffer->size     = 0;
+        buffer->capacity = 0;
+    } else if (buffer->arena) {
+        /* The arena stays with the thread: hand out an exact-size copy */
+        data = bmalloc(size + 1);
+
+        if (!data) {
+            return NULL;
+        }
+
+        if (size > 0) {
+            memcpy(data, buffer->data, size);
+        }
+
+        data[size] = '\0';
+
+        return_arena(buffer);
+    } else {
+        data = buffer->data ? buffer->data : bzalloc(1);
+
+        buffer->data     = NULL;
+        buffer->size     = 0;
+        buffer->capacity = 0;
+    }
+
+    if (out_size) {
+        *out_size = size;
+    }
+
+    return data;
+}
+
+void http_buffer_free(http_buffer_t *buffer) {
+
+    if (!buffer) {
+        return;
+    }
+
+    if (buffer->arena) {
+        return_arena(buffer);
+        return;
+    }
+
+    bfree(buffer->data);
+
+    buffer->data     = NULL;
+    buffer->size     = 0;
+    buffer->capacity = 0;
+}
+
+void http_buffer_cleanup(void) {
+
+    pthread_once(&g_arena_once, arena_key_init);
+
+    free_arena(pthread_getspecific(g_arena_key));
+    pthread_setspecific(g_arena_key, NULL);
+
+    pthread_key_delete(g_arena_key);
+}
+
+bool http_buffer_parse_header(const char  *line,
+                              size_t       length,
+                              const char  *name,
+                              const char **out_value,
+                              size_t      *out_value_length) {
+
+    if (!line || !name || !out_value || !out_value_length) {
+        return false;
+    }
+
+    size_t name_length = strlen(name);
+
+    if (length <= name_length || line[name_length] != ':') {
+        return false;
+    }
+
+    for (size_t i = 0; i < name_length; i++) {
+        if (tolower((unsigned char)line[i]) != tolower((unsigned char)name[i])) {
+            return false;
+        }
+    }
+
+    size_t start = name_length + 1;
+    size_t end   = length;
+
+    while (start < end && (line[start] == ' ' || line[start] == '\t')) {
+        start++;
+    }
+
+    while (end > start && (line[end - 1] == ' ' || line[end - 1] == '\t' || line[end - 1] == '\r' ||
+                           line[end - 1] == '\n')) {
+        end--;
+    }
+
+    *out_value        = line + start;
+    *out_value_length = end - start;
+
+    return true;
+}
+
+bool http_buffer_parse_content_length(const char *line, size_t length, size_t *out_content_length) {
+
+    const char *value        = NULL;
+    size_t      value_length = 0;
+
+    if (!out_content_length || !http_buffer_parse_header(line, length, "content-length", &value, &value_length)) {
+        return false;
+    }
+
+    if (value_length == 0) {
+        return false;
+    }
+
+    size_t content_length = 0;
+
+    for (size_t i = 0; i < value_length; i++) {
+
+        if (!isdigit((unsigned char)value[i])) {
+            return false;
+        }
+
+        size_t digit = (size_t)(value[i] - '0');
+
+        if (content_length > (SIZE_MAX - digit) / 10) {
+            return false;
+        }
+
+        content_length = content_length * 10 + digit;
+    }
+
+    *out_content_length = content_length;
+
+    return true;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file http_buffer.h
+ * @brief Growable response buffer used by the HTTP layer.
+ *
+ * The buffer grows geometrically (its capacity doubles) so receiving a body in
+ * many small chunks costs a logarithmic number of reallocations. When the size
+ * of the body is known upfront (Content-Length), the buffer can be presized
+ * with http_buffer_reserve() and then never reallocates.
+ *
+ * Thread arena:
+ *  - A buffer initialized with @c use_thread_arena borrows a scratch area owned
+ *    by the calling thread instead of allocating its own storage. The scratch
+ *    area keeps its capacity between requests, so in steady state receiving a
+ *    small response costs a single exact-size allocation (in
+ *    http_buffer_detach()). Large bodies are handed out in the arena storage
+ *    itself, since copying them would cost more than regrowing the arena.
+ *  - Only one buffer per thread can borrow the arena at a time; additional
+ *    buffers silently fall back to their own storage.
+ *  - The arena only pays off when the size of the body is unknown (chunked
+ *    transfers): reserving space in an empty buffer gives the arena back and
+ *    allocates an exact-size block instead, which is then detached without a
+ *    copy.
+ *
+ * The content is always kept NUL-terminated so text bodies can be used as C
+ * strings.
+ */
+
+/**
+ * @brief Growable, NUL-terminated byte buffer.
+ */
+typedef struct http_buffer {
+    /** Content (NUL-terminated), or NULL while nothing has been allocated */
+    char *data;
+
+    /** Number of bytes stored in @c data, excluding the terminator */
+    size_t size;
+
+    /** Number of bytes @c data can hold, excluding the terminator */
+    size_t capacity;
+
+    /** Thread arena @c data is borrowed from, or NULL if @c data is owned */
+    void *arena;
+} http_buffer_t;
+
+/**
+ * @brief Initialize an empty buffer.
+ *
+ * @param buffer           Buffer to initialize.
+ * @param use_thread_arena True to borrow the calling thread's scratch area. The
+ *                         buffer must then be detached or freed on that thread.
+ */
+void http_buffer_init(http_buffer_t *buffer, bool use_thread_arena);
+
+/**
+ * @brief Make sure the buffer can hold at least @p capacity bytes.
+ *
+ * If the buffer is still empty and borrows the thread arena, the arena is given
+ * back and the buffer allocates its own storage.
+ *
+ * @return false if the allocation failed.
+ */
+bool http_buffer_reserve(http_buffer_t *buffer, size_t capacity);
+
+/**
+ * @brief Append bytes at the end of the buffer, growing it if needed.
+ *
+ * @return false if the allocation failed (the buffer is left unchanged).
+ */
+bool http_buffer_append(http_buffer_t *buffer, const void *data, size_t size);
+
+/**
+ * @brief Take the content out of the buffer.
+ *
+ * The buffer is left empty and can be reused or freed.
+ *
+ * @param buffer   Buffer to detach the content from.
+ * @param out_size Optional output for the number of bytes (excluding the terminator).
+ *
+ * @return NUL-terminated content (an empty string if nothing was appended). The
+ *         caller owns it and must free it with bfree().
+ */
+char *http_buffer_detach(http_buffer_t *buffer, size_t *out_size);
+
+/**
+ * @brief Release the content of the buffer.
+ *
+ * Safe to call on an initialized buffer whose content has been detached.
+ */
+void http_buffer_free(http_buffer_t *buffer);
+
+/**
+ * @brief Release the thread arena of the calling thread and the key of the thread arenas.
+ *
+ * The arenas of the threads that already exited were released with them; the
+ * key is deleted so no destructor is left pointing into the module once it is
+ * unloaded. Must be called once no buffer borrows an arena anymore, and no
+ * buffer may borrow one afterwards.
+ */
+void http_buffer_cleanup(void);
+
+/**
+ * @brief Extract the value of a response header line.
+ *
+ * The header name is matched case-insensitively. Surrounding whitespace and the
+ * line terminator are not part of the value.
+ *
+ * @param line             Header line as delivered by libcurl (not NUL-terminated).
+ * @param length           Length of @p line in bytes.
+ * @param name             Header name, without the colon (e.g. "ETag").
+ * @param out_value        Receives a pointer to the value, inside @p line.
+ * @param out_value_length Receives the length of the value in bytes.
+ *
+ * @return true if @p line is a @p name header.
+ */
+bool http_buffer_parse_header(const char  *line,
+                              size_t       length,
+                              const char  *name,
+                              const char **out_value,
+                              size_t      *out_value_length);
+
+/**
+ * @brief Parse the value of a "Content-Length" response header line.
+ *
+ * @param line   Header line as delivered by libcurl (not NUL-terminated).
+ * @param length Length of @p line in bytes.
+ * @param out_content_length Receives the parsed value.
+ *
+ * @return true if @p line is a valid Content-Length header.
+ */
+bool http_buffer_parse_content_length(const char *line, size_t length, size_t *out_content_length);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,247 @@
+#include "net/http/http_throttle.h"
+#include "net/http/http_url.h"
+
+#include <cJSON.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+/** Size of the host name buffer, including the terminator */
+#define HOST_SIZE 128
+
+/** Bucket shared by the requests to the hosts that do not fit in the table */
+#define OTHER_HOST "other"
+
+/** Tokens a new bucket gains per millisecond */
+#define DEFAULT_REFILL_PER_MS \
+    ((double)HTTP_THROTTLE_DEFAULT_MAX_REQUESTS / (HTTP_THROTTLE_DEFAULT_PERIOD_SECONDS * 1000.0))
+
+/** Delay before the first retry, in milliseconds */
+#define BACKOFF_BASE_MS 500
+
+/** Longest delay between two retries, in milliseconds */
+#define BACKOFF_MAX_MS (30 * 1000)
+
+/**
+ * @brief Token bucket of a host.
+ */
+typedef struct throttle_bucket {
+    char host[HOST_SIZE];
+
+    /** Tokens available; negative when requests are waiting for tokens to come */
+    double tokens;
+
+    /** Maximum number of tokens (size of a burst) */
+    double capacity;
+
+    /** Tokens added per millisecond */
+    double refill_per_ms;
+
+    /** Time the tokens were last refilled */
+    int64_t refilled_ms;
+
+    /** Time before which no request may be sent (Retry-After) */
+    int64_t blocked_until_ms;
+} throttle_bucket_t;
+
+static throttle_bucket_t g_buckets[HTTP_THROTTLE_MAX_HOSTS];
+static size_t            g_bucket_count;
+static pthread_mutex_t   g_throttle_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Find the bucket of the host of a URL, adding it if needed.
+ *
+ * A new bucket starts full, with the default limit. Must be called with the
+ * mutex held.
+ */
+static throttle_bucket_t *find_or_add_bucket(const char *url, int64_t now_ms) {
+
+    char host[HOST_SIZE];
+    http_url_get_host(url, host, sizeof(host));
+
+    for (size_t i = 0; i < g_bucket_count; i++) {
+        if (strcmp(g_buckets[i].host, host) == 0) {
+            return &g_buckets[i];
+        }
+    }
+
+    /* The last slot is kept for the hosts that do not fit */
+    if (g_bucket_count >= HTTP_THROTTLE_MAX_HOSTS - 1) {
+        snprintf(host, sizeof(host), "%s", OTHER_HOST);
+
+        if (g_bucket_count == HTTP_THROTTLE_MAX_HOSTS) {
+            return &g_buckets[HTTP_THROTTLE_MAX_HOSTS - 1];
+        }
+    }
+
+    throttle_bucket_t *bucket = &g_buckets[g_bucket_count++];
+
+    memset(bucket, 0, sizeof(*bucket));
+    snprintf(bucket->host, sizeof(bucket->host), "%s", host);
+
+    bucket->capacity      = HTTP_THROTTLE_DEFAULT_MAX_REQUESTS;
+    bucket->tokens        = bucket->capacity;
+    bucket->refill_per_ms = DEFAULT_REFILL_PER_MS;
+    bucket->refilled_ms   = now_ms;
+
+    return bucket;
+}
+
+/**
+ * @brief Read a number node that is at least 1.
+ *
+ * @return The value, or 0 if @p node is not such a number.
+ */
+static uint32_t get_positive_number(const cJSON *node) {
+
+    if (!node || (node->type & 0xFF) != cJSON_Number || node->valuedouble < 1.0) {
+        return 0;
+    }
+
+    return node->valuedouble > (double)UINT32_MAX ? UINT32_MAX : (uint32_t)node->valuedouble;
+}
+
+/**
+ * @brief Add the tokens accumulated since the last refill.
+ */
+static void refill(throttle_bucket_t *bucket, int64_t now_ms) {
+
+    if (now_ms <= bucket->refilled_ms) {
+        return;
+    }
+
+    bucket->tokens += (double)(now_ms - bucket->refilled_ms) * bucket->refill_per_ms;
+    bucket->refilled_ms = now_ms;
+
+    if (bucket->tokens > bucket->capacity) {
+        bucket->tokens = bucket->capacity;
+    }
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+int64_t http_throttle_reserve(const char *url, int64_t now_ms) {
+
+    int64_t delay_ms = 0;
+
+    pthread_mutex_lock(&g_throttle_mutex);
+
+    throttle_bucket_t *bucket = find_or_add_bucket(url, now_ms);
+
+    refill(bucket, now_ms);
+
+    bucket->tokens -= 1.0;
+
+    if (bucket->tokens < 0.0) {
+        /* Rounds up so the token has been earned by the time the request is sent */
+        double wait_ms = -bucket->tokens / bucket->refill_per_ms;
+        delay_ms       = (int64_t)wait_ms;
+
+        if ((double)delay_ms < wait_ms) {
+            delay_ms++;
+        }
+    }
+
+    if (bucket->blocked_until_ms - now_ms > delay_ms) {
+        delay_ms = bucket->blocked_until_ms - now_ms;
+    }
+
+    pthread_mutex_unlock(&g_throttle_mutex);
+
+    return delay_ms;
+}
+
+void http_throttle_defer(const char *url, int64_t until_ms) {
+
+    pthread_mutex_lock(&g_throttle_mutex);
+
+    throttle_bucket_t *bucket = find_or_add_bucket(url, until_ms);
+
+    if (until_ms > bucket->blocked_until_ms) {
+        bucket->blocked_until_ms = until_ms;
+    }
+
+    pthread_mutex_unlock(&g_throttle_mutex);
+}
+
+void http_throttle_set_limit(const char *url, uint32_t max_requests, uint32_t period_seconds) {
+
+    if (max_requests == 0 || period_seconds == 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_throttle_mutex);
+
+    throttle_bucket_t *bucket = find_or_add_bucket(url, 0);
+
+    bucket->capacity      = (double)max_requests;
+    bucket->refill_per_ms = (double)max_requests / ((double)period_seconds * 1000.0);
+
+    if (bucket->tokens > bucket->capacity) {
+        bucket->tokens = bucket->capacity;
+    }
+
+    pthread_mutex_unlock(&g_throttle_mutex);
+}
+
+bool http_throttle_parse_limit(const char *body, uint32_t *out_max_requests, uint32_t *out_period_seconds) {
+
+    bool found = false;
+
+    if (!body || !out_max_requests || !out_period_seconds) {
+        return false;
+    }
+
+    cJSON *root = cJSON_Parse(body);
+
+    if (!root) {
+        return false;
+    }
+
+    uint32_t max_requests = get_positive_number(cJSON_GetObjectItemCaseSensitive(root, "maxRequests"));
+    uint32_t period       = get_positive_number(cJSON_GetObjectItemCaseSensitive(root, "periodInSeconds"));
+
+    if (max_requests > 0 && period > 0) {
+        *out_max_requests   = max_requests;
+        *out_period_seconds = period;
+        found               = true;
+    }
+
+    cJSON_Delete(root);
+
+    return found;
+}
+
+int64_t http_throttle_backoff_ms(uint32_t attempt, uint32_t random) {
+
+    int64_t delay_ms = BACKOFF_BASE_MS;
+
+    for (uint32_t i = 1; i < attempt && delay_ms < BACKOFF_MAX_MS; i++) {
+        delay_ms *= 2;
+    }
+
+    if (delay_ms > BACKOFF_MAX_MS) {
+        delay_ms = BACKOFF_MAX_MS;
+    }
+
+    int64_t half = delay_ms / 2;
+
+    return half + (int64_t)(random % (uint32_t)(half + 1));
+}
+
+void http_throttle_reset(void) {
+
+    pthread_mutex_lock(&g_throttle_mutex);
+
+    memset(g_buckets, 0, sizeof(g_buckets));
+    g_bucket_count = 0;
+
+    pthread_mutex_unlock(&g_throttle_mutex);
+}
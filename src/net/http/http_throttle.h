@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file http_throttle.h
+ * @brief Per-host request rate limiting and retry pacing.
+ *
+ * Xbox Live throttles the clients sending bursts of requests (for instance
+ * when games are switched rapidly) and answers 429 Too Many Requests for a
+ * while. Each host therefore gets a token bucket: a burst of requests goes
+ * through, then the requests are spaced at the refill rate instead of being
+ * rejected by the service.
+ *
+ * A bucket can be put in debt: http_throttle_reserve() always takes a token and
+ * returns how long the request must wait for it, so queued requests are spread
+ * out in the order they were reserved.
+ *
+ * When the service throttles anyway, its Retry-After delay blocks the whole host
+ * (http_throttle_defer()) and the limits it reports tune the bucket
+ * (http_throttle_set_limit()).
+ *
+ * Times are milliseconds on a monotonic clock chosen by the caller. The
+ * functions are thread-safe.
+ */
+
+/** Requests a host accepts in a burst before they are spaced out */
+#define HTTP_THROTTLE_DEFAULT_MAX_REQUESTS 10
+
+/** Period over which the burst is replenished, in seconds */
+#define HTTP_THROTTLE_DEFAULT_PERIOD_SECONDS 15
+
+/** Number of hosts tracked; the requests to any additional host share one bucket */
+#define HTTP_THROTTLE_MAX_HOSTS 32
+
+/**
+ * @brief Reserves the next request slot of the host of a URL.
+ *
+ * @param url    URL of the request.
+ * @param now_ms Current time.
+ *
+ * @return Number of milliseconds to wait before sending the request (0 to send
+ *         it right away).
+ */
+int64_t http_throttle_reserve(const char *url, int64_t now_ms);
+
+/**
+ * @brief Blocks the requests to the host of a URL until a given time.
+ *
+ * Used when the service asked to retry later (Retry-After).
+ *
+ * @param url      URL of the throttled request.
+ * @param until_ms Time before which no request may be sent to the host.
+ */
+void http_throttle_defer(const char *url, int64_t until_ms);
+
+/**
+ * @brief Sets the rate at which the host of a URL accepts requests.
+ *
+ * @param url            URL of a request to the host.
+ * @param max_requests   Requests accepted per period (0 is ignored).
+ * @param period_seconds Length of the period (0 is ignored).
+ */
+void http_throttle_set_limit(const char *url, uint32_t max_requests, uint32_t period_seconds);
+
+/**
+ * @brief Reads the limits reported in the body of an Xbox Live 429 response.
+ *
+ * The body looks like {"limitType":"Rate","maxRequests":10,"periodInSeconds":15,...}.
+ *
+ * @param body               Response body (may be NULL).
+ * @param out_max_requests   Receives the requests accepted per period.
+ * @param out_period_seconds Receives the length of the period.
+ *
+ * @return true if both limits were found.
+ */
+bool http_throttle_parse_limit(const char *body, uint32_t *out_max_requests, uint32_t *out_period_seconds);
+
+/**
+ * @brief Computes the delay before retrying a request, with jitter.
+ *
+ * The delay doubles with every attempt, up to a cap. Half of it is random so
+ * the clients throttled at the same time do not retry at the same time.
+ *
+ * @param attempt Number of attempts already made (1 for the first retry).
+ * @param random  Random value picking the jitter.
+ *
+ * @return Delay in milliseconds.
+ */
+int64_t http_throttle_backoff_ms(uint32_t attempt, uint32_t random);
+
+/**
+ * @brief Forgets the state of every host.
+ */
+void http_throttle_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
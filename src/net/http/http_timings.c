@@ -0,0 +1,232 @@
+#include "net/http/http_timings.h"
+#include "net/http/http_url.h"
+
+#include <diagnostics/log.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+/** Endpoint collecting the transfers once every other slot is taken */
+#define OTHER_HOST "other"
+
+static http_endpoint_timings_t g_endpoints[HTTP_TIMINGS_MAX_ENDPOINTS];
+static size_t                  g_endpoint_count;
+static pthread_mutex_t         g_timings_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Index of the histogram bucket counting a total time.
+ */
+static size_t get_bucket(int64_t total_us) {
+
+    int64_t milliseconds = total_us / 1000;
+    size_t  bucket       = 0;
+
+    while (milliseconds > 0 && bucket < HTTP_TIMINGS_BUCKETS - 1) {
+        milliseconds >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+/**
+ * @brief Find the endpoint of a host, adding it if needed.
+ *
+ * Must be called with the mutex held.
+ */
+static http_endpoint_timings_t *find_or_add_endpoint(const char *host) {
+
+    for (size_t i = 0; i < g_endpoint_count; i++) {
+        if (strcmp(g_endpoints[i].host, host) == 0) {
+            return &g_endpoints[i];
+        }
+    }
+
+    /* The last slot is kept for the hosts that do not fit */
+    if (g_endpoint_count >= HTTP_TIMINGS_MAX_ENDPOINTS - 1) {
+        host = OTHER_HOST;
+
+        if (g_endpoint_count == HTTP_TIMINGS_MAX_ENDPOINTS) {
+            return &g_endpoints[HTTP_TIMINGS_MAX_ENDPOINTS - 1];
+        }
+    }
+
+    http_endpoint_timings_t *endpoint = &g_endpoints[g_endpoint_count++];
+
+    memset(endpoint, 0, sizeof(*endpoint));
+    snprintf(endpoint->host, sizeof(endpoint->host), "%s", host);
+
+    return endpoint;
+}
+
+static uint64_t to_unsigned(int64_t value) {
+    return value > 0 ? (uint64_t)value : 0;
+}
+
+static double average_ms(uint64_t sum_us, uint64_t count) {
+    return count ? (double)sum_us / (double)count / 1000.0 : 0.0;
+}
+
+static int format_endpoint(const http_endpoint_timings_t *endpoint, char *buffer, size_t size) {
+
+    uint64_t requests = endpoint->requests;
+
+    return snprintf(buffer,
+                    size,
+                    "%s: %llu requests, %llu new connections, avg dns %.1f / connect %.1f / tls %.1f / "
+                    "first byte %.1f / total %.1f ms, p50 %.1f ms, p95 %.1f ms, max %.1f ms, "
+                    "%llu bytes sent, %llu bytes received",
+                    endpoint->host,
+                    (unsigned long long)requests,
+                    (unsigned long long)endpoint->new_connections,
+                    average_ms(endpoint->name_lookup_us, requests),
+                    average_ms(endpoint->connect_us, requests),
+                    average_ms(endpoint->tls_us, requests),
+                    average_ms(endpoint->first_byte_us, requests),
+                    average_ms(endpoint->total_us, requests),
+                    (double)http_timings_percentile_us(endpoint, 50.0) / 1000.0,
+                    (double)http_timings_percentile_us(endpoint, 95.0) / 1000.0,
+                    (double)endpoint->max_total_us / 1000.0,
+                    (unsigned long long)endpoint->sent_bytes,
+                    (unsigned long long)endpoint->received_bytes);
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+void http_timings_record(const char *url, const http_timing_sample_t *sample) {
+
+    if (!sample) {
+        return;
+    }
+
+    char host[HTTP_TIMINGS_HOST_SIZE];
+    http_url_get_host(url, host, sizeof(host));
+
+    pthread_mutex_lock(&g_timings_mutex);
+
+    http_endpoint_timings_t *endpoint = find_or_add_endpoint(host);
+
+    endpoint->requests++;
+    endpoint->new_connections += sample->new_connections > 0 ? (uint64_t)sample->new_connections : 0;
+    endpoint->name_lookup_us += to_unsigned(sample->name_lookup_us);
+    endpoint->connect_us += to_unsigned(sample->connect_us);
+    endpoint->tls_us += to_unsigned(sample->tls_us);
+    endpoint->first_byte_us += to_unsigned(sample->first_byte_us);
+    endpoint->total_us += to_unsigned(sample->total_us);
+    endpoint->sent_bytes += sample->sent_bytes;
+    endpoint->received_bytes += sample->received_bytes;
+    endpoint->histogram[get_bucket(sample->total_us)]++;
+
+    if (sample->total_us > endpoint->max_total_us) {
+        endpoint->max_total_us = sample->total_us;
+    }
+
+    pthread_mutex_unlock(&g_timings_mutex);
+}
+
+size_t http_timings_get(http_endpoint_timings_t *out_endpoints, size_t capacity) {
+
+    pthread_mutex_lock(&g_timings_mutex);
+
+    size_t count = g_endpoint_count;
+
+    if (out_endpoints && capacity > 0) {
+        memcpy(out_endpoints, g_endpoints, (count < capacity ? count : capacity) * sizeof(http_endpoint_timings_t));
+    }
+
+    pthread_mutex_unlock(&g_timings_mutex);
+
+    return count;
+}
+
+int64_t http_timings_percentile_us(const http_endpoint_timings_t *endpoint, double percentile) {
+
+    if (!endpoint || endpoint->requests == 0) {
+        return 0;
+    }
+
+    double   wanted = percentile / 100.0 * (double)endpoint->requests;
+    uint64_t rank   = wanted < 1.0 ? 1 : (uint64_t)wanted;
+
+    /* Rounds up: the 95th percentile of 10 requests is the 10th one */
+    if ((double)rank < wanted) {
+        rank++;
+    }
+
+    uint64_t seen = 0;
+
+    for (size_t bucket = 0; bucket < HTTP_TIMINGS_BUCKETS - 1; bucket++) {
+        seen += endpoint->histogram[bucket];
+
+        if (seen >= rank) {
+            int64_t upper_bound_us = ((int64_t)1 << bucket) * 1000;
+            return upper_bound_us < endpoint->max_total_us ? upper_bound_us : endpoint->max_total_us;
+        }
+    }
+
+    return endpoint->max_total_us;
+}
+
+size_t http_timings_format(char *buffer, size_t size) {
+
+    http_endpoint_timings_t endpoints[HTTP_TIMINGS_MAX_ENDPOINTS];
+    size_t                  count  = http_timings_get(endpoints, HTTP_TIMINGS_MAX_ENDPOINTS);
+    size_t                  length = 0;
+
+    if (!buffer || size == 0) {
+        return count;
+    }
+
+    buffer[0] = '\0';
+
+    for (size_t i = 0; i < count && length < size; i++) {
+
+        int written = format_endpoint(&endpoints[i], buffer + length, size - length);
+
+        if (written < 0) {
+            break;
+        }
+
+        length += (size_t)written;
+
+        if (length < size) {
+            length += (size_t)snprintf(buffer + length, size - length, "\n");
+        }
+    }
+
+    return count;
+}
+
+void http_timings_log(void) {
+
+    http_endpoint_timings_t endpoints[HTTP_TIMINGS_MAX_ENDPOINTS];
+    size_t                  count = http_timings_get(endpoints, HTTP_TIMINGS_MAX_ENDPOINTS);
+
+    if (count == 0) {
+        obs_log(LOG_INFO, "HTTP timings | No request recorded");
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        char line[1024];
+        format_endpoint(&endpoints[i], line, sizeof(line));
+        obs_log(LOG_INFO, "HTTP timings | %s", line);
+    }
+}
+
+void http_timings_reset(void) {
+
+    pthread_mutex_lock(&g_timings_mutex);
+
+    memset(g_endpoints, 0, sizeof(g_endpoints));
+    g_endpoint_count = 0;
+
+    pthread_mutex_unlock(&g_timings_mutex);
+}
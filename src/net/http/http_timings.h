@@ -0,0 +1,156 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file http_timings.h
+ * @brief Per-endpoint latency statistics of the HTTP requests.
+ *
+ * The HTTP layer records the phases of every completed transfer (DNS lookup,
+ * TCP connect, TLS handshake, first byte, total) along with the bytes sent and
+ * received. The samples are aggregated per host, since the paths embed user
+ * and title identifiers that would otherwise spread one endpoint over many
+ * entries.
+ *
+ * As with libcurl, the phases are cumulative: each one is measured from the
+ * start of the request, so the TLS handshake of a transfer took
+ * @c tls_us - @c connect_us. A phase that did not happen (e.g. a reused
+ * connection has no connect) reports the time of the previous one.
+ *
+ * The total times also feed a log2 histogram, from which percentiles are read
+ * back with the resolution of a bucket.
+ *
+ * The functions are thread-safe.
+ */
+
+/** Number of buckets of the latency histograms */
+#define HTTP_TIMINGS_BUCKETS 16
+
+/** Number of hosts tracked; the transfers to any additional host are counted under "other" */
+#define HTTP_TIMINGS_MAX_ENDPOINTS 32
+
+/** Size of the host name buffer, including the terminator */
+#define HTTP_TIMINGS_HOST_SIZE 128
+
+/**
+ * @brief Measurements of a single transfer.
+ */
+typedef struct http_timing_sample {
+    /** Time until the host name was resolved, in microseconds */
+    int64_t name_lookup_us;
+
+    /** Time until the TCP connection was established, in microseconds */
+    int64_t connect_us;
+
+    /** Time until the TLS handshake completed, in microseconds */
+    int64_t tls_us;
+
+    /** Time until the first byte of the response was received, in microseconds */
+    int64_t first_byte_us;
+
+    /** Time until the transfer completed, in microseconds */
+    int64_t total_us;
+
+    /** Number of connections opened for the transfer (0 when an existing one was reused) */
+    long new_connections;
+
+    /** Bytes of the request body */
+    uint64_t sent_bytes;
+
+    /** Bytes of the response body as received on the wire */
+    uint64_t received_bytes;
+} http_timing_sample_t;
+
+/**
+ * @brief Aggregated measurements of the transfers to one host.
+ */
+typedef struct http_endpoint_timings {
+    /** Host name, or "other" once the table is full */
+    char host[HTTP_TIMINGS_HOST_SIZE];
+
+    /** Number of transfers recorded */
+    uint64_t requests;
+
+    /** Number of connections opened, over all the transfers */
+    uint64_t new_connections;
+
+    /** Sums of the phases of the transfers, in microseconds */
+    uint64_t name_lookup_us;
+    uint64_t connect_us;
+    uint64_t tls_us;
+    uint64_t first_byte_us;
+    uint64_t total_us;
+
+    /** Longest total time, in microseconds */
+    int64_t max_total_us;
+
+    /** Sums of the bytes sent and received */
+    uint64_t sent_bytes;
+    uint64_t received_bytes;
+
+    /**
+     * Total times: bucket 0 counts the transfers under 1 ms, bucket i those
+     * under 2^i ms and the last one everything slower.
+     */
+    uint64_t histogram[HTTP_TIMINGS_BUCKETS];
+} http_endpoint_timings_t;
+
+/**
+ * @brief Records a completed transfer.
+ *
+ * @param url    URL of the transfer (its host selects the endpoint).
+ * @param sample Measurements of the transfer.
+ */
+void http_timings_record(const char *url, const http_timing_sample_t *sample);
+
+/**
+ * @brief Copies the statistics of the endpoints, in the order they were first seen.
+ *
+ * @param out_endpoints Receives the statistics (may be NULL if @p capacity is 0).
+ * @param capacity      Number of entries @p out_endpoints can hold.
+ *
+ * @return Number of endpoints tracked, which may exceed @p capacity.
+ */
+size_t http_timings_get(http_endpoint_timings_t *out_endpoints, size_t capacity);
+
+/**
+ * @brief Estimates a percentile of the total times of an endpoint.
+ *
+ * @param endpoint   Statistics of the endpoint.
+ * @param percentile Percentile, between 0 and 100.
+ *
+ * @return Upper bound, in microseconds, of the histogram bucket holding the
+ *         percentile (the longest time for the last bucket), or 0 if nothing
+ *         was recorded.
+ */
+int64_t http_timings_percentile_us(const http_endpoint_timings_t *endpoint, double percentile);
+
+/**
+ * @brief Writes a human-readable summary, one line per endpoint.
+ *
+ * @param buffer Receives the NUL-terminated summary (truncated if too small).
+ * @param size   Size of @p buffer in bytes.
+ *
+ * @return Number of endpoints summarized.
+ */
+size_t http_timings_format(char *buffer, size_t size);
+
+/**
+ * @brief Writes the summary of every endpoint to the OBS log.
+ */
+void http_timings_log(void);
+
+/**
+ * @brief Forgets every recorded transfer.
+ */
+void http_timings_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
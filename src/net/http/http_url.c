@@ -0,0 +1,42 @@
+#include "net/http/http_url.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void http_url_get_host(const char *url, char *host, size_t size) {
+
+    if (!host || size == 0) {
+        return;
+    }
+
+    const char *start = url ? strstr(url, "://") : NULL;
+    start             = start ? start + 3 : (url ? url : "");
+
+    size_t      length = strcspn(start, "/?#");
+    const char *at     = memchr(start, '@', length);
+
+    if (at) {
+        length -= (size_t)(at + 1 - start);
+        start  = at + 1;
+    }
+
+    /* Drops the port, unless the host is an IPv6 literal */
+    const char *colon = start[0] == '[' ? NULL : memchr(start, ':', length);
+
+    if (colon) {
+        length = (size_t)(colon - start);
+    }
+
+    if (length == 0) {
+        snprintf(host, size, "unknown");
+        return;
+    }
+
+    if (length >= size) {
+        length = size - 1;
+    }
+
+    memcpy(host, start, length);
+    host[length] = '\0';
+}
+
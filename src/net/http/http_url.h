@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file http_url.h
+ * @brief URL helpers shared by the HTTP layer.
+ */
+
+/**
+ * @brief Copies the host of a URL.
+ *
+ * The scheme, user information, port, path, query and fragment are dropped:
+ * "https://user@host:443/path?query" gives "host".
+ *
+ * @param url  URL to read the host from (may be NULL).
+ * @param host Receives the NUL-terminated host (truncated if too long), or
+ *             "unknown" if the URL has no host.
+ * @param size Size of @p host in bytes.
+ */
+void http_url_get_host(const char *url, char *host, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
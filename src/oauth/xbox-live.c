@@ -17,6 +17,9 @@
  * The work is performed on a background pthread; completion is reported via the
  * callback provided to xbox_live_authenticate().
  *
+ * Once signed in, a background refresher renews the tokens ahead of their expiry;
+ * concurrent refreshes are coalesced into a single one.
+ *
  * @note This module relies on other helpers for persistence (state_*), JSON
  *       extraction (json_*), HTTP (http_*), signing (crypto_sign), and opening a
  *       browser (open_url).
@@ -24,6 +27,7 @@
 
 #include <obs-module.h>
 #include <diagnostics/log.h>
+#include <util/threading.h>
 
 #include "net/browser/browser.h"
 #include "net/http/http.h"
@@ -47,6 +51,22 @@
 #define XBOX_LIVE_AUTHENTICATE "https://user.auth.xboxlive.com/user/authenticate"
 #define DEVICE_AUTHENTICATE "https://device.auth.xboxlive.com/device/authenticate"
 #define SISU_AUTHENTICATE "https://sisu.xboxlive.com/authorize"
+#define XBOX_REST_CONTRACT_VERSION "2"
+
+/** Safety margin applied by token_is_expired() */
+#define TOKEN_EXPIRY_MARGIN_SECONDS (15 * 60)
+
+/**
+ * Number of seconds before its expiry at which the identity is refreshed in the background. Exceeds
+ * TOKEN_EXPIRY_MARGIN_SECONDS, otherwise callers find the token expired before it is renewed.
+ */
+#define REFRESH_MARGIN_SECONDS (30 * 60)
+
+/** Longest sleep of the refresher, so new sign-ins and clock changes are noticed */
+#define REFRESHER_MAX_SLEEP_MS (5 * 60 * 1000)
+
+/** Delay before the refresher retries a failed refresh */
+#define REFRESH_RETRY_DELAY_MS (60 * 1000)
 
 #define CLIENT_ID "000000004c12ae6f"
 #define SCOPE "service::user.auth.xboxlive.com::MBI_SSL"
@@ -91,10 +111,81 @@ typedef struct authentication_ctx {
 
 } authentication_ctx_t;
 
+/**
+ * @brief Refreshes the identity ahead of its expiry and coalesces concurrent refreshes.
+ */
+typedef struct identity_refresher {
+    /** Protects @c refreshing */
+    pthread_mutex_t mutex;
+
+    /** Broadcast when a refresh completes */
+    pthread_cond_t refreshed;
+
+    /** True while a refresh is running */
+    bool refreshing;
+
+    /** Signaled when the refresher must stop */
+    os_event_t *stopping;
+
+    /** Thread refreshing the identity ahead of its expiry */
+    pthread_t thread;
+
+    /** True while @c thread is running */
+    bool running;
+} identity_refresher_t;
+
+static identity_refresher_t g_refresher = {
+    .mutex     = PTHREAD_MUTEX_INITIALIZER,
+    .refreshed = PTHREAD_COND_INITIALIZER,
+};
+
+/** Handle of the current identity, shared by the requests (holds one reference) */
+static xbox_identity_handle_t *g_identity_handle       = NULL;
+static pthread_mutex_t         g_identity_handle_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** Signer of the device key, shared by the authentication flows and reused across requests. */
+static crypto_signer_t *g_signer       = NULL;
+static pthread_mutex_t  g_signer_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 //  --------------------------------------------------------------------------------------------------------------------
 //  Private
 //  --------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @brief Sign a request with the device key.
+ *
+ * The signer is created the first time the key is used and kept for the
+ * following requests; it is replaced if the device key changes.
+ *
+ * @param keys       Device key pair.
+ * @param url        Full request URL.
+ * @param payload    Request body.
+ * @param out_header Receives the signature header.
+ * @return true on success, false on error.
+ */
+static bool sign_request(const EVP_PKEY *keys,
+                         const char     *url,
+                         const char     *payload,
+                         uint8_t         out_header[CRYPTO_SIGNATURE_HEADER_SIZE]) {
+
+    bool signed_request = false;
+
+    pthread_mutex_lock(&g_signer_mutex);
+
+    if (!crypto_signer_uses_key(g_signer, keys)) {
+        crypto_signer_free(&g_signer);
+        g_signer = crypto_signer_create(keys);
+    }
+
+    if (g_signer) {
+        signed_request = crypto_signer_sign(g_signer, url, "", payload, out_header);
+    }
+
+    pthread_mutex_unlock(&g_signer_mutex);
+
+    return signed_request;
+}
+
 /**
  * @brief Notify the caller that the authentication flow has completed.
  *
@@ -125,7 +216,6 @@ static void complete(authentication_ctx_t *ctx) {
 static bool retrieve_sisu_token(authentication_ctx_t *ctx) {
 
     bool     succeeded       = false;
-    uint8_t *signature       = NULL;
     char    *signature_b64   = NULL;
     char    *sisu_token_json = NULL;
     char    *sisu_token      = NULL;
@@ -151,10 +241,9 @@ static bool retrieve_sisu_token(authentication_ctx_t *ctx) {
     /*
      * Signs the request
      */
-    size_t signature_len = 0;
-    signature            = crypto_sign(ctx->device->keys, SISU_AUTHENTICATE, "", json_body, &signature_len);
+    uint8_t signature[CRYPTO_SIGNATURE_HEADER_SIZE];
 
-    if (!signature) {
+    if (!sign_request(ctx->device->keys, SISU_AUTHENTICATE, json_body, signature)) {
         ctx->result.error_message = "Unable retrieve a sisu token: signing failed";
         goto cleanup;
     }
@@ -162,7 +251,7 @@ static bool retrieve_sisu_token(authentication_ctx_t *ctx) {
     /*
      * Encodes the signature
      */
-    signature_b64 = base64_encode(signature, signature_len);
+    signature_b64 = base64_encode(signature, sizeof(signature));
 
     if (!signature_b64) {
         ctx->result.error_message = "Unable retrieve a sisu token: encoding of the signature failed";
@@ -173,16 +262,13 @@ static bool retrieve_sisu_token(authentication_ctx_t *ctx) {
     obs_log(LOG_DEBUG, "Signature (base64): %s", signature_b64);
 
     /*
-     * Sets up the headers
+     * Sets up the request
      */
-    char extra_headers[4096];
-    snprintf(extra_headers,
-             sizeof(extra_headers),
-             "signature: %s\r\n"
-             "Cache-Control: no-store, must-revalidate, no-cache\r\n"
-             "Content-Type: text/plain;charset=UTF-8\r\n"
-             "x-xbl-contract-version: 1\r\n",
-             signature_b64);
+    http_request_t *request = http_request_create(SISU_AUTHENTICATE);
+    http_request_add_header(request, "signature", signature_b64);
+    http_request_add_header(request, "Cache-Control", "no-store, must-revalidate, no-cache");
+    http_request_add_header(request, "x-xbl-contract-version", "1");
+    http_request_set_body(request, json_body, "text/plain;charset=UTF-8");
 
     obs_log(LOG_DEBUG, "Sending request for sisu token: %s", json_body);
 
@@ -190,7 +276,7 @@ static bool retrieve_sisu_token(authentication_ctx_t *ctx) {
      * Sends the request
      */
     long http_code  = 0;
-    sisu_token_json = http_post(SISU_AUTHENTICATE, json_body, extra_headers, &http_code);
+    sisu_token_json = http_request_perform(request, &http_code);
 
     if (!sisu_token_json) {
         ctx->result.error_message = "Unable to retrieve a sisu token: received no response from the server";
@@ -331,12 +417,13 @@ static bool retrieve_device_token(struct authentication_ctx *ctx) {
         return retrieve_sisu_token(ctx);
     }
 
+    free_token(&existing_device_token);
+
     bool     succeeded         = false;
     char    *encoded_signature = NULL;
     char    *not_after_date    = NULL;
     char    *token             = NULL;
     char    *device_token_json = NULL;
-    uint8_t *signature         = NULL;
 
     obs_log(LOG_INFO, "No device token cached found. Requesting a new device token");
 
@@ -356,10 +443,9 @@ static bool retrieve_device_token(struct authentication_ctx *ctx) {
     /*
      * Signs the request
      */
-    size_t signature_len = 0;
-    signature            = crypto_sign(ctx->device->keys, DEVICE_AUTHENTICATE, "", json_body, &signature_len);
+    uint8_t signature[CRYPTO_SIGNATURE_HEADER_SIZE];
 
-    if (!signature) {
+    if (!sign_request(ctx->device->keys, DEVICE_AUTHENTICATE, json_body, signature)) {
         ctx->result.error_message = "Unable retrieve a device token: signing failed";
         obs_log(LOG_ERROR, ctx->result.error_message);
         goto cleanup;
@@ -368,7 +454,7 @@ static bool retrieve_device_token(struct authentication_ctx *ctx) {
     /*
      * Encodes the signature
      */
-    encoded_signature = base64_encode(signature, signature_len);
+    encoded_signature = base64_encode(signature, sizeof(signature));
 
     if (!encoded_signature) {
         ctx->result.error_message = "Unable retrieve a device token: signature encoding failed";
@@ -379,22 +465,19 @@ static bool retrieve_device_token(struct authentication_ctx *ctx) {
     obs_log(LOG_DEBUG, "Encoded signature: %s", encoded_signature);
 
     /*
-     * Creates the headers
+     * Creates the request
      */
-    char extra_headers[4096];
-    snprintf(extra_headers,
-             sizeof(extra_headers),
-             "signature: %s\r\n"
-             "Cache-Control: no-store, must-revalidate, no-cache\r\n"
-             "Content-Type: text/plain;charset=UTF-8\r\n"
-             "x-xbl-contract-version: 1\r\n",
-             encoded_signature);
+    http_request_t *request = http_request_create(DEVICE_AUTHENTICATE);
+    http_request_add_header(request, "signature", encoded_signature);
+    http_request_add_header(request, "Cache-Control", "no-store, must-revalidate, no-cache");
+    http_request_add_header(request, "x-xbl-contract-version", "1");
+    http_request_set_body(request, json_body, "text/plain;charset=UTF-8");
 
     /*
      * Sends the request
      */
     long http_code    = 0;
-    device_token_json = http_post(DEVICE_AUTHENTICATE, json_body, extra_headers, &http_code);
+    device_token_json = http_request_perform(request, &http_code);
 
     if (!device_token_json) {
         ctx->result.error_message = "Unable retrieve a device token: server returned no response";
@@ -456,7 +539,6 @@ static bool retrieve_device_token(struct authentication_ctx *ctx) {
     succeeded         = true;
 
 cleanup:
-    free_memory((void **)&signature);
     free_memory((void **)&encoded_signature);
     free_memory((void **)&device_token_json);
     free_memory((void **)&token);
@@ -829,6 +911,249 @@ cleanup:
     return (void *)false;
 }
 
+/**
+ * @brief Run the refresh chain (user token, then device token, then SISU token).
+ *
+ * Only the tokens that are expired are requested again; the SISU token always is.
+ *
+ * @return The refreshed identity (owned by the caller), or NULL if the refresh failed.
+ */
+static xbox_identity_t *refresh_identity(void) {
+
+    device_t *device = state_get_device();
+
+    if (!device) {
+        obs_log(LOG_ERROR, "No device found for Xbox token refresh");
+        return NULL;
+    }
+
+    xbox_identity_t *identity = NULL;
+
+    authentication_ctx_t *ctx = bzalloc(sizeof(authentication_ctx_t));
+    ctx->device               = device;
+    ctx->on_completed         = NULL;
+    ctx->on_completed_data    = NULL;
+    ctx->allow_cache          = false;
+
+    /* Retrieves the user token */
+    token_t *user_token = state_get_user_token();
+
+    if (!user_token) {
+        obs_log(LOG_ERROR, "No user token found for Xbox token refresh");
+        identity = NULL;
+        goto cleanup;
+    }
+
+    if (token_is_expired(user_token)) {
+        free_token(&user_token);
+
+        ctx->refresh_token = state_get_user_refresh_token();
+
+        if (!ctx->refresh_token) {
+            obs_log(LOG_ERROR, "No refresh token found for Xbox token refresh");
+            goto cleanup;
+        }
+
+        /* All the tokens (User, Device and Sisu) will be retrieved */
+        if (!refresh_user_token(ctx)) {
+            identity = NULL;
+            goto cleanup;
+        }
+        identity = state_get_xbox_identity();
+        goto cleanup;
+    }
+
+    ctx->user_token = user_token;
+
+    /* Retrieves the device token */
+    token_t *device_token = state_get_device_token();
+
+    if (!device_token) {
+        obs_log(LOG_ERROR, "No device token found for Xbox token refresh");
+        identity = NULL;
+        goto cleanup;
+    }
+
+    if (token_is_expired(device_token)) {
+        free_token(&device_token);
+
+        /* All the tokens (Device and Sisu) will be retrieved */
+        if (!retrieve_device_token(ctx)) {
+            identity = NULL;
+            goto cleanup;
+        }
+        identity = state_get_xbox_identity();
+        goto cleanup;
+    }
+
+    ctx->device_token = device_token;
+
+    /* Defines the structure that will filled up by the different authentication steps */
+    if (!retrieve_sisu_token(ctx)) {
+        identity = NULL;
+        goto cleanup;
+    }
+
+    identity = state_get_xbox_identity();
+
+cleanup:
+    free_device(&ctx->device);
+    free_token(&ctx->user_token);
+    free_token(&ctx->refresh_token);
+    free_token(&ctx->device_token);
+    free_memory((void **)&ctx);
+
+    return identity;
+}
+
+/**
+ * @brief Get the persisted identity, refreshing it first if its token expires within @p margin seconds.
+ *
+ * Single flight: when a refresh is already running, the caller waits for it and
+ * gets its outcome instead of starting another one.
+ *
+ * @param margin Number of seconds the token must remain valid.
+ * @return The identity (owned by the caller, free with free_identity()), or NULL if none is available
+ *         or the refresh failed.
+ */
+static xbox_identity_t *get_identity(int64_t margin) {
+
+    bool waited = false;
+
+    pthread_mutex_lock(&g_refresher.mutex);
+
+    while (g_refresher.refreshing) {
+        waited = true;
+        pthread_cond_wait(&g_refresher.refreshed, &g_refresher.mutex);
+    }
+
+    xbox_identity_t *identity = state_get_xbox_identity();
+
+    if (!identity) {
+        pthread_mutex_unlock(&g_refresher.mutex);
+        obs_log(LOG_INFO, "No identity found");
+        return NULL;
+    }
+
+    if (!token_expires_within(identity->token, margin)) {
+        pthread_mutex_unlock(&g_refresher.mutex);
+        return identity;
+    }
+
+    free_identity(&identity);
+
+    if (waited) {
+        /* The refresh that was awaited did not produce a token valid long enough */
+        pthread_mutex_unlock(&g_refresher.mutex);
+        return NULL;
+    }
+
+    g_refresher.refreshing = true;
+    pthread_mutex_unlock(&g_refresher.mutex);
+
+    obs_log(LOG_INFO, "Sisu token expires within %lld seconds, refreshing...", (long long)margin);
+
+    identity = refresh_identity();
+
+    pthread_mutex_lock(&g_refresher.mutex);
+    g_refresher.refreshing = false;
+    pthread_cond_broadcast(&g_refresher.refreshed);
+    pthread_mutex_unlock(&g_refresher.mutex);
+
+    return identity;
+}
+
+/**
+ * @brief Refresh the identity if it is due.
+ *
+ * @return Number of milliseconds before the next check.
+ */
+static uint32_t refresh_identity_if_due(void) {
+
+    const int64_t margin = REFRESH_MARGIN_SECONDS;
+
+    xbox_identity_t *identity = state_get_xbox_identity();
+
+    if (!identity) {
+        /* Not signed in yet */
+        return REFRESHER_MAX_SLEEP_MS;
+    }
+
+    int64_t remaining = identity->token->expires - margin - (int64_t)now();
+    free_identity(&identity);
+
+    if (remaining > 0) {
+        return remaining * 1000 < REFRESHER_MAX_SLEEP_MS ? (uint32_t)(remaining * 1000) : REFRESHER_MAX_SLEEP_MS;
+    }
+
+    identity = get_identity(margin);
+
+    if (!identity) {
+        obs_log(LOG_WARNING, "Unable to refresh the identity ahead of its expiry: retrying later");
+        return REFRESH_RETRY_DELAY_MS;
+    }
+
+    obs_log(LOG_INFO,
+            "Identity refreshed ahead of its expiry. Token expires at %lld",
+            (long long)identity->token->expires);
+
+    /* A token living less than the margin would otherwise be refreshed in a loop */
+    bool still_due = token_expires_within(identity->token, margin);
+    free_identity(&identity);
+
+    return still_due ? REFRESH_RETRY_DELAY_MS : 0;
+}
+
+/**
+ * @brief Background thread refreshing the identity ahead of its expiry.
+ *
+ * Returns once asked to stop.
+ */
+static void *refresher_thread(void *arg) {
+    UNUSED_PARAMETER(arg);
+
+    uint32_t delay_ms = 0;
+
+    for (;;) {
+
+        if (os_event_timedwait(g_refresher.stopping, delay_ms) == 0) {
+            break;
+        }
+
+        delay_ms = refresh_identity_if_due();
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Create an identity handle holding one reference.
+ *
+ * @param identity Identity to copy.
+ * @param version  Version of the stored identity @p identity was read at.
+ * @return The new handle.
+ */
+static xbox_identity_handle_t *create_identity_handle(const xbox_identity_t *identity, long version) {
+
+    size_t length        = strlen(identity->uhs) + strlen(identity->token->value) + 16;
+    char  *authorization = bzalloc(length);
+    snprintf(authorization, length, "XBL3.0 x=%s;%s", identity->uhs, identity->token->value);
+
+    http_headers_t *headers = http_headers_create();
+    http_headers_add(headers, "Authorization", authorization);
+    http_headers_add(headers, "x-xbl-contract-version", XBOX_REST_CONTRACT_VERSION);
+
+    bfree(authorization);
+
+    xbox_identity_handle_t *handle = bzalloc(sizeof(xbox_identity_handle_t));
+    handle->identity               = copy_xbox_identity(identity);
+    handle->headers                = headers;
+    handle->version                = version;
+    handle->refs                   = 1;
+
+    return handle;
+}
+
 //  --------------------------------------------------------------------------------------------------------------------
 //  Public
 //  --------------------------------------------------------------------------------------------------------------------
@@ -871,6 +1196,9 @@ bool xbox_live_authenticate(void *data, on_xbox_live_authenticated_t callback) {
  *    returned immediately.
  *  - If the token is expired, this function attempts to refresh authentication
  *    using the persisted device identity and refresh token.
+ *  - If a refresh is already running (started by another caller or by the
+ *    background refresher), this function waits for it instead of starting
+ *    another one.
  *
  * Side-effects:
  *  - May perform network requests to refresh tokens.
@@ -881,98 +1209,119 @@ bool xbox_live_authenticate(void *data, on_xbox_live_authenticated_t callback) {
  *  - Call from a worker thread (not the OBS render thread).
  *
  * Ownership:
- *  - Returns an xbox_identity_t allocated/returned by state_get_xbox_identity().
- *    The caller owns the returned object and must free it consistently with the
- *    state subsystem contract.
+ *  - Returns a copy of the stored identity (see state_get_xbox_identity()).
+ *    The caller owns it and must free it with free_identity().
  *
  * @return Xbox identity on success; NULL if no identity is available or refresh
  *         fails.
  */
 xbox_identity_t *xbox_live_get_identity(void) {
 
-    xbox_identity_t *identity = state_get_xbox_identity();
+    /* Same window as token_is_expired() */
+    return get_identity(TOKEN_EXPIRY_MARGIN_SECONDS);
+}
 
-    if (!identity) {
-        obs_log(LOG_INFO, "No identity found");
-        return identity;
-    }
+xbox_identity_handle_t *xbox_live_acquire_identity(void) {
 
-    /* Checks if the Sisu token is expired */
-    if (!token_is_expired(identity->token)) {
-        obs_log(LOG_INFO, "Token is NOT expired, reusing existing identity");
-        return identity;
+    xbox_identity_handle_t *handle = NULL;
+
+    /* Read first: a change made while the handle is built makes it stale rather than missed */
+    long version = state_get_xbox_identity_version();
+
+    pthread_mutex_lock(&g_identity_handle_mutex);
+
+    if (g_identity_handle && g_identity_handle->version == version &&
+        !token_expires_within(g_identity_handle->identity->token, TOKEN_EXPIRY_MARGIN_SECONDS)) {
+        handle = g_identity_handle;
+        os_atomic_inc_long(&handle->refs);
     }
 
-    obs_log(LOG_INFO, "Sisu token is expired, refreshing...");
+    pthread_mutex_unlock(&g_identity_handle_mutex);
 
-    device_t *device = state_get_device();
+    if (handle) {
+        return handle;
+    }
 
-    if (!device) {
-        obs_log(LOG_ERROR, "No device found for Xbox token refresh");
-        return false;
+    xbox_identity_t *identity = xbox_live_get_identity();
+
+    if (!identity) {
+        return NULL;
     }
 
-    authentication_ctx_t *ctx = bzalloc(sizeof(authentication_ctx_t));
-    ctx->device               = device;
-    ctx->on_completed         = NULL;
-    ctx->on_completed_data    = NULL;
-    ctx->allow_cache          = false;
+    handle = create_identity_handle(identity, version);
+    free_identity(&identity);
 
-    /* Retrieves the user token */
-    token_t *user_token = state_get_user_token();
+    /* One reference for the cache, one for the caller */
+    os_atomic_inc_long(&handle->refs);
 
-    if (!user_token) {
-        obs_log(LOG_ERROR, "No user token found for Xbox token refresh");
-        identity = NULL;
-        goto cleanup;
+    pthread_mutex_lock(&g_identity_handle_mutex);
+    xbox_identity_handle_t *previous = g_identity_handle;
+    g_identity_handle                = handle;
+    pthread_mutex_unlock(&g_identity_handle_mutex);
+
+    xbox_live_release_identity(&previous);
+
+    return handle;
+}
+
+void xbox_live_release_identity(xbox_identity_handle_t **handle) {
+
+    if (!handle || !*handle) {
+        return;
     }
 
-    if (token_is_expired(user_token)) {
-        /* All the tokens (User, Device and Sisu) will be retrieved */
-        if (!refresh_user_token(ctx)) {
-            identity = NULL;
-            goto cleanup;
-        }
-        identity = state_get_xbox_identity();
-        goto cleanup;
+    xbox_identity_handle_t *current = *handle;
+    *handle                         = NULL;
+
+    if (os_atomic_dec_long(&current->refs) > 0) {
+        return;
     }
 
-    ctx->user_token = user_token;
+    free_identity((xbox_identity_t **)&current->identity);
+    http_headers_release(&current->headers);
+    bfree(current);
+}
 
-    /* Retrieves the device token */
-    token_t *device_token = state_get_device_token();
+void xbox_live_start_refresher(void) {
 
-    if (!device_token) {
-        obs_log(LOG_ERROR, "No device token found for Xbox token refresh");
-        identity = NULL;
-        goto cleanup;
+    if (g_refresher.running) {
+        return;
     }
 
-    if (token_is_expired(device_token)) {
-        /* All the tokens (Device and Sisu) will be retrieved */
-        if (!retrieve_device_token(ctx)) {
-            identity = NULL;
-            goto cleanup;
-        }
-        identity = state_get_xbox_identity();
-        goto cleanup;
+    if (os_event_init(&g_refresher.stopping, OS_EVENT_TYPE_MANUAL) != 0) {
+        goto failure;
     }
 
-    ctx->device_token = device_token;
-
-    /* Defines the structure that will filled up by the different authentication steps */
-    if (!retrieve_sisu_token(ctx)) {
-        identity = NULL;
-        goto cleanup;
+    if (pthread_create(&g_refresher.thread, NULL, refresher_thread, NULL) != 0) {
+        goto failure;
     }
 
-    identity = state_get_xbox_identity();
+    g_refresher.running = true;
+    return;
 
-cleanup:
-    free_memory((void **)&ctx->device);
-    free_memory((void **)&ctx->user_token);
-    free_memory((void **)&ctx->device_token);
-    free_memory((void **)&ctx);
+failure:
+    obs_log(LOG_WARNING, "Unable to start the token refresher: the tokens will be refreshed when they expire");
 
-    return identity;
+    os_event_destroy(g_refresher.stopping);
+    g_refresher.stopping = NULL;
+}
+
+void xbox_live_cleanup(void) {
+
+    if (g_refresher.running) {
+        os_event_signal(g_refresher.stopping);
+        pthread_join(g_refresher.thread, NULL);
+
+        os_event_destroy(g_refresher.stopping);
+        g_refresher.stopping = NULL;
+        g_refresher.running  = false;
+    }
+
+    pthread_mutex_lock(&g_identity_handle_mutex);
+    xbox_live_release_identity(&g_identity_handle);
+    pthread_mutex_unlock(&g_identity_handle_mutex);
+
+    pthread_mutex_lock(&g_signer_mutex);
+    crypto_signer_free(&g_signer);
+    pthread_mutex_unlock(&g_signer_mutex);
 }
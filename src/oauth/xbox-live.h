@@ -3,6 +3,7 @@
 #include <stdbool.h>
 
 #include "common/types.h"
+#include "net/http/http.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -27,6 +28,28 @@ extern "C" {
  */
 typedef void (*on_xbox_live_authenticated_t)(void *data);
 
+/**
+ * @brief Shared, reference-counted copy of the Xbox identity.
+ *
+ * Requests only read the identity, so they share one handle instead of
+ * reading the state and building the authorization header every time.
+ * Acquire it with xbox_live_acquire_identity() and release it with
+ * xbox_live_release_identity(). The members must not be modified.
+ */
+typedef struct xbox_identity_handle {
+    /** Deep copy of the identity. */
+    const xbox_identity_t *identity;
+
+    /** Prebuilt "Authorization: XBL3.0 x=<uhs>;<token>" and "x-xbl-contract-version" header lines. */
+    http_headers_t *headers;
+
+    /** Version of the stored identity the handle was built from (see state_get_xbox_identity_version()). */
+    long version;
+
+    /** Number of references held on the handle. */
+    volatile long refs;
+} xbox_identity_handle_t;
+
 /**
  * @brief Start the Xbox Live authentication flow.
  *
@@ -52,16 +75,58 @@ bool xbox_live_authenticate(void *data, on_xbox_live_authenticated_t callback);
  * obtained during authentication.
  *
  * Ownership/lifetime:
- *  - The returned pointer is owned by the caller.
- *  - The exact allocation/free contract depends on the implementation. In the
- *    current codebase, identity objects are typically allocated and returned by
- *    the state subsystem (see state_get_xbox_identity()), and should be freed by
- *    the caller when no longer needed.
+ *  - The returned identity is a copy owned by the caller, strings and token
+ *    included, and must be freed with free_identity(). It is not affected by
+ *    later changes of the stored identity.
  *
  * @return An xbox_identity_t on success, or NULL if no identity is available.
  */
 xbox_identity_t *xbox_live_get_identity(void);
 
+/**
+ * @brief Acquire a reference on the handle of the current Xbox identity.
+ *
+ * The handle is cached: it is only rebuilt when the stored identity changes
+ * (see state_get_xbox_identity_version()) or when its token expires, in which
+ * case the tokens are refreshed as in xbox_live_get_identity().
+ *
+ * Threading:
+ *  - Thread-safe. May block while the tokens are refreshed.
+ *
+ * @return Handle to release with xbox_live_release_identity(), or NULL if no
+ *         identity is available or the refresh fails.
+ */
+xbox_identity_handle_t *xbox_live_acquire_identity(void);
+
+/**
+ * @brief Release a reference acquired with xbox_live_acquire_identity().
+ *
+ * The handle is freed with its last reference. Sets the caller's pointer to NULL.
+ *
+ * @param handle Address of the handle to release (may be NULL or point to NULL).
+ */
+void xbox_live_release_identity(xbox_identity_handle_t **handle);
+
+/**
+ * @brief Start refreshing the identity in the background ahead of its expiry.
+ *
+ * A background thread refreshes the tokens 30 minutes before the identity's
+ * token expires, so xbox_live_get_identity() does not have to block on an
+ * expiry that could have been anticipated. Refreshes are single-flight: a
+ * caller of xbox_live_get_identity() arriving during a refresh waits for it.
+ *
+ * Typically called when the module is loaded. Stopped by xbox_live_cleanup().
+ */
+void xbox_live_start_refresher(void);
+
+/**
+ * @brief Stop the background refresher and release the cached identity handle and
+ *        the signer kept for the device key.
+ *
+ * Typically called when the module is unloaded.
+ */
+void xbox_live_cleanup(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,6 +4,7 @@
 #include <diagnostics/log.h>
 
 #include "io/state.h"
+#include "net/http/http_timings.h"
 #include "oauth/xbox-live.h"
 #include "xbox/xbox_client.h"
 #include "xbox/xbox_monitor.h"
@@ -26,6 +27,8 @@ static void start_monitoring_if_needed(void) {
         return;
     }
 
+    free_identity(&identity);
+
     xbox_monitoring_start();
 }
 
@@ -80,6 +83,46 @@ static bool on_sign_out_clicked(obs_properties_t *props, obs_property_t *propert
     return true;
 }
 
+/**
+ * @brief OBS properties callback for the prefetch button.
+ *
+ * Turns the prefetching of the recently played games on or off. The preference
+ * is global: it is kept in the state rather than in the settings of a source.
+ *
+ * @return Always true so the label of the button is updated.
+ */
+static bool on_toggle_prefetch_clicked(obs_properties_t *props, obs_property_t *property, void *data) {
+    UNUSED_PARAMETER(props);
+    UNUSED_PARAMETER(property);
+    UNUSED_PARAMETER(data);
+
+    bool enabled = !state_get_prefetch_enabled();
+
+    state_set_prefetch_enabled(enabled);
+    xbox_monitoring_set_prefetch_enabled(enabled);
+
+    obs_log(LOG_INFO, "Prefetching of the recently played games %s", enabled ? "enabled" : "disabled");
+
+    return true;
+}
+
+/**
+ * @brief OBS properties callback for the "Log network timings" button.
+ *
+ * Writes the latency statistics of every endpoint to the OBS log.
+ *
+ * @return Always false: the properties do not change.
+ */
+static bool on_log_timings_clicked(obs_properties_t *props, obs_property_t *property, void *data) {
+    UNUSED_PARAMETER(props);
+    UNUSED_PARAMETER(property);
+    UNUSED_PARAMETER(data);
+
+    http_timings_log();
+
+    return false;
+}
+
 /**
  * @brief Completion callback invoked after Xbox Live authentication.
  *
@@ -127,6 +170,14 @@ static void on_xbox_game_played(const game_t *game) {
 //	Source callbacks
 //  --------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @brief OBS source update callback.
+ */
+static void on_source_update(void *data, obs_data_t *settings) {
+    UNUSED_PARAMETER(data);
+    UNUSED_PARAMETER(settings);
+}
+
 /**
  * @brief OBS source create callback.
  *
@@ -178,14 +229,6 @@ static uint32_t source_get_height(void *data) {
     return s->height;
 }
 
-/**
- * @brief OBS source update callback.
- */
-static void on_source_update(void *data, obs_data_t *settings) {
-    UNUSED_PARAMETER(data);
-    UNUSED_PARAMETER(settings);
-}
-
 /**
  * @brief OBS source video render callback.
  */
@@ -198,13 +241,14 @@ static void on_source_video_render(void *data, gs_effect_t *effect) {
  * @brief OBS source callback providing the properties UI.
  *
  * Displays sign-in status, gamerscore, and current game info (if available).
- * Provides sign-in / sign-out buttons.
+ * Provides sign-in / sign-out buttons. Once requests were made, also displays
+ * the latency of each endpoint and a button to write it to the OBS log.
  */
 static obs_properties_t *source_get_properties(void *data) {
     UNUSED_PARAMETER(data);
 
     /* Gets or refreshes the token */
-    const xbox_identity_t *xbox_identity = xbox_live_get_identity();
+    xbox_identity_t *xbox_identity = xbox_live_get_identity();
 
     /* Lists all the UI components of the properties page */
     obs_properties_t *p = obs_properties_create();
@@ -212,6 +256,7 @@ static obs_properties_t *source_get_properties(void *data) {
     if (xbox_identity != NULL) {
         char status[4096];
         snprintf(status, 4096, "Signed in as %s", xbox_identity->gamertag);
+        free_identity(&xbox_identity);
 
         int64_t gamerscore = 0;
         xbox_fetch_gamerscore(&gamerscore);
@@ -222,7 +267,8 @@ static obs_properties_t *source_get_properties(void *data) {
         obs_properties_add_text(p, "connected_status_info", status, OBS_TEXT_INFO);
         obs_properties_add_text(p, "gamerscore_info", gamerscore_text, OBS_TEXT_INFO);
 
-        const game_t *game = get_current_game();
+        session_snapshot_t *snapshot = get_current_session_snapshot();
+        const game_t       *game     = snapshot ? snapshot->session->game : NULL;
 
         if (game) {
             char game_played[4096];
@@ -230,12 +276,26 @@ static obs_properties_t *source_get_properties(void *data) {
             obs_properties_add_text(p, "game_played", game_played, OBS_TEXT_INFO);
         }
 
+        release_session_snapshot(&snapshot);
+
         obs_properties_add_button(p, "sign_out_xbox", "Sign out from Xbox", &on_sign_out_clicked);
+        obs_properties_add_button(p,
+                                  "toggle_prefetch",
+                                  state_get_prefetch_enabled() ? "Stop prefetching recently played games"
+                                                               : "Prefetch recently played games",
+                                  &on_toggle_prefetch_clicked);
     } else {
         obs_properties_add_text(p, "disconnected_status_info", "You are not connected.", OBS_TEXT_INFO);
         obs_properties_add_button(p, "sign_in_xbox", "Sign in with Xbox", &on_sign_in_xbox_clicked);
     }
 
+    char timings[4096];
+
+    if (http_timings_format(timings, sizeof(timings)) > 0) {
+        obs_properties_add_text(p, "network_timings_info", timings, OBS_TEXT_INFO);
+        obs_properties_add_button(p, "log_network_timings", "Log network timings", &on_log_timings_clicked);
+    }
+
     return p;
 }
 
@@ -274,15 +334,18 @@ static const struct obs_source_info *xbox_source_get(void) {
 /**
  * @brief Registers the Xbox Account source with OBS and starts monitoring.
  *
- * Registers the source so it is available in OBS. Also subscribes to the "game
- * played" monitor callback. If an identity is already present in state, starts
- * background monitoring immediately.
+ * Registers the source so it is available in OBS. Also applies the stored
+ * prefetch preference and subscribes to the "game played" monitor callback. If
+ * an identity is already present in state, starts background monitoring
+ * immediately.
  */
 void xbox_account_source_register(void) {
 
     obs_register_source(xbox_source_get());
 
-    xbox_subscribe_game_played(&on_xbox_game_played);
+    xbox_monitoring_set_prefetch_enabled(state_get_prefetch_enabled());
+
+    xbox_subscribe_game_played(&on_xbox_game_played, XBOX_DELIVER_LATEST);
 
     start_monitoring_if_needed();
 }
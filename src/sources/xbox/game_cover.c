@@ -6,15 +6,24 @@
  *
  * Responsibilities:
  *  - Subscribe to Xbox game-played events.
- *  - Download cover art when the game changes.
- *  - Load the image into an OBS gs_texture_t on the graphics thread.
+ *  - Download cover art when the game changes, or take it from the cover cache.
+ *  - Decode the image and scale it to the size of the source, then upload it
+ *    into an OBS gs_texture_t on the graphics thread.
  *  - Render the texture in the source's video_render callback.
  *
  * Threading notes:
- *  - Downloading happens on the calling thread of on_xbox_game_played() (currently
- *    synchronous).
- *  - Texture creation/destruction must happen on the OBS graphics thread; this
- *    file uses obs_enter_graphics()/obs_leave_graphics() to ensure that.
+ *  - Downloading, decoding and scaling happen in on_xbox_game_played(), on the
+ *    monitor's dispatcher thread. Only the latest game is delivered when several are
+ *    waiting, so a slow download never holds up the websocket nor queues stale
+ *    covers.
+ *  - The pixels are handed over to the graphics thread, which only has to
+ *    upload them. Texture creation/destruction must happen on the OBS graphics
+ *    thread; this file uses obs_enter_graphics()/obs_leave_graphics() to ensure
+ *    that.
+ *  - The textures of the recently played games are kept in a least recently
+ *    used list bounded by a VRAM budget. Switching back to one of these games
+ *    needs no download, no decoding and no upload: the texture is swapped on
+ *    the next frame.
  */
 
 #include <graphics/graphics.h>
@@ -22,8 +31,11 @@
 #include <diagnostics/log.h>
 #include <curl/curl.h>
 #include <inttypes.h>
+#include <pthread.h>
 
 #include "drawing/image.h"
+#include "drawing/image_scale.h"
+#include "io/cover_cache.h"
 #include "io/state.h"
 #include "oauth/xbox-live.h"
 #include "crypto/crypto.h"
@@ -32,6 +44,10 @@
 
 #include <net/http/http.h>
 
+/** Setting holding the VRAM budget of the cover textures, in megabytes */
+#define TEXTURE_BUDGET_SETTING "texture_budget_mb"
+#define DEFAULT_TEXTURE_BUDGET_MB 32
+
 typedef struct xbox_game_cover_source {
     /** OBS source instance. */
     obs_source_t *source;
@@ -44,17 +60,71 @@ typedef struct xbox_game_cover_source {
 } xbox_game_cover_source_t;
 
 /**
- * @brief Runtime cache for the downloaded cover art image.
+ * @brief Decoded cover, ready to be uploaded.
+ */
+typedef struct cover_pixels {
+    /** Pixels, row by row (allocated with bmalloc). */
+    uint8_t *data;
+
+    /** Format of @c data. */
+    enum gs_color_format format;
+
+    /** Size of the image in pixels. */
+    uint32_t width;
+    uint32_t height;
+} cover_pixels_t;
+
+/**
+ * @brief Cover of a game uploaded to the GPU.
+ */
+typedef struct cover_texture {
+    /** Title id of the game. */
+    char *title_id;
+
+    /** GPU texture of the cover. */
+    gs_texture_t *texture;
+
+    /** Estimated VRAM used by the texture, in bytes. */
+    size_t size;
+
+    /** Next less recently used cover. */
+    struct cover_texture *next;
+} cover_texture_t;
+
+/**
+ * @brief Runtime cache for the downloaded cover art images.
  */
 typedef struct game_cover {
-    /** Temporary file path used as an intermediate for gs_texture_create_from_file(). */
-    char image_path[512];
+    /** Protects every member but @c current. */
+    pthread_mutex_t mutex;
 
-    /** GPU texture created from the downloaded image (owned by this module). */
-    gs_texture_t *image_texture;
+    /** Title id of the cover to show on the next render tick (NULL to clear the cover). */
+    char *pending_title_id;
 
-    /** If true, the next render tick should reload the texture from image_path. */
+    /** Decoded cover of @c pending_title_id, or NULL if its texture is already in @c textures. */
+    cover_pixels_t *pending_pixels;
+
+    /** If true, the next render tick should show the cover of @c pending_title_id. */
     bool must_reload;
+
+    /**
+     * Uploaded covers, most recently used first. Only modified by the graphics
+     * thread; other threads may only look entries up.
+     */
+    cover_texture_t *textures;
+
+    /** Estimated VRAM used by @c textures, in bytes. */
+    size_t texture_bytes;
+
+    /** VRAM the textures may use before the least recently used ones are destroyed, in bytes. */
+    size_t texture_budget;
+
+    /** Size the covers are scaled to before being uploaded, in pixels. */
+    uint32_t target_width;
+    uint32_t target_height;
+
+    /** Cover currently drawn (graphics thread only). */
+    cover_texture_t *current;
 } game_cover_t;
 
 /**
@@ -63,26 +133,196 @@ typedef struct game_cover {
  * This source is implemented as a singleton that stores the current cover art in
  * a global cache.
  */
-static game_cover_t g_game_cover;
+static game_cover_t g_game_cover = {
+    .mutex          = PTHREAD_MUTEX_INITIALIZER,
+    .texture_budget = DEFAULT_TEXTURE_BUDGET_MB * 1024 * 1024,
+};
 
 //  --------------------------------------------------------------------------------------------------------------------
 //	Private functions
 //  --------------------------------------------------------------------------------------------------------------------
 
+static void free_pixels(cover_pixels_t **pixels) {
+
+    if (!pixels || !*pixels) {
+        return;
+    }
+
+    bfree((*pixels)->data);
+    bfree(*pixels);
+    *pixels = NULL;
+}
+
 /**
- * @brief Download cover art from an URL into a temporary file.
+ * @brief Find the uploaded cover of a game. Must be called with the mutex held.
  *
- * The file path is stored in g_game_cover.image_path and g_game_cover.must_reload
- * is set to true so the graphics thread can create a texture on the next render.
+ * @param[out] out_link Optional output for the link pointing to the cover.
+ */
+static cover_texture_t *find_texture(const char *title_id, cover_texture_t ***out_link) {
+
+    cover_texture_t **link = &g_game_cover.textures;
+
+    while (*link && strcmp((*link)->title_id, title_id) != 0) {
+        link = &(*link)->next;
+    }
+
+    if (out_link) {
+        *out_link = link;
+    }
+
+    return *link;
+}
+
+/**
+ * @brief Destroy a cover texture. Must be called from the graphics thread.
+ */
+static void free_texture(cover_texture_t **texture) {
+
+    if (!texture || !*texture) {
+        return;
+    }
+
+    gs_texture_destroy((*texture)->texture);
+    bfree((*texture)->title_id);
+    bfree(*texture);
+    *texture = NULL;
+}
+
+/**
+ * @brief Destroy a list of cover textures.
  *
- * @param image_url Cover art URL. If NULL or empty, this function is a no-op.
+ * Enters the graphics context itself: must be called without the mutex held,
+ * since the render callbacks take the mutex while in the graphics context.
  */
-static void download_box_art_from_url(const char *image_url) {
+static void destroy_textures(cover_texture_t *textures) {
 
-    if (!image_url || image_url[0] == '\0') {
+    if (!textures) {
         return;
     }
 
+    obs_enter_graphics();
+
+    while (textures) {
+        cover_texture_t *next = textures->next;
+        free_texture(&textures);
+        textures = next;
+    }
+
+    obs_leave_graphics();
+}
+
+/**
+ * @brief Unlink the least recently used textures until they fit the budget.
+ *
+ * Neither the cover being shown nor the uploaded cover a pending request asks
+ * for (see set_pending_uploaded_cover()) is unlinked. Must be called with the
+ * mutex held; the caller destroys the returned textures with destroy_textures()
+ * once the mutex is released.
+ *
+ * @return The unlinked textures.
+ */
+static cover_texture_t *evict_textures(void) {
+
+    cover_texture_t *evicted = NULL;
+
+    while (g_game_cover.texture_bytes > g_game_cover.texture_budget) {
+
+        cover_texture_t **oldest_link = NULL;
+
+        const char *pending_title_id = g_game_cover.pending_title_id;
+
+        for (cover_texture_t **link = &g_game_cover.textures; *link; link = &(*link)->next) {
+            if (*link != g_game_cover.current &&
+                (!pending_title_id || strcmp((*link)->title_id, pending_title_id) != 0)) {
+                oldest_link = link;
+            }
+        }
+
+        if (!oldest_link) {
+            break;
+        }
+
+        cover_texture_t *oldest = *oldest_link;
+        *oldest_link            = oldest->next;
+
+        g_game_cover.texture_bytes -= oldest->size;
+
+        obs_log(LOG_DEBUG, "Evicting the cover texture of game %s", oldest->title_id);
+
+        oldest->next = evicted;
+        evicted      = oldest;
+    }
+
+    return evicted;
+}
+
+/**
+ * @brief Replace the request that was still waiting to be applied. Must be called with the mutex held.
+ */
+static void replace_pending_cover(const char *title_id, cover_pixels_t *pixels) {
+
+    free_pixels(&g_game_cover.pending_pixels);
+    bfree(g_game_cover.pending_title_id);
+
+    g_game_cover.pending_title_id = title_id ? bstrdup(title_id) : NULL;
+    g_game_cover.pending_pixels   = pixels;
+    g_game_cover.must_reload      = true;
+}
+
+/**
+ * @brief Ask the graphics thread to show the cover of a game.
+ *
+ * Replaces any request that was still waiting to be applied.
+ *
+ * @param title_id Title id of the game (may be NULL to clear the cover).
+ * @param pixels   Decoded cover. Ownership is transferred.
+ */
+static void set_pending_cover(const char *title_id, cover_pixels_t *pixels) {
+
+    pthread_mutex_lock(&g_game_cover.mutex);
+    replace_pending_cover(title_id, pixels);
+    pthread_mutex_unlock(&g_game_cover.mutex);
+}
+
+/**
+ * @brief Ask the graphics thread to show the cover of a game if it is still uploaded.
+ *
+ * The lookup and the request are made under the mutex, and evict_textures()
+ * spares the cover of the pending request, so the texture is still there when
+ * the request is applied. Safe to call from any thread.
+ *
+ * @param title_id Title id of the game.
+ * @return true if the cover is uploaded and was requested, false otherwise.
+ */
+static bool set_pending_uploaded_cover(const char *title_id) {
+
+    pthread_mutex_lock(&g_game_cover.mutex);
+
+    bool found = find_texture(title_id, NULL) != NULL;
+
+    if (found) {
+        replace_pending_cover(title_id, NULL);
+    }
+
+    pthread_mutex_unlock(&g_game_cover.mutex);
+
+    return found;
+}
+
+/**
+ * @brief Get the cover art of an URL from the cover cache, downloading it first if needed.
+ *
+ * @return Path of the cached image (caller must bfree()), or NULL on failure.
+ */
+static char *get_cached_box_art(const char *image_url) {
+
+    char *path = cover_cache_get_path(image_url);
+
+    if (path) {
+        obs_log(LOG_INFO, "Loading Xbox game box art from the cache: %s", image_url);
+        return path;
+    }
+
     obs_log(LOG_INFO, "Loading Xbox game box art from URL: %s", image_url);
 
     /* Downloads the image in memory */
@@ -91,69 +331,212 @@ static void download_box_art_from_url(const char *image_url) {
 
     if (!http_download(image_url, &data, &size)) {
         obs_log(LOG_WARNING, "Unable to download box art from URL: %s", image_url);
+        return NULL;
+    }
+
+    path = cover_cache_store(image_url, data, size);
+    bfree(data);
+
+    return path;
+}
+
+/**
+ * @brief Scale a decoded cover to the size it is drawn at.
+ *
+ * Covers are usually much larger than the source: the texture then uses less
+ * VRAM and costs less to upload. Left untouched if its format is not 32 bits
+ * per pixel.
+ */
+static void scale_pixels(cover_pixels_t *pixels) {
+
+    pthread_mutex_lock(&g_game_cover.mutex);
+    uint32_t width  = g_game_cover.target_width;
+    uint32_t height = g_game_cover.target_height;
+    pthread_mutex_unlock(&g_game_cover.mutex);
+
+    if (width == 0 || height == 0 || gs_get_format_bpp(pixels->format) != 32) {
         return;
     }
 
-    /* Write the bytes to a temp file and use gs_texture_create_from_file of the render thread */
-    snprintf(g_game_cover.image_path,
-             sizeof(g_game_cover.image_path),
-             "%s/obs_plugin_temp_image.png",
-             getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp");
+    if (pixels->width == width && pixels->height == height) {
+        return;
+    }
 
-    FILE *temp_file = fopen(g_game_cover.image_path, "wb");
+    uint8_t *scaled = scale_image(pixels->data, pixels->width, pixels->height, width, height);
 
-    if (!temp_file) {
-        obs_log(LOG_ERROR, "Failed to create temp file for image");
-        bfree(data);
+    if (!scaled) {
         return;
     }
-    fwrite(data, 1, size, temp_file);
-    fclose(temp_file);
-    bfree(data);
 
-    /* Force its reload into a texture on the next render */
-    g_game_cover.must_reload = true;
+    bfree(pixels->data);
+    pixels->data   = scaled;
+    pixels->width  = width;
+    pixels->height = height;
 }
 
 /**
- * @brief Load the downloaded cover image into a gs_texture_t.
+ * @brief Load and decode the cover art of an URL.
+ *
+ * The decoded pixels are handed over to the graphics thread, which uploads them
+ * into a texture on the next render.
+ *
+ * @param title_id  Title id of the game the cover belongs to.
+ * @param image_url Cover art URL. If NULL or empty, this function is a no-op.
+ */
+static void load_box_art_from_url(const char *title_id, const char *image_url) {
+
+    if (!image_url || image_url[0] == '\0') {
+        return;
+    }
+
+    char *path = get_cached_box_art(image_url);
+
+    if (!path) {
+        return;
+    }
+
+    /* Decoding is the expensive part: done here so the graphics thread only uploads the pixels */
+    cover_pixels_t *pixels = bzalloc(sizeof(cover_pixels_t));
+    pixels->data           = gs_create_texture_file_data(path, &pixels->format, &pixels->width, &pixels->height);
+    bfree(path);
+
+    if (!pixels->data) {
+        obs_log(LOG_WARNING, "Failed to decode the box art from URL: %s", image_url);
+        free_pixels(&pixels);
+        return;
+    }
+
+    scale_pixels(pixels);
+
+    set_pending_cover(title_id, pixels);
+}
+
+/**
+ * @brief Create the texture of a decoded cover.
+ *
+ * Enters the graphics context itself: must be called without the mutex held.
+ *
+ * @return The new cover (owning @p title_id), or NULL on failure.
+ */
+static cover_texture_t *create_texture(char *title_id, const cover_pixels_t *pixels) {
+
+    const uint8_t *data = pixels->data;
+
+    obs_enter_graphics();
+    gs_texture_t *gs_texture = gs_texture_create(pixels->width, pixels->height, pixels->format, 1, &data, 0);
+    obs_leave_graphics();
+
+    if (!gs_texture) {
+        obs_log(LOG_WARNING, "Failed to create texture from the image");
+        return NULL;
+    }
+
+    cover_texture_t *texture = bzalloc(sizeof(cover_texture_t));
+    texture->title_id        = title_id;
+    texture->texture         = gs_texture;
+    texture->size            = (size_t)pixels->width * pixels->height * gs_get_format_bpp(pixels->format) / 8;
+
+    obs_log(LOG_INFO, "New image has been successfully uploaded");
+
+    return texture;
+}
+
+/**
+ * @brief Show the pending cover, uploading it into a gs_texture_t if needed.
  *
  * If g_game_cover.must_reload is false, this function does nothing.
  *
+ * The render callbacks take the mutex while in the graphics context, so the
+ * mutex is never held while entering it: the pending cover is taken under the
+ * mutex, the texture is created without it, and the mutex is taken again only
+ * to publish the texture.
+ *
  * This must be called from a context where entering/leaving graphics is allowed
  * (typically from video_render).
  */
-static void load_texture_from_file() {
+static void upload_pending_image() {
+
+    pthread_mutex_lock(&g_game_cover.mutex);
 
     if (!g_game_cover.must_reload) {
+        pthread_mutex_unlock(&g_game_cover.mutex);
         return;
     }
 
-    /* Now load the image from the temporary file using OBS graphics */
-    obs_enter_graphics();
+    char           *title_id      = g_game_cover.pending_title_id;
+    cover_pixels_t *pixels        = g_game_cover.pending_pixels;
+    g_game_cover.pending_title_id = NULL;
+    g_game_cover.pending_pixels   = NULL;
+    g_game_cover.must_reload      = false;
 
-    /* Free existing texture */
-    if (g_game_cover.image_texture) {
-        gs_texture_destroy(g_game_cover.image_texture);
-        g_game_cover.image_texture = NULL;
-    }
+    /* Only the graphics thread modifies the list: the cover cannot appear while the mutex is released */
+    bool is_uploaded = title_id && find_texture(title_id, NULL) != NULL;
+
+    pthread_mutex_unlock(&g_game_cover.mutex);
 
-    if (strlen(g_game_cover.image_path) > 0) {
-        g_game_cover.image_texture = gs_texture_create_from_file(g_game_cover.image_path);
+    cover_texture_t *created    = NULL;
+    bool             has_pixels = pixels != NULL;
+
+    if (!is_uploaded && title_id && pixels) {
+        created = create_texture(title_id, pixels);
+
+        if (created) {
+            title_id = NULL;
+        }
     }
 
-    obs_leave_graphics();
+    free_pixels(&pixels);
+
+    pthread_mutex_lock(&g_game_cover.mutex);
 
-    g_game_cover.must_reload = false;
+    cover_texture_t **link    = NULL;
+    cover_texture_t  *texture = created;
 
-    /* Clean up temp file */
-    remove(g_game_cover.image_path);
+    if (texture) {
+        texture->next         = g_game_cover.textures;
+        g_game_cover.textures = texture;
+        g_game_cover.texture_bytes += texture->size;
+
+    } else if (is_uploaded && (texture = find_texture(title_id, &link)) != NULL) {
+        /* Already uploaded: becomes the most recently used */
+        *link                 = texture->next;
+        texture->next         = g_game_cover.textures;
+        g_game_cover.textures = texture;
+    }
 
-    if (g_game_cover.image_texture) {
-        obs_log(LOG_INFO, "New image has been successfully loaded from the file");
+    if (texture || !title_id || has_pixels) {
+        g_game_cover.current = texture;
     } else {
-        obs_log(LOG_WARNING, "Failed to create texture from the file");
+        /* The cover of the request is spared from eviction: should it still be gone, the current one stays */
+        obs_log(LOG_WARNING, "The cover of game %s is no longer uploaded: keeping the current one", title_id);
     }
+
+    cover_texture_t *evicted = evict_textures();
+
+    pthread_mutex_unlock(&g_game_cover.mutex);
+
+    destroy_textures(evicted);
+    bfree(title_id);
+}
+
+/**
+ * @brief Destroy every cover texture.
+ *
+ * The textures are unlinked under the mutex and destroyed once it is released.
+ * Must be called from a context where entering/leaving graphics is allowed.
+ */
+static void free_textures(void) {
+
+    pthread_mutex_lock(&g_game_cover.mutex);
+
+    cover_texture_t *textures  = g_game_cover.textures;
+    g_game_cover.textures      = NULL;
+    g_game_cover.texture_bytes = 0;
+    g_game_cover.current       = NULL;
+
+    pthread_mutex_unlock(&g_game_cover.mutex);
+
+    destroy_textures(textures);
 }
 
 //  --------------------------------------------------------------------------------------------------------------------
@@ -163,7 +546,8 @@ static void load_texture_from_file() {
 /**
  * @brief Event handler called when a new game starts being played.
  *
- * Fetches the cover-art URL for the given game and triggers a download.
+ * Shows the cover texture of the game if it is still uploaded; otherwise fetches
+ * the cover-art URL for the given game and triggers a download.
  *
  * @param game Currently played game information.
  */
@@ -173,8 +557,13 @@ static void on_xbox_game_played(const game_t *game) {
     snprintf(text, 4096, "Playing game %s (%s)", game->title, game->id);
     obs_log(LOG_INFO, text);
 
-    const char *game_cover_url = xbox_get_game_cover(game);
-    download_box_art_from_url(game_cover_url);
+    if (set_pending_uploaded_cover(game->id)) {
+        return;
+    }
+
+    char *game_cover_url = xbox_get_game_cover(game);
+    load_box_art_from_url(game->id, game_cover_url);
+    bfree(game_cover_url);
 }
 
 /**
@@ -192,8 +581,7 @@ static void on_connection_changed(bool is_connected, const char *error_message)
     if (is_connected) {
         obs_log(LOG_INFO, "Connected to Xbox Live - waiting for game played events");
     } else {
-        g_game_cover.image_path[0] = '\0';
-        g_game_cover.must_reload   = true;
+        set_pending_cover(NULL, NULL);
     }
 }
 
@@ -221,22 +609,56 @@ static const char *source_get_name(void *unused) {
     return "Xbox Game Cover";
 }
 
+/**
+ * @brief OBS callback invoked when source settings change.
+ *
+ * Applies the VRAM budget of the cover textures.
+ */
+static void on_source_update(void *data, obs_data_t *settings) {
+
+    UNUSED_PARAMETER(data);
+
+    long long budget_mb = obs_data_get_int(settings, TEXTURE_BUDGET_SETTING);
+
+    if (budget_mb <= 0) {
+        budget_mb = DEFAULT_TEXTURE_BUDGET_MB;
+    }
+
+    /* Applied when the next cover is uploaded */
+    pthread_mutex_lock(&g_game_cover.mutex);
+    g_game_cover.texture_budget = (size_t)budget_mb * 1024 * 1024;
+    pthread_mutex_unlock(&g_game_cover.mutex);
+}
+
+/**
+ * @brief OBS callback providing the default settings.
+ */
+static void source_get_defaults(obs_data_t *settings) {
+    obs_data_set_default_int(settings, TEXTURE_BUDGET_SETTING, DEFAULT_TEXTURE_BUDGET_MB);
+}
+
 /**
  * @brief OBS callback creating a new source instance.
  *
- * @param settings OBS settings object (currently unused).
+ * @param settings OBS settings object.
  * @param source   OBS source instance.
  * @return Newly allocated xbox_game_cover_source_t.
  */
 static void *on_source_create(obs_data_t *settings, obs_source_t *source) {
 
-    UNUSED_PARAMETER(settings);
-
     xbox_game_cover_source_t *s = bzalloc(sizeof(*s));
     s->source                   = source;
     s->width                    = 800;
     s->height                   = 200;
 
+    /* Covers are scaled to the size they are drawn at */
+    pthread_mutex_lock(&g_game_cover.mutex);
+    g_game_cover.target_width  = s->width;
+    g_game_cover.target_height = s->height;
+    pthread_mutex_unlock(&g_game_cover.mutex);
+
+    on_source_update(s, settings);
+
     return s;
 }
 
@@ -254,36 +676,11 @@ static void on_source_destroy(void *data) {
     }
 
     /* Free image resources */
-    if (g_game_cover.image_texture) {
-        obs_enter_graphics();
-        gs_texture_destroy(g_game_cover.image_texture);
-        obs_leave_graphics();
-    }
+    free_textures();
 
     bfree(source);
 }
 
-/**
- * @brief OBS callback invoked when source settings change.
- *
- * Currently unused (no editable settings).
- */
-static void on_source_update(void *data, obs_data_t *settings) {
-
-    UNUSED_PARAMETER(settings);
-    UNUSED_PARAMETER(data);
-
-    /*
-    xbox_game_cover_source_t *s = data;
-    const char               *t = obs_data_get_string(settings, "text");
-
-    bfree(s->text);
-    s->text = bstrdup(t ? t : "");
-
-    text_src_update_child(s);
-    */
-}
-
 /**
  * @brief OBS callback to render the source.
  *
@@ -297,12 +694,12 @@ static void on_source_video_render(void *data, gs_effect_t *effect) {
         return;
     }
 
-    /* Load image if needed (deferred load in graphics context) */
-    load_texture_from_file();
+    /* Upload the image if needed (deferred upload in graphics context) */
+    upload_pending_image();
 
     /* Render the image if we have a texture */
-    if (g_game_cover.image_texture) {
-        draw_texture(g_game_cover.image_texture, source->width, source->height, effect);
+    if (g_game_cover.current) {
+        draw_texture(g_game_cover.current->texture, source->width, source->height, effect);
     }
 }
 
@@ -316,7 +713,7 @@ static obs_properties_t *source_get_properties(void *data) {
     UNUSED_PARAMETER(data);
 
     /* Gets or refreshes the token */
-    const xbox_identity_t *xbox_identity = xbox_live_get_identity();
+    xbox_identity_t *xbox_identity = xbox_live_get_identity();
 
     /* Lists all the UI components of the properties page */
     obs_properties_t *p = obs_properties_create();
@@ -324,6 +721,7 @@ static obs_properties_t *source_get_properties(void *data) {
     if (xbox_identity != NULL) {
         char status[4096];
         snprintf(status, 4096, "Connected to your xbox account as %s", xbox_identity->gamertag);
+        free_identity(&xbox_identity);
 
         int64_t gamerscore = 0;
         xbox_fetch_gamerscore(&gamerscore);
@@ -334,13 +732,16 @@ static obs_properties_t *source_get_properties(void *data) {
         obs_properties_add_text(p, "connected_status_info", status, OBS_TEXT_INFO);
         obs_properties_add_text(p, "gamerscore_info", gamerscore_text, OBS_TEXT_INFO);
 
-        const game_t *game = get_current_game();
+        session_snapshot_t *snapshot = get_current_session_snapshot();
+        const game_t       *game     = snapshot ? snapshot->session->game : NULL;
 
         if (game) {
             char game_played[4096];
             snprintf(game_played, sizeof(game_played), "Playing %s (%s)", game->title, game->id);
             obs_properties_add_text(p, "game_played", game_played, OBS_TEXT_INFO);
         }
+
+        release_session_snapshot(&snapshot);
     } else {
         obs_properties_add_text(p,
                                 "disconnected_status_info",
@@ -348,6 +749,8 @@ static obs_properties_t *source_get_properties(void *data) {
                                 OBS_TEXT_INFO);
     }
 
+    obs_properties_add_int(p, TEXTURE_BUDGET_SETTING, "Cover textures budget (MB)", 1, 1024, 1);
+
     return p;
 }
 
@@ -366,6 +769,7 @@ static struct obs_source_info xbox_game_cover_source_info = {
     .get_properties = source_get_properties,
     .get_width      = source_get_width,
     .get_height     = source_get_height,
+    .get_defaults   = source_get_defaults,
     .video_tick     = NULL,
 };
 
@@ -390,6 +794,6 @@ void xbox_game_cover_source_register(void) {
 
     obs_register_source(xbox_game_cover_source_get());
 
-    xbox_subscribe_game_played(&on_xbox_game_played);
-    xbox_subscribe_connected_changed(&on_connection_changed);
+    xbox_subscribe_game_played(&on_xbox_game_played, XBOX_DELIVER_LATEST);
+    xbox_subscribe_connected_changed(&on_connection_changed, XBOX_DELIVER_ALL);
 }
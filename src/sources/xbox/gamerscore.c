@@ -122,9 +122,11 @@ static void on_connection_changed(bool is_connected, const char *error_message)
     UNUSED_PARAMETER(is_connected);
     UNUSED_PARAMETER(error_message);
 
-    const gamerscore_t *gamerscore = get_current_gamerscore();
+    session_snapshot_t *snapshot = get_current_session_snapshot();
 
-    update_gamerscore(gamerscore);
+    update_gamerscore(snapshot ? snapshot->session->gamerscore : NULL);
+
+    release_session_snapshot(&snapshot);
 }
 
 /**
@@ -359,6 +361,6 @@ void xbox_gamerscore_source_register(void) {
 
     load_font_sheet();
 
-    xbox_subscribe_connected_changed(&on_connection_changed);
-    xbox_subscribe_achievements_progressed(&on_achievements_progressed);
+    xbox_subscribe_connected_changed(&on_connection_changed, XBOX_DELIVER_ALL);
+    xbox_subscribe_achievements_progressed(&on_achievements_progressed, XBOX_DELIVER_LATEST);
 }
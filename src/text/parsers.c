@@ -2,7 +2,6 @@
 
 #include <obs-module.h>
 #include <cJSON.h>
-#include <cJSON_Utils.h>
 #include <string.h>
 #include <common/types.h>
 #include <diagnostics/log.h>
@@ -17,10 +16,13 @@
  *  - Extracting the currently played game (title/id) from presence messages.
  *  - Parsing achievement progression updates.
  *  - Parsing achievement metadata including media assets and Gamerscore rewards.
+ *  - Extracting the cover art of games from title hub responses.
  *
  * Allocation/ownership:
  *  - Returned structs are allocated with bzalloc().
- *  - Most strings returned by helpers are duplicated on the heap (bstrdup/strdup).
+ *  - Strings are duplicated on the heap with bstrdup().
+ *  - Achievements are stored in an achievement_catalog_t, a single block owning
+ *    the records and their text.
  *  - The caller owns returned objects and is responsible for freeing them.
  */
 
@@ -29,92 +31,386 @@
 //  --------------------------------------------------------------------------------------------------------------------
 
 /**
- * @brief Read a string value from an achievement object at a given index.
+ * @brief Check the type of a cJSON node.
  *
- * This helper builds a cJSON pointer of the form:
- *   /achievements/<achievement_index>/<property_name>
- * and returns a duplicated string.
+ * @param node Node to check. May be NULL.
+ * @param type One of the cJSON_* type constants.
+ * @return true if @p node is non-NULL and of the given type.
+ */
+static bool is_json_type(const cJSON *node, int type) {
+    return node && (node->type & 0xFF) == type;
+}
+
+/**
+ * @brief Space needed to store the achievements of a response in a catalog.
+ */
+typedef struct catalog_size {
+    size_t achievements;
+    size_t media_assets;
+    size_t rewards;
+    size_t text;
+} catalog_size_t;
+
+/**
+ * @brief Read the value of a string node.
  *
- * @param json_root          Parsed JSON root object.
- * @param achievement_index Index in the "achievements" array.
- * @param property_name     Property name to read.
- * @return Newly allocated string (caller must bfree()), or NULL if missing.
+ * @param node Node to read. May be NULL.
+ * @return The string (owned by @p node), or NULL if @p node is not a string.
  */
-static const char *get_node_string(cJSON *json_root, int achievement_index, const char *property_name) {
+static const char *get_json_string(const cJSON *node) {
 
-    char property_key[512] = "";
-    snprintf(property_key, sizeof(property_key), "/achievements/%d/%s", achievement_index, property_name);
+    if (!is_json_type(node, cJSON_String)) {
+        return NULL;
+    }
 
-    cJSON *property_node = cJSONUtils_GetPointer(json_root, property_key);
+    return node->valuestring;
+}
+
+/**
+ * @brief Read a boolean node.
+ *
+ * Some responses encode booleans as strings, so both true and "true" are accepted.
+ *
+ * @param node Node to read. May be NULL.
+ * @return true if the node is true or "true"; false otherwise.
+ */
+static bool get_json_bool(const cJSON *node) {
+
+    if (is_json_type(node, cJSON_True)) {
+        return true;
+    }
 
-    if (!property_node || !property_node->valuestring) {
+    const char *value = get_json_string(node);
+
+    return value && strcmp(value, "true") == 0;
+}
+
+/**
+ * @brief Store the value of a string node in a catalog, or measure it.
+ *
+ * @param node    Node to read. May be NULL.
+ * @param catalog Catalog to store the string in, or NULL to only measure it.
+ * @param size    Receives the text size when @p catalog is NULL.
+ * @return The stored string (or the node's own string while measuring), or NULL
+ *         if @p node is not a string.
+ */
+static const char *store_json_string(const cJSON *node, achievement_catalog_t *catalog, catalog_size_t *size) {
+
+    const char *value = get_json_string(node);
+
+    if (!value) {
         return NULL;
     }
 
-    return bstrdup(property_node->valuestring);
+    if (!catalog) {
+        size->text += strlen(value) + 1;
+        return value;
+    }
+
+    return achievement_catalog_store_text(catalog, value);
+}
+
+/**
+ * @brief Read the media assets of an achievement.
+ *
+ * @param media_assets_node "mediaAssets" array of an achievement. May be NULL.
+ * @param catalog           Catalog to add the media assets to, or NULL to only measure them.
+ * @param size              Receives the measured sizes when @p catalog is NULL.
+ * @param achievement       Achievement owning the media assets.
+ */
+static void visit_media_assets(const cJSON           *media_assets_node,
+                               achievement_catalog_t *catalog,
+                               catalog_size_t        *size,
+                               achievement_t         *achievement) {
+
+    if (!is_json_type(media_assets_node, cJSON_Array)) {
+        return;
+    }
+
+    for (const cJSON *media_asset_node = media_assets_node->child; media_asset_node;
+         media_asset_node              = media_asset_node->next) {
+
+        const char *url = get_json_string(cJSON_GetObjectItemCaseSensitive(media_asset_node, "url"));
+
+        if (!url) {
+            continue;
+        }
+
+        if (!catalog) {
+            size->media_assets++;
+            size->text += strlen(url) + 1;
+            continue;
+        }
+
+        achievement_catalog_add_media_asset(catalog, achievement, url);
+    }
 }
 
 /**
- * @brief Read a boolean value stored as a string from an achievement object.
+ * @brief Read the Gamerscore rewards of an achievement.
  *
- * Some responses encode booleans as strings. This helper reads the string value
- * and returns true if it equals "true".
+ * Rewards of any other type (in-game items, art...) are ignored.
  *
- * @param json_root          Parsed JSON root object.
- * @param achievement_index Index in the "achievements" array.
- * @param property_name     Property name to read.
- * @return true if the underlying value equals "true"; false otherwise.
+ * @param rewards_node "rewards" array of an achievement. May be NULL.
+ * @param catalog      Catalog to add the rewards to, or NULL to only measure them.
+ * @param size         Receives the measured sizes when @p catalog is NULL.
+ * @param achievement  Achievement owning the rewards.
  */
-static bool get_node_bool(cJSON *json_root, int achievement_index, const char *property_name) {
+static void visit_rewards(const cJSON           *rewards_node,
+                          achievement_catalog_t *catalog,
+                          catalog_size_t        *size,
+                          achievement_t         *achievement) {
 
-    const char *property_value = get_node_string(json_root, achievement_index, property_name);
+    if (!is_json_type(rewards_node, cJSON_Array)) {
+        return;
+    }
 
-    if (!property_value) {
-        return false;
+    for (const cJSON *reward_node = rewards_node->child; reward_node; reward_node = reward_node->next) {
+
+        const char *type = get_json_string(cJSON_GetObjectItemCaseSensitive(reward_node, "type"));
+
+        if (!type || strcasecmp(type, "Gamerscore") != 0) {
+            /* Ignores the non-gamerscore reward */
+            continue;
+        }
+
+        const char *value = get_json_string(cJSON_GetObjectItemCaseSensitive(reward_node, "value"));
+
+        if (!value) {
+            continue;
+        }
+
+        if (!catalog) {
+            size->rewards++;
+            size->text += strlen(value) + 1;
+            continue;
+        }
+
+        achievement_catalog_add_reward(catalog, achievement, value);
+    }
+}
+
+/**
+ * @brief Read one entry of the "achievements" array.
+ *
+ * The same walk is used twice: first to measure the response (@p catalog is
+ * NULL), then to fill a catalog sized from that measure. The members of the
+ * entry are visited once, whatever their order, instead of being looked up one
+ * by one. Entries without an id are ignored.
+ *
+ * @param achievement_node Achievement object.
+ * @param catalog          Catalog to add the achievement to, or NULL to only measure it.
+ * @param size             Receives the measured sizes when @p catalog is NULL.
+ */
+static void visit_achievement_node(const cJSON *achievement_node, achievement_catalog_t *catalog, catalog_size_t *size) {
+
+    if (!is_json_type(achievement_node, cJSON_Object)) {
+        return;
     }
 
-    return strcmp(property_value, "true") == 0;
+    const char *id = get_json_string(cJSON_GetObjectItemCaseSensitive(achievement_node, "id"));
+
+    if (!id) {
+        obs_log(LOG_DEBUG, "Ignoring an achievement without id");
+        return;
+    }
+
+    /* While measuring, the fields are collected into a throwaway record */
+    achievement_t  measured_achievement = {0};
+    achievement_t *achievement          = &measured_achievement;
+
+    if (catalog) {
+        achievement = achievement_catalog_add(catalog, id);
+
+        if (!achievement) {
+            return;
+        }
+    } else {
+        size->achievements++;
+        size->text += strlen(id) + 1;
+    }
+
+    bool media_assets_visited = false;
+    bool rewards_visited      = false;
+
+    for (const cJSON *member = achievement_node->child; member; member = member->next) {
+
+        const char *key = member->string;
+
+        if (!key) {
+            continue;
+        }
+
+        if (!achievement->service_config_id && strcmp(key, "serviceConfigId") == 0) {
+            achievement->service_config_id = store_json_string(member, catalog, size);
+        } else if (!achievement->name && strcmp(key, "name") == 0) {
+            achievement->name = store_json_string(member, catalog, size);
+        } else if (!achievement->progress_state && strcmp(key, "progressState") == 0) {
+            achievement->progress_state = store_json_string(member, catalog, size);
+        } else if (!achievement->description && strcmp(key, "description") == 0) {
+            achievement->description = store_json_string(member, catalog, size);
+        } else if (!achievement->locked_description && strcmp(key, "lockedDescription") == 0) {
+            achievement->locked_description = store_json_string(member, catalog, size);
+        } else if (strcmp(key, "isSecret") == 0) {
+            achievement->is_secret = get_json_bool(member);
+        } else if (!media_assets_visited && strcmp(key, "mediaAssets") == 0) {
+            visit_media_assets(member, catalog, size, achievement);
+            media_assets_visited = true;
+        } else if (!rewards_visited && strcmp(key, "rewards") == 0) {
+            visit_rewards(member, catalog, size, achievement);
+            rewards_visited = true;
+        }
+    }
 }
 
 /**
- * @brief Check whether a given JSON pointer exists in the document.
+ * @brief Pick the cover art of a title hub title.
  *
- * Parses @p json_string and uses cJSONUtils_GetPointer with @p node_key.
+ * The first poster or box art image wins; the display image is used when the
+ * title has neither.
  *
- * @param json_string JSON message text.
- * @param node_key    cJSON pointer string (e.g. "/presenceDetails").
- * @return true if the node exists; false otherwise.
+ * @param title_node Title object of a title hub response.
+ * @return The URL (owned by @p title_node), or NULL if the title has no image.
  */
-static bool contains_node(const char *json_string, const char *node_key) {
+static const char *get_title_cover_url(const cJSON *title_node) {
 
-    cJSON *json_message  = NULL;
-    cJSON *node          = NULL;
-    bool   contains_node = false;
+    const cJSON *images_node = cJSON_GetObjectItemCaseSensitive(title_node, "images");
+
+    if (is_json_type(images_node, cJSON_Array)) {
+
+        for (const cJSON *image_node = images_node->child; image_node; image_node = image_node->next) {
+
+            const char *type = get_json_string(cJSON_GetObjectItemCaseSensitive(image_node, "type"));
+            const char *url  = get_json_string(cJSON_GetObjectItemCaseSensitive(image_node, "url"));
+
+            if (!type || (strcmp(type, "poster") != 0 && strcmp(type, "boxart") != 0)) {
+                continue;
+            }
+
+            if (url && *url) {
+                return url;
+            }
+        }
+    }
+
+    return get_json_string(cJSON_GetObjectItemCaseSensitive(title_node, "displayImage"));
+}
+
+/**
+ * @brief Parse a JSON message and run a node-based parser on it.
+ *
+ * Shared plumbing for the string-based wrappers: validates and parses
+ * @p json_string once and hands the root node to @p parse_node.
+ *
+ * @param json_string JSON message text.
+ * @param parse_node  Node-based parser to run on the parsed root.
+ * @return Whatever @p parse_node returns, or NULL if the text cannot be parsed.
+ */
+static void *parse_json_string(const char *json_string, void *(*parse_node)(const cJSON *)) {
 
     if (!json_string || strlen(json_string) == 0) {
-        goto cleanup;
+        return NULL;
     }
 
-    json_message = cJSON_Parse(json_string);
+    cJSON *json_root = cJSON_Parse(json_string);
 
-    if (!json_message) {
-        goto cleanup;
+    if (!json_root) {
+        return NULL;
     }
 
-    node = cJSONUtils_GetPointer(json_message, node_key);
+    void *result = parse_node(json_root);
+
+    FREE_JSON(json_root);
+
+    return result;
+}
+
+static void *parse_game_node(const cJSON *json_root) {
+    return parse_game_from_node(json_root);
+}
+
+static void *parse_achievement_progress_node(const cJSON *json_root) {
+    return parse_achievement_progress_from_node(json_root);
+}
+
+static void *parse_achievement_catalog_node(const cJSON *json_root) {
+    return parse_achievement_catalog_from_node(json_root);
+}
+
+static void *parse_game_cover_url_node(const cJSON *json_root) {
+
+    const cJSON *titles_node = cJSON_GetObjectItemCaseSensitive(json_root, "titles");
+
+    if (!is_json_type(titles_node, cJSON_Array)) {
+        return NULL;
+    }
+
+    const char *url = get_title_cover_url(titles_node->child);
+
+    return url ? bstrdup(url) : NULL;
+}
+
+static void *parse_recent_titles_node(const cJSON *json_root) {
+
+    const cJSON *titles_node = cJSON_GetObjectItemCaseSensitive(json_root, "titles");
+
+    if (!is_json_type(titles_node, cJSON_Array)) {
+        return NULL;
+    }
+
+    recent_title_t  *titles = NULL;
+    recent_title_t **tail   = &titles;
+
+    for (const cJSON *title_node = titles_node->child; title_node; title_node = title_node->next) {
+
+        const char *id        = get_json_string(cJSON_GetObjectItemCaseSensitive(title_node, "titleId"));
+        const char *name      = get_json_string(cJSON_GetObjectItemCaseSensitive(title_node, "name"));
+        const char *cover_url = get_title_cover_url(title_node);
+
+        if (!id || !*id) {
+            continue;
+        }
 
-    contains_node = node != NULL;
+        recent_title_t *title = bzalloc(sizeof(recent_title_t));
+        title->id             = bstrdup(id);
+        title->title          = bstrdup(name ? name : "");
+        title->cover_url      = cover_url && *cover_url ? bstrdup(cover_url) : NULL;
 
-cleanup:
-    FREE_JSON(json_message);
+        *tail = title;
+        tail  = &title->next;
+    }
 
-    return contains_node;
+    return titles;
 }
 
 //  --------------------------------------------------------------------------------------------------------------------
 //  Public functions
 //  --------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @brief Classify an already-parsed RTA message.
+ *
+ * Presence messages carry a top-level "presenceDetails" node while achievement
+ * messages carry a top-level "serviceConfigId" node. Only direct children of
+ * @p message are inspected, so this never walks nested content.
+ */
+rta_message_type_t get_rta_message_type(const cJSON *message) {
+
+    if (!is_json_type(message, cJSON_Object)) {
+        return RTA_MESSAGE_UNKNOWN;
+    }
+
+    if (cJSON_GetObjectItemCaseSensitive(message, "presenceDetails")) {
+        return RTA_MESSAGE_PRESENCE;
+    }
+
+    if (cJSON_GetObjectItemCaseSensitive(message, "serviceConfigId")) {
+        return RTA_MESSAGE_ACHIEVEMENT;
+    }
+
+    return RTA_MESSAGE_UNKNOWN;
+}
+
 /**
  * @brief Determine if a message looks like an achievement message.
  *
@@ -122,7 +418,16 @@ cleanup:
  */
 bool is_achievement_message(const char *json_string) {
 
-    return contains_node(json_string, "/serviceConfigId");
+    if (!json_string || strlen(json_string) == 0) {
+        return false;
+    }
+
+    cJSON *json_root = cJSON_Parse(json_string);
+    bool   result    = get_rta_message_type(json_root) == RTA_MESSAGE_ACHIEVEMENT;
+
+    FREE_JSON(json_root);
+
+    return result;
 }
 
 /**
@@ -132,44 +437,45 @@ bool is_achievement_message(const char *json_string) {
  */
 bool is_presence_message(const char *json_string) {
 
-    return contains_node(json_string, "/presenceDetails");
+    if (!json_string || strlen(json_string) == 0) {
+        return false;
+    }
+
+    cJSON *json_root = cJSON_Parse(json_string);
+    bool   result    = get_rta_message_type(json_root) == RTA_MESSAGE_PRESENCE;
+
+    FREE_JSON(json_root);
+
+    return result;
 }
 
 /**
- * @brief Parse the played game information out of a presence message.
+ * @brief Parse the played game information out of an already-parsed presence message.
  *
- * This inspects up to the first few entries of "/presenceDetails" and returns
- * the first entry marked as a game ("isGame" true), then reads presenceText and
+ * This inspects up to the first few entries of "presenceDetails" and keeps the
+ * last entry marked as a game ("isGame" true), then reads presenceText and
  * titleId.
  *
- * @param json_string Presence JSON message.
- * @return Newly allocated game_t on success; NULL if no game is found or parsing fails.
+ * @param json_root Parsed presence message.
+ * @return Newly allocated game_t on success; NULL if no game is found.
  */
-game_t *parse_game(const char *json_string) {
-
-    cJSON  *json_root = NULL;
-    game_t *game      = NULL;
+game_t *parse_game_from_node(const cJSON *json_root) {
 
-    if (!json_string || strlen(json_string) == 0) {
-        return NULL;
-    }
+    const cJSON *presence_details = cJSON_GetObjectItemCaseSensitive(json_root, "presenceDetails");
 
-    json_root = cJSON_Parse(json_string);
-
-    if (!json_root) {
+    if (!is_json_type(presence_details, cJSON_Array)) {
         return NULL;
     }
 
-    char current_game_title[128] = "";
-    char current_game_id[128]    = "";
+    const char *current_game_title = NULL;
+    const char *current_game_id    = NULL;
 
-    for (int detail_index = 0; detail_index < 3; detail_index++) {
+    int          detail_index = 0;
+    const cJSON *detail       = presence_details->child;
 
-        /* Finds out if there is anything at this index */
-        char is_game_key[512] = "";
-        snprintf(is_game_key, sizeof(is_game_key), "/presenceDetails/%d/isGame", detail_index);
+    for (; detail && detail_index < 3; detail = detail->next, detail_index++) {
 
-        cJSON *is_game_value = cJSONUtils_GetPointer(json_root, is_game_key);
+        const cJSON *is_game_value = cJSON_GetObjectItemCaseSensitive(detail, "isGame");
 
         if (!is_game_value) {
             /* There is nothing more */
@@ -177,292 +483,212 @@ game_t *parse_game(const char *json_string) {
             break;
         }
 
-        if (is_game_value->type == cJSON_False) {
+        if (is_json_type(is_game_value, cJSON_False)) {
             /* This is not a game: most likely the xbox home */
-            obs_log(LOG_DEBUG, "No game at %d. Is game = %s", detail_index, is_game_value->valuestring);
+            obs_log(LOG_DEBUG, "No game at %d", detail_index);
             continue;
         }
 
-        obs_log(LOG_DEBUG, "Game at %d. Is game = %s", detail_index, is_game_value->valuestring);
-
         /* Retrieve the game title and its ID */
-        char game_title_key[512];
-        snprintf(game_title_key, sizeof(game_title_key), "/presenceDetails/%d/presenceText", detail_index);
-
-        cJSON *game_title_value = cJSONUtils_GetPointer(json_root, game_title_key);
-
-        obs_log(LOG_DEBUG, "Game title: %s %s", game_title_value->string, game_title_value->valuestring);
-
-        char game_id_key[512];
-        snprintf(game_id_key, sizeof(game_id_key), "/presenceDetails/%d/titleId", detail_index);
+        const cJSON *game_title_value = cJSON_GetObjectItemCaseSensitive(detail, "presenceText");
+        const cJSON *game_id_value    = cJSON_GetObjectItemCaseSensitive(detail, "titleId");
 
-        cJSON *game_id_value = cJSONUtils_GetPointer(json_root, game_id_key);
+        if (!is_json_type(game_id_value, cJSON_String)) {
+            obs_log(LOG_DEBUG, "No title ID at %d", detail_index);
+            continue;
+        }
 
-        obs_log(LOG_DEBUG, "Game ID: %s %s", game_id_value->string, game_id_value->valuestring);
+        current_game_id    = game_id_value->valuestring;
+        current_game_title = is_json_type(game_title_value, cJSON_String) ? game_title_value->valuestring : "";
 
-        snprintf(current_game_title, sizeof(current_game_title), "%s", game_title_value->valuestring);
-        snprintf(current_game_id, sizeof(current_game_id), "%s", game_id_value->valuestring);
+        obs_log(LOG_DEBUG, "Game at %d: %s (%s)", detail_index, current_game_title, current_game_id);
     }
 
-    if (strlen(current_game_id) == 0) {
+    if (!current_game_id || strlen(current_game_id) == 0) {
         obs_log(LOG_DEBUG, "No game found");
-        goto cleanup;
+        return NULL;
     }
 
     obs_log(LOG_DEBUG, "Game is %s (%s)", current_game_title, current_game_id);
 
-    game        = bzalloc(sizeof(game_t));
-    game->id    = strdup(current_game_id);
-    game->title = strdup(current_game_title);
-
-cleanup:
-    FREE_JSON(json_root);
+    game_t *game = bzalloc(sizeof(game_t));
+    game->id     = bstrdup(current_game_id);
+    game->title  = bstrdup(current_game_title);
 
     return game;
 }
 
 /**
- * @brief Parse achievement progression updates.
+ * @brief Parse the played game information out of a presence message.
  *
- * Iterates the "/progression" array and builds a linked list of
+ * @param json_string Presence JSON message.
+ * @return Newly allocated game_t on success; NULL if no game is found or parsing fails.
+ */
+game_t *parse_game(const char *json_string) {
+
+    return parse_json_string(json_string, parse_game_node);
+}
+
+/**
+ * @brief Parse achievement progression updates out of an already-parsed message.
+ *
+ * Iterates the "progression" array and builds a linked list of
  * achievement_progress_t elements.
  *
- * @param json_string Achievement progression JSON message.
+ * @param json_root Parsed achievement progression message.
  * @return Head of a newly allocated linked list, or NULL on failure/no items.
  */
-achievement_progress_t *parse_achievement_progress(const char *json_string) {
+achievement_progress_t *parse_achievement_progress_from_node(const cJSON *json_root) {
 
-    cJSON                  *json_root            = NULL;
     achievement_progress_t *achievement_progress = NULL;
+    achievement_progress_t *last_progress        = NULL;
 
-    if (!json_string || strlen(json_string) == 0) {
-        return NULL;
-    }
-
-    json_root = cJSON_Parse(json_string);
+    const cJSON *service_config_node = cJSON_GetObjectItemCaseSensitive(json_root, "serviceConfigId");
 
-    if (!json_root) {
+    if (!is_json_type(service_config_node, cJSON_String)) {
         return NULL;
     }
 
-    cJSON *service_config_node = cJSONUtils_GetPointer(json_root, "/serviceConfigId");
+    const cJSON *progression = cJSON_GetObjectItemCaseSensitive(json_root, "progression");
 
-    if (!service_config_node) {
-        goto cleanup;
+    if (!is_json_type(progression, cJSON_Array)) {
+        return NULL;
     }
 
-    char current_service_config_id[128] = "";
-    snprintf(current_service_config_id, sizeof(current_service_config_id), "%s", service_config_node->valuestring);
+    int          detail_index = 0;
+    const cJSON *detail       = progression->child;
 
-    for (int detail_index = 0; detail_index < 3; detail_index++) {
+    for (; detail && detail_index < 3; detail = detail->next, detail_index++) {
 
-        /* Finds out if there is anything at this index */
-        char id_key[512] = "";
-        snprintf(id_key, sizeof(id_key), "/progression/%d/id", detail_index);
+        const cJSON *id_node = cJSON_GetObjectItemCaseSensitive(detail, "id");
 
-        cJSON *id_node = cJSONUtils_GetPointer(json_root, id_key);
-
-        if (!id_node) {
+        if (!is_json_type(id_node, cJSON_String)) {
             /* There is nothing more */
             obs_log(LOG_DEBUG, "No more progression at %d", detail_index);
             break;
         }
 
-        char progress_state_key[512] = "";
-        snprintf(progress_state_key, sizeof(progress_state_key), "/progression/%d/progressState", detail_index);
-
-        cJSON *progress_state_node = cJSONUtils_GetPointer(json_root, progress_state_key);
+        const cJSON *progress_state_node = cJSON_GetObjectItemCaseSensitive(detail, "progressState");
 
-        if (!progress_state_node) {
-            /* This is not a game: most likely the xbox home */
+        if (!is_json_type(progress_state_node, cJSON_String)) {
             obs_log(LOG_DEBUG, "No progress at %d. No progress state", detail_index);
             continue;
         }
 
         achievement_progress_t *progress = bzalloc(sizeof(achievement_progress_t));
-        progress->service_config_id      = strdup(current_service_config_id);
-        progress->id                     = strdup(id_node->valuestring);
-        progress->progress_state         = strdup(progress_state_node->valuestring);
+        progress->service_config_id      = bstrdup(service_config_node->valuestring);
+        progress->id                     = bstrdup(id_node->valuestring);
+        progress->progress_state         = bstrdup(progress_state_node->valuestring);
         progress->next                   = NULL;
 
-        if (!achievement_progress) {
+        if (!last_progress) {
             achievement_progress = progress;
         } else {
-            achievement_progress_t *last_progress = achievement_progress;
-            while (last_progress->next) {
-                last_progress = last_progress->next;
-            }
             last_progress->next = progress;
         }
-    }
 
-cleanup:
-    FREE_JSON(json_root);
+        last_progress = progress;
+    }
 
     return achievement_progress;
 }
 
 /**
- * @brief Parse full achievement metadata.
+ * @brief Parse achievement progression updates.
  *
- * Iterates over the "/achievements" array and builds a linked list of
- * achievement_t elements.
+ * @param json_string Achievement progression JSON message.
+ * @return Head of a newly allocated linked list, or NULL on failure/no items.
+ */
+achievement_progress_t *parse_achievement_progress(const char *json_string) {
+
+    return parse_json_string(json_string, parse_achievement_progress_node);
+}
+
+/**
+ * @brief Parse full achievement metadata out of an already-parsed response.
  *
- * For each achievement it extracts:
+ * For each entry of the "achievements" array it extracts:
  *  - basic metadata (id, serviceConfigId, name, descriptions, progressState)
  *  - isSecret
  *  - mediaAssets[] (urls)
  *  - rewards[] filtered to Gamerscore rewards
  *
- * @param json_string Achievements JSON message.
- * @return Head of a newly allocated linked list, or NULL on failure/no items.
+ * The array is walked twice with its child/next links: once to measure the
+ * records and text, once to fill a catalog allocated in one block from that
+ * measure. The cost is linear in the size of the response.
+ *
+ * @param json_root Parsed achievements response.
+ * @return Newly allocated catalog, or NULL on failure/no items.
  */
-achievement_t *parse_achievements(const char *json_string) {
+achievement_catalog_t *parse_achievement_catalog_from_node(const cJSON *json_root) {
 
-    cJSON         *json_root    = NULL;
-    achievement_t *achievements = NULL;
+    const cJSON *achievements_node = cJSON_GetObjectItemCaseSensitive(json_root, "achievements");
 
-    if (!json_string || strlen(json_string) == 0) {
+    if (!is_json_type(achievements_node, cJSON_Array)) {
         return NULL;
     }
 
-    json_root = cJSON_Parse(json_string);
+    catalog_size_t size = {0};
 
-    if (!json_root) {
-        return NULL;
+    for (const cJSON *achievement_node = achievements_node->child; achievement_node;
+         achievement_node              = achievement_node->next) {
+        visit_achievement_node(achievement_node, NULL, &size);
     }
 
-    for (int achievement_index = 0;; achievement_index++) {
-
-        const char *id = get_node_string(json_root, achievement_index, "id");
-
-        if (!id) {
-            /* There is nothing more */
-            obs_log(LOG_DEBUG, "No more achievement at %d", achievement_index);
-            break;
-        }
-
-        achievement_t *achievement      = bzalloc(sizeof(achievement_t));
-        achievement->id                 = id;
-        achievement->service_config_id  = get_node_string(json_root, achievement_index, "serviceConfigId");
-        achievement->name               = get_node_string(json_root, achievement_index, "name");
-        achievement->progress_state     = get_node_string(json_root, achievement_index, "progressState");
-        achievement->description        = get_node_string(json_root, achievement_index, "description");
-        achievement->locked_description = get_node_string(json_root, achievement_index, "lockedDescription");
-        achievement->is_secret          = get_node_bool(json_root, achievement_index, "isSecret");
-
-        /* Reads the media assets */
-        media_asset_t *media_assets = NULL;
-
-        for (int media_asset_index = 0;; media_asset_index++) {
-
-            char media_asset_url_key[512] = "";
-            snprintf(media_asset_url_key,
-                     sizeof(media_asset_url_key),
-                     "/achievements/%d/mediaAssets/%d/url",
-                     achievement_index,
-                     media_asset_index);
-
-            cJSON *media_asset_url_node = cJSONUtils_GetPointer(json_root, media_asset_url_key);
-
-            if (!media_asset_url_node) {
-                /* There is nothing more */
-                obs_log(LOG_DEBUG, "No more media asset at %d/%d", achievement_index, media_asset_index);
-                break;
-            }
-
-            media_asset_t *media_asset = bzalloc(sizeof(media_asset_t));
-            media_asset->url           = bstrdup(media_asset_url_node->valuestring);
-            media_asset->next          = NULL;
-
-            if (!media_assets) {
-                media_assets = media_asset;
-            } else {
-                media_asset_t *last_media_asset = media_assets;
-                while (last_media_asset->next) {
-                    last_media_asset = last_media_asset->next;
-                }
-                last_media_asset->next = media_asset;
-            }
-        }
-
-        achievement->media_assets = media_assets;
-
-        /* Reads the rewards */
-        reward_t *rewards = NULL;
-
-        for (int reward_index = 0;; reward_index++) {
-
-            char reward_type_key[512] = "";
-            snprintf(reward_type_key,
-                     sizeof(reward_type_key),
-                     "/achievements/%d/rewards/%d/type",
-                     achievement_index,
-                     reward_index);
+    if (size.achievements == 0) {
+        return NULL;
+    }
 
-            cJSON *reward_type_node = cJSONUtils_GetPointer(json_root, reward_type_key);
+    achievement_catalog_t *catalog =
+        create_achievement_catalog(size.achievements, size.media_assets, size.rewards, size.text);
 
-            if (!reward_type_node) {
-                /* There is nothing more */
-                obs_log(LOG_DEBUG, "No more reward at %d/%d", achievement_index, reward_index);
-                break;
-            }
-
-            if (!reward_type_node->type || strcasecmp(reward_type_node->valuestring, "Gamerscore") != 0) {
-                /* Ignores the non-gamerscore reward */
-                obs_log(LOG_DEBUG, "Not a Gamerscore reward at %d/%d", achievement_index, reward_index);
-                continue;
-            }
+    if (!catalog) {
+        obs_log(LOG_ERROR, "Unable to allocate a catalog of %zu achievements", size.achievements);
+        return NULL;
+    }
 
-            char reward_value_key[512] = "";
-            snprintf(reward_value_key,
-                     sizeof(reward_value_key),
-                     "/achievements/%d/rewards/%d/value",
-                     achievement_index,
-                     reward_index);
+    for (const cJSON *achievement_node = achievements_node->child; achievement_node;
+         achievement_node              = achievement_node->next) {
+        visit_achievement_node(achievement_node, catalog, NULL);
+    }
 
-            cJSON *reward_value_node = cJSONUtils_GetPointer(json_root, reward_value_key);
+    obs_log(LOG_DEBUG, "%zu achievements parsed", achievement_catalog_count(catalog));
 
-            if (!reward_value_node) {
-                obs_log(LOG_DEBUG, "No value in reward at %d/%d", achievement_index, reward_index);
-                continue;
-            }
+    return catalog;
+}
 
-            reward_t *reward = bzalloc(sizeof(reward_t));
-            reward->value    = bstrdup(reward_value_node->valuestring);
-
-            if (!rewards) {
-                rewards = reward;
-            } else {
-                reward_t *last_reward = rewards;
-                while (last_reward->next) {
-                    last_reward = last_reward->next;
-                }
-                last_reward->next = reward;
-            }
-        }
+/**
+ * @brief Parse achievement definitions out of a JSON response.
+ *
+ * @param json_string Achievements JSON response.
+ * @return Newly allocated catalog, or NULL on failure/no items.
+ */
+achievement_catalog_t *parse_achievement_catalog(const char *json_string) {
 
-        achievement->rewards = rewards;
+    return parse_json_string(json_string, parse_achievement_catalog_node);
+}
 
-        obs_log(LOG_INFO,
-                "%s | Achievement %s (%s G) is %s",
-                achievement->service_config_id,
-                achievement->name,
-                achievement->rewards ? achievement->rewards->value : "no reward",
-                achievement->progress_state);
+/**
+ * @brief Extract the cover art URL out of a title hub decoration/image response.
+ *
+ * @param json_string Title hub JSON response.
+ * @return Newly allocated URL (caller must bfree()), or NULL if the title has no image.
+ */
+char *parse_game_cover_url(const char *json_string) {
 
-        if (!achievements) {
-            achievements = achievement;
-        } else {
-            achievement_t *last_achievement = achievements;
-            while (last_achievement->next) {
-                last_achievement = last_achievement->next;
-            }
-            last_achievement->next = achievement;
-        }
-    }
+    return parse_json_string(json_string, parse_game_cover_url_node);
+}
 
-    FREE_JSON(json_root);
+/**
+ * @brief Parse the titles of a title hub title history response.
+ *
+ * Titles without an id are skipped. The order of the response (most recently
+ * played first) is kept.
+ *
+ * @param json_string Title history JSON response.
+ * @return Head of a newly allocated list, or NULL on failure/no titles.
+ */
+recent_title_t *parse_recent_titles(const char *json_string) {
 
-    return achievements;
+    return parse_json_string(json_string, parse_recent_titles_node);
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <stdbool.h>
 #include <common/types.h>
+#include <cJSON.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,6 +29,29 @@ extern "C" {
  *    purpose JSON parsers.
  */
 
+/**
+ * @brief Kind of payload carried by an Xbox RTA event.
+ */
+typedef enum rta_message_type {
+    /** Not a message this plugin understands */
+    RTA_MESSAGE_UNKNOWN = 0,
+    /** Rich presence update (contains "presenceDetails") */
+    RTA_MESSAGE_PRESENCE,
+    /** Achievement progression update (contains "serviceConfigId") */
+    RTA_MESSAGE_ACHIEVEMENT,
+} rta_message_type_t;
+
+/**
+ * @brief Classify an already-parsed RTA message payload.
+ *
+ * Only the top-level keys of @p message are inspected, so this is cheap enough
+ * to run on every frame received by the monitor.
+ *
+ * @param message Parsed payload (element 2 of an RTA event frame). May be NULL.
+ * @return The message type, or RTA_MESSAGE_UNKNOWN.
+ */
+rta_message_type_t get_rta_message_type(const cJSON *message);
+
 /**
  * @brief Check whether a JSON message is a presence update.
  *
@@ -54,6 +78,17 @@ bool is_achievement_message(const char *json_string);
  */
 game_t *parse_game(const char *json_string);
 
+/**
+ * @brief Parse a game description from an already-parsed presence message.
+ *
+ * Same as parse_game() but skips the text parsing step. @p json_root is not
+ * modified and remains owned by the caller.
+ *
+ * @param json_root Parsed presence message.
+ * @return Newly allocated game_t on success; NULL on failure.
+ */
+game_t *parse_game_from_node(const cJSON *json_root);
+
 /**
  * @brief Parse achievement progress information from a JSON message.
  *
@@ -62,16 +97,60 @@ game_t *parse_game(const char *json_string);
  */
 achievement_progress_t *parse_achievement_progress(const char *json_string);
 
+/**
+ * @brief Parse achievement progress information from an already-parsed message.
+ *
+ * Same as parse_achievement_progress() but skips the text parsing step.
+ * @p json_root is not modified and remains owned by the caller.
+ *
+ * @param json_root Parsed achievement progression message.
+ * @return Newly allocated achievement_progress_t on success; NULL on failure.
+ */
+achievement_progress_t *parse_achievement_progress_from_node(const cJSON *json_root);
+
 /**
  * @brief Parse achievements information from a JSON message.
  *
- * Depending on the message type, this may represent a single achievement or a
- * container describing multiple achievements.
+ * The achievements are stored in a single-block catalog indexed by id.
+ *
+ * @param json_string NUL-terminated JSON string.
+ * @return Newly allocated catalog on success (free with free_achievement_catalog()); NULL on failure.
+ */
+achievement_catalog_t *parse_achievement_catalog(const char *json_string);
+
+/**
+ * @brief Parse achievements information from an already-parsed response.
+ *
+ * Same as parse_achievement_catalog() but skips the text parsing step.
+ * @p json_root is not modified and remains owned by the caller.
+ *
+ * @param json_root Parsed achievements response.
+ * @return Newly allocated catalog on success; NULL on failure.
+ */
+achievement_catalog_t *parse_achievement_catalog_from_node(const cJSON *json_root);
+
+/**
+ * @brief Extract the cover art URL of a game from a title hub response.
+ *
+ * The first poster or box art image of the first title is returned; its display
+ * image is used as a fallback.
+ *
+ * @param json_string NUL-terminated JSON string.
+ * @return Newly allocated URL on success (caller must bfree()); NULL on failure.
+ */
+char *parse_game_cover_url(const char *json_string);
+
+/**
+ * @brief Parse the recently played titles from a title history response.
+ *
+ * Each title carries the same cover art URL as parse_game_cover_url() would
+ * extract for it.
  *
  * @param json_string NUL-terminated JSON string.
- * @return Newly allocated achievement_t on success; NULL on failure.
+ * @return Newly allocated list, most recently played first (free with
+ *         free_recent_titles()); NULL on failure.
  */
-achievement_t *parse_achievements(const char *json_string);
+recent_title_t *parse_recent_titles(const char *json_string);
 
 #ifdef __cplusplus
 }
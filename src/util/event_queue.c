@@ -0,0 +1,154 @@
+#include "util/event_queue.h"
+
+#include <obs-module.h>
+#include <util/threading.h>
+
+#include <limits.h>
+
+/**
+ * @brief Slot of the ring.
+ *
+ * @c sequence tells whose turn it is: it equals the position of the next push
+ * expected in the slot when the slot is free, and that position + 1 once the slot
+ * holds an item waiting to be popped.
+ */
+typedef struct event_queue_cell {
+    volatile long sequence;
+    void         *item;
+} event_queue_cell_t;
+
+struct event_queue {
+    event_queue_cell_t *cells;
+    long                mask;
+
+    /** Position of the next push, shared by the producers */
+    volatile long push_position;
+
+    /** Position of the next pop, only used by the consumer */
+    long pop_position;
+};
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Signed distance between two positions, correct across wrap-around.
+ */
+static long distance(long from, long to) {
+    return (long)((unsigned long)to - (unsigned long)from);
+}
+
+/**
+ * @brief Moves a position forward, wrapping around instead of overflowing.
+ */
+static long advance(long position, long count) {
+    return (long)((unsigned long)position + (unsigned long)count);
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+event_queue_t *create_event_queue(size_t capacity) {
+
+    if (capacity == 0 || capacity > (size_t)LONG_MAX / 2) {
+        return NULL;
+    }
+
+    size_t cell_count = 2;
+
+    while (cell_count < capacity) {
+        cell_count *= 2;
+    }
+
+    event_queue_t *queue = bzalloc(sizeof(event_queue_t));
+
+    if (!queue) {
+        return NULL;
+    }
+
+    queue->cells = bzalloc(cell_count * sizeof(event_queue_cell_t));
+
+    if (!queue->cells) {
+        bfree(queue);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < cell_count; i++) {
+        queue->cells[i].sequence = (long)i;
+    }
+
+    queue->mask = (long)cell_count - 1;
+
+    return queue;
+}
+
+void free_event_queue(event_queue_t **queue) {
+
+    if (!queue || !*queue) {
+        return;
+    }
+
+    bfree((*queue)->cells);
+    bfree(*queue);
+    *queue = NULL;
+}
+
+bool event_queue_push(event_queue_t *queue, void *item) {
+
+    if (!queue || !item) {
+        return false;
+    }
+
+    long                position = os_atomic_load_long(&queue->push_position);
+    event_queue_cell_t *cell;
+
+    for (;;) {
+        cell = &queue->cells[position & queue->mask];
+
+        long turn = distance(position, os_atomic_load_long(&cell->sequence));
+
+        if (turn == 0) {
+            /* The slot is free: claim the position */
+            if (os_atomic_compare_swap_long(&queue->push_position, position, advance(position, 1))) {
+                break;
+            }
+        } else if (turn < 0) {
+            /* The slot still holds the item pushed one lap ago */
+            return false;
+        }
+
+        /* Another producer claimed the position first */
+        position = os_atomic_load_long(&queue->push_position);
+    }
+
+    cell->item = item;
+    os_atomic_store_long(&cell->sequence, advance(position, 1));
+
+    return true;
+}
+
+void *event_queue_pop(event_queue_t *queue) {
+
+    if (!queue) {
+        return NULL;
+    }
+
+    long                position = queue->pop_position;
+    event_queue_cell_t *cell     = &queue->cells[position & queue->mask];
+
+    if (distance(advance(position, 1), os_atomic_load_long(&cell->sequence)) < 0) {
+        /* Empty, or a producer claimed the slot but has not filled it yet */
+        return NULL;
+    }
+
+    void *item = cell->item;
+    cell->item = NULL;
+
+    /* Frees the slot for the push made one lap later */
+    os_atomic_store_long(&cell->sequence, advance(position, queue->mask + 1));
+    queue->pop_position = advance(position, 1);
+
+    return item;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Bounded, lock-free, multi-producer / single-consumer queue of pointers.
+ *
+ * Any number of threads may push concurrently; a single thread pops. Neither side
+ * ever takes a lock or waits: pushing to a full queue fails immediately and
+ * popping from an empty queue returns NULL. Waking the consumer up is left to the
+ * caller.
+ *
+ * Ownership:
+ * - Queues returned by @ref create_event_queue are owned by the caller and must
+ *   be freed with @ref free_event_queue.
+ * - The queue never owns the items it holds.
+ */
+typedef struct event_queue event_queue_t;
+
+/**
+ * @brief Creates an empty queue.
+ *
+ * @param capacity Minimum number of items the queue can hold. Rounded up to a
+ *        power of two.
+ *
+ * @return Newly allocated queue, or NULL if @p capacity is 0 or on allocation failure.
+ */
+event_queue_t *create_event_queue(size_t capacity);
+
+/**
+ * @brief Frees a queue and sets the caller's pointer to NULL.
+ *
+ * Items still queued are not freed: drain the queue first.
+ *
+ * @param[in,out] queue Address of the queue pointer to free.
+ */
+void free_event_queue(event_queue_t **queue);
+
+/**
+ * @brief Appends an item to the queue. Safe to call from any thread.
+ *
+ * @param queue Queue to append to.
+ * @param item Item to append (must not be NULL).
+ *
+ * @return false if the queue is full or an argument is NULL.
+ */
+bool event_queue_push(event_queue_t *queue, void *item);
+
+/**
+ * @brief Removes the oldest item of the queue. Must only be called by the consumer thread.
+ *
+ * @param queue Queue to pop from.
+ *
+ * @return The oldest item, or NULL if the queue is empty.
+ */
+void *event_queue_pop(event_queue_t *queue);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,257 @@
+#include "xbox/monitor_jobs.h"
+
+#include <obs-module.h>
+#include <diagnostics/log.h>
+
+#include "io/achievements_cache.h"
+#include "io/cover_cache.h"
+#include "xbox/xbox_client.h"
+
+/** Number of recently played games whose achievements and cover are prefetched */
+#define PREFETCH_TITLE_COUNT 10
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Tell whether a job only warms up the caches.
+ *
+ * Such jobs may block for a while (the cover is downloaded synchronously): they
+ * only run once no other job is waiting, so they never delay the work the user
+ * is waiting for.
+ */
+static bool is_background_job(const monitor_job_t *job) {
+    return job->type == MONITOR_JOB_PREFETCH_TITLE;
+}
+
+/**
+ * @brief Load the cached achievements of the game of a change game job, or
+ * request them if they are not cached. Runs on the worker thread.
+ */
+static void begin_get_game_achievements(monitor_job_t *job) {
+
+    if (!job->game) {
+        return;
+    }
+
+    job->achievements = achievements_cache_load(job->game->id, &job->etag, &job->last_modified);
+
+    if (job->achievements) {
+        /* Served from disk: the achievements are revalidated once the game is shown */
+        job->from_cache = true;
+        return;
+    }
+
+    job->request = xbox_begin_get_game_achievements(job->game);
+}
+
+/**
+ * @brief Request the achievements of a recently played game unless they are
+ * already cached. Runs on the worker thread.
+ */
+static void begin_prefetch_title(monitor_job_t *job) {
+
+    const recent_title_t *title = job->recent_titles;
+
+    if (!title || achievements_cache_contains(title->id)) {
+        return;
+    }
+
+    game_t game  = {.id = title->id, .title = title->title};
+    job->request = xbox_begin_get_game_achievements(&game);
+}
+
+/**
+ * @brief Store the achievements and cover of a recently played game in the
+ * caches. Runs on the worker thread.
+ */
+static void end_prefetch_title(monitor_job_t *job) {
+
+    const recent_title_t *title = job->recent_titles;
+
+    if (!title) {
+        return;
+    }
+
+    if (job->request) {
+        /* Only wanted for its side effect: the achievements are stored in the cache */
+        game_t                 game         = {.id = title->id, .title = title->title};
+        achievement_catalog_t *achievements = xbox_end_get_game_achievements(job->request, &game);
+        free_achievement_catalog(&achievements);
+    }
+
+    if (!title->cover_url || cover_cache_contains(title->cover_url)) {
+        return;
+    }
+
+    uint8_t *data = NULL;
+    size_t   size = 0;
+
+    if (!http_download(title->cover_url, &data, &size)) {
+        obs_log(LOG_DEBUG, "Monitoring | Unable to prefetch the cover of %s", title->title);
+        return;
+    }
+
+    char *path = cover_cache_store(title->cover_url, data, size);
+    bfree(path);
+    bfree(data);
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+void monitor_job_queue_push(monitor_job_queue_t *queue, monitor_job_t *job) {
+
+    job->next = NULL;
+
+    if (queue->tail) {
+        queue->tail->next = job;
+    } else {
+        queue->head = job;
+    }
+
+    queue->tail = job;
+}
+
+monitor_job_t *monitor_job_queue_take_all(monitor_job_queue_t *queue) {
+
+    monitor_job_t *jobs = queue->head;
+
+    queue->head = NULL;
+    queue->tail = NULL;
+
+    return jobs;
+}
+
+monitor_job_t *monitor_job_queue_take_batch(monitor_job_queue_t *queue) {
+
+    monitor_job_queue_t foreground = {0};
+    monitor_job_queue_t background = {0};
+
+    for (monitor_job_t *job = monitor_job_queue_take_all(queue); job;) {
+        monitor_job_t *next = job->next;
+        monitor_job_queue_push(is_background_job(job) ? &background : &foreground, job);
+        job = next;
+    }
+
+    if (!foreground.head) {
+        return background.head;
+    }
+
+    *queue = background;
+
+    return foreground.head;
+}
+
+void free_monitor_job(monitor_job_t **job) {
+
+    if (!job || !*job) {
+        return;
+    }
+
+    free_game(&(*job)->game);
+    free_achievement_catalog(&(*job)->achievements);
+    free_memory((void **)&(*job)->etag);
+    free_memory((void **)&(*job)->last_modified);
+    free_achievement_progress(&(*job)->progress);
+    free_recent_titles(&(*job)->recent_titles);
+    xbox_live_release_identity(&(*job)->identity);
+
+    bfree(*job);
+    *job = NULL;
+}
+
+void free_monitor_jobs(monitor_job_t *jobs) {
+
+    while (jobs) {
+        monitor_job_t *next = jobs->next;
+        free_monitor_job(&jobs);
+        jobs = next;
+    }
+}
+
+void monitor_job_begin(monitor_job_t *job) {
+
+    switch (job->type) {
+    case MONITOR_JOB_CHANGE_GAME:
+        if (job->lookup_current_game) {
+            job->request = xbox_begin_get_current_game();
+        } else {
+            begin_get_game_achievements(job);
+        }
+        break;
+
+    case MONITOR_JOB_FETCH_GAMERSCORE:
+        job->request = xbox_begin_fetch_gamerscore();
+        break;
+
+    case MONITOR_JOB_REVALIDATE_ACHIEVEMENTS:
+        job->request = xbox_begin_revalidate_game_achievements(job->game, job->etag, job->last_modified);
+        break;
+
+    case MONITOR_JOB_CACHE_PROGRESS:
+        for (const achievement_progress_t *progress = job->progress; progress; progress = progress->next) {
+            achievements_cache_set_progress(job->game->id, progress->id, progress->progress_state);
+        }
+        break;
+
+    case MONITOR_JOB_FETCH_RECENT_TITLES:
+        job->request = xbox_begin_get_recent_titles(PREFETCH_TITLE_COUNT);
+        break;
+
+    case MONITOR_JOB_PREFETCH_TITLE:
+        begin_prefetch_title(job);
+        break;
+
+    case MONITOR_JOB_REFRESH_IDENTITY:
+        /* Blocks while the tokens are refreshed, which must never happen on the lws thread */
+        job->identity = xbox_live_acquire_identity();
+        break;
+    }
+}
+
+void monitor_job_end(monitor_job_t *job) {
+
+    switch (job->type) {
+    case MONITOR_JOB_CHANGE_GAME:
+        if (job->lookup_current_game) {
+            /* The achievements can only be requested once the game is known */
+            job->game    = xbox_end_get_current_game(job->request);
+            job->request = NULL;
+
+            /* The future is consumed: nothing is requested when no game is played */
+            begin_get_game_achievements(job);
+        }
+
+        if (!job->from_cache) {
+            job->achievements = xbox_end_get_game_achievements(job->request, job->game);
+        }
+        break;
+
+    case MONITOR_JOB_FETCH_GAMERSCORE:
+        job->succeeded = xbox_end_fetch_gamerscore(job->request, &job->gamerscore);
+        break;
+
+    case MONITOR_JOB_REVALIDATE_ACHIEVEMENTS:
+        job->achievements = xbox_end_get_game_achievements(job->request, job->game);
+        break;
+
+    case MONITOR_JOB_CACHE_PROGRESS:
+        break;
+
+    case MONITOR_JOB_FETCH_RECENT_TITLES:
+        job->recent_titles = xbox_end_get_recent_titles(job->request);
+        break;
+
+    case MONITOR_JOB_PREFETCH_TITLE:
+        end_prefetch_title(job);
+        break;
+
+    case MONITOR_JOB_REFRESH_IDENTITY:
+        break;
+    }
+
+    job->request = NULL;
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "common/types.h"
+#include "net/http/http.h"
+#include "oauth/xbox-live.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file monitor_jobs.h
+ * @brief Blocking work posted by the monitor's lws thread to its worker thread.
+ *
+ * A job is created on the lws thread, executed by the worker with
+ * monitor_job_begin() and monitor_job_end(), then applied back on the lws
+ * thread. The same node carries the request and its result.
+ */
+
+/**
+ * @brief Kind of blocking work executed by the monitor worker thread.
+ */
+typedef enum monitor_job_type {
+    /** Retrieve the achievements of a game (and optionally the game itself) */
+    MONITOR_JOB_CHANGE_GAME,
+    /** Retrieve the current gamerscore of the user */
+    MONITOR_JOB_FETCH_GAMERSCORE,
+    /** Check whether the cached achievements of a game are still up to date */
+    MONITOR_JOB_REVALIDATE_ACHIEVEMENTS,
+    /** Record an achievement progress in the achievements cache */
+    MONITOR_JOB_CACHE_PROGRESS,
+    /** Retrieve the games most recently played by the user */
+    MONITOR_JOB_FETCH_RECENT_TITLES,
+    /** Store the achievements and cover of a recently played game in the caches */
+    MONITOR_JOB_PREFETCH_TITLE,
+    /** Refresh the expired identity used by the websocket handshake */
+    MONITOR_JOB_REFRESH_IDENTITY,
+} monitor_job_type_t;
+
+/**
+ * @brief Unit of blocking work posted by the lws thread to the worker thread.
+ *
+ * The same node carries the request to the worker and the result back to the
+ * lws thread.
+ */
+typedef struct monitor_job {
+    monitor_job_type_t type;
+
+    /** Change game: look up the currently played game before fetching its achievements */
+    bool lookup_current_game;
+
+    /** Change game / revalidate: value of the game generation counter when the job was posted */
+    uint64_t generation;
+
+    /** Change game / revalidate / cache progress: game concerned (owned by the job) */
+    game_t *game;
+
+    /**
+     * Change game / revalidate result: achievements of @c game (owned by the job
+     * until applied). NULL after a revalidation means the cached ones are up to date.
+     */
+    achievement_catalog_t *achievements;
+
+    /** Change game result: true if @c achievements were loaded from the cache */
+    bool from_cache;
+
+    /** Change game result / revalidate: validators of the cached achievements */
+    char *etag;
+    char *last_modified;
+
+    /** Cache progress: progress to record (owned by the job) */
+    achievement_progress_t *progress;
+
+    /** Fetch recent titles result / prefetch title: titles concerned (owned by the job) */
+    recent_title_t *recent_titles;
+
+    /** Fetch gamerscore result */
+    int64_t gamerscore;
+
+    /** Fetch gamerscore result: true if @c gamerscore was retrieved */
+    bool succeeded;
+
+    /** Refresh identity result: refreshed identity, or NULL on failure (reference owned by the job) */
+    xbox_identity_handle_t *identity;
+
+    /** Request in flight for this job (worker thread only) */
+    http_future_t *request;
+
+    struct monitor_job *next;
+} monitor_job_t;
+
+/**
+ * @brief FIFO of monitor jobs.
+ */
+typedef struct monitor_job_queue {
+    monitor_job_t *head;
+    monitor_job_t *tail;
+} monitor_job_queue_t;
+
+/**
+ * @brief Append a job at the end of a queue.
+ */
+void monitor_job_queue_push(monitor_job_queue_t *queue, monitor_job_t *job);
+
+/**
+ * @brief Detach all the jobs of a queue.
+ *
+ * @return Head of the detached jobs, in FIFO order.
+ */
+monitor_job_t *monitor_job_queue_take_all(monitor_job_queue_t *queue);
+
+/**
+ * @brief Detach the jobs the worker runs next.
+ *
+ * Every foreground job if any is queued, the background jobs staying queued in
+ * their order. Otherwise, every background job.
+ *
+ * @return Head of the detached jobs, in FIFO order.
+ */
+monitor_job_t *monitor_job_queue_take_batch(monitor_job_queue_t *queue);
+
+/**
+ * @brief Free a job and anything it still owns.
+ */
+void free_monitor_job(monitor_job_t **job);
+
+/**
+ * @brief Free a list of jobs.
+ */
+void free_monitor_jobs(monitor_job_t *jobs);
+
+/**
+ * @brief Send the first request of a job without waiting for it. Runs on the worker thread.
+ */
+void monitor_job_begin(monitor_job_t *job);
+
+/**
+ * @brief Wait for the requests of a job and store its result. Runs on the worker thread.
+ */
+void monitor_job_end(monitor_job_t *job);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,123 @@
+#include "xbox/session_snapshot.h"
+
+#include <obs-module.h>
+#include <util/threading.h>
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Private functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Waits until no reader is pinning a slot.
+ *
+ * Readers only pin a slot for the time needed to take a reference, so this
+ * spins rather than sleeping.
+ */
+static void wait_for_readers(const session_snapshot_publisher_t *publisher, long slot) {
+
+    while (os_atomic_load_long(&publisher->pins[slot]) > 0) {
+        /* Spin */
+    }
+}
+
+//  --------------------------------------------------------------------------------------------------------------------
+//  Public functions
+//  --------------------------------------------------------------------------------------------------------------------
+
+session_snapshot_t *create_session_snapshot(const xbox_session_t *session) {
+
+    if (!session) {
+        return NULL;
+    }
+
+    session_snapshot_t *snapshot = bzalloc(sizeof(session_snapshot_t));
+    snapshot->session            = copy_xbox_session(session);
+    snapshot->references         = 1;
+
+    return snapshot;
+}
+
+session_snapshot_t *retain_session_snapshot(session_snapshot_t *snapshot) {
+
+    if (snapshot) {
+        os_atomic_inc_long(&snapshot->references);
+    }
+
+    return snapshot;
+}
+
+void release_session_snapshot(session_snapshot_t **snapshot) {
+
+    if (!snapshot || !*snapshot) {
+        return;
+    }
+
+    session_snapshot_t *current = *snapshot;
+    *snapshot                   = NULL;
+
+    if (os_atomic_dec_long(&current->references) > 0) {
+        return;
+    }
+
+    xbox_session_t *session = (xbox_session_t *)current->session;
+    free_xbox_session(&session);
+
+    bfree(current);
+}
+
+/**
+ * @brief Publishes a snapshot, replacing the previously published one.
+ *
+ * The new snapshot goes in the slot that is not published, then the published
+ * slot index is switched. A reader only reads a slot after checking, while
+ * pinning it, that it is still the published one: once the switch is done and
+ * the pins of the former slot are gone, nobody can pick up the former snapshot
+ * anymore and the publisher's reference on it can be released.
+ */
+void session_snapshot_publish(session_snapshot_publisher_t *publisher, session_snapshot_t *snapshot) {
+
+    if (!publisher) {
+        release_session_snapshot(&snapshot);
+        return;
+    }
+
+    long current_slot = os_atomic_load_long(&publisher->published_slot);
+    long next_slot    = 1 - current_slot;
+
+    publisher->slots[next_slot] = snapshot;
+    os_atomic_store_long(&publisher->published_slot, next_slot);
+
+    wait_for_readers(publisher, current_slot);
+
+    session_snapshot_t *replaced   = publisher->slots[current_slot];
+    publisher->slots[current_slot] = NULL;
+
+    release_session_snapshot(&replaced);
+}
+
+session_snapshot_t *session_snapshot_acquire(session_snapshot_publisher_t *publisher) {
+
+    if (!publisher) {
+        return NULL;
+    }
+
+    long slot;
+
+    for (;;) {
+        slot = os_atomic_load_long(&publisher->published_slot);
+        os_atomic_inc_long(&publisher->pins[slot]);
+
+        if (os_atomic_load_long(&publisher->published_slot) == slot) {
+            break;
+        }
+
+        /* The publisher switched slots in between: the pinned slot may be about to be released */
+        os_atomic_dec_long(&publisher->pins[slot]);
+    }
+
+    session_snapshot_t *snapshot = retain_session_snapshot(publisher->slots[slot]);
+
+    os_atomic_dec_long(&publisher->pins[slot]);
+
+    return snapshot;
+}
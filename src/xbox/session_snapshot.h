@@ -0,0 +1,99 @@
+#pragma once
+
+#include "common/xbox_session.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Immutable, reference-counted copy of an Xbox session.
+ *
+ * Snapshots are created by the thread owning the live session and published
+ * through a @ref session_snapshot_publisher_t. Readers on other threads acquire
+ * the latest published snapshot, read it without any lock and release it once
+ * done. The content of a snapshot never changes after it has been published.
+ *
+ * Ownership:
+ * - @ref create_session_snapshot and @ref session_snapshot_acquire return a
+ *   reference that must be given back with @ref release_session_snapshot.
+ * - @c session is owned by the snapshot and must never be modified.
+ */
+typedef struct session_snapshot {
+    /** Copy of the session (game, gamerscore and achievements). */
+    const xbox_session_t *session;
+    /** Number of references held on the snapshot. */
+    volatile long         references;
+} session_snapshot_t;
+
+/**
+ * @brief Single-writer publication point of session snapshots.
+ *
+ * The publisher alternates between two slots. Readers pin the slot they read
+ * from for the few instructions needed to take a reference, which lets the writer
+ * know when the snapshot it replaced can no longer be picked up. Readers never
+ * wait; the writer only waits for those in-flight pins.
+ *
+ * A zero-initialized publisher is valid and publishes no snapshot.
+ */
+typedef struct session_snapshot_publisher {
+    session_snapshot_t *slots[2];
+    volatile long       pins[2];
+    volatile long       published_slot;
+} session_snapshot_publisher_t;
+
+/**
+ * @brief Creates a snapshot holding a deep copy of a session.
+ *
+ * @param session Session to copy (may be NULL).
+ *
+ * @return Newly allocated snapshot holding one reference, or NULL if @p session
+ *         is NULL.
+ */
+session_snapshot_t *create_session_snapshot(const xbox_session_t *session);
+
+/**
+ * @brief Takes an additional reference on a snapshot.
+ *
+ * @param snapshot Snapshot (may be NULL).
+ *
+ * @return @p snapshot.
+ */
+session_snapshot_t *retain_session_snapshot(session_snapshot_t *snapshot);
+
+/**
+ * @brief Gives back a reference and sets the caller's pointer to NULL.
+ *
+ * The snapshot is freed when its last reference is released. Safe to call with
+ * NULL or with @c *snapshot == NULL.
+ *
+ * @param[in,out] snapshot Address of the snapshot pointer to release.
+ */
+void release_session_snapshot(session_snapshot_t **snapshot);
+
+/**
+ * @brief Publishes a snapshot, replacing the previously published one.
+ *
+ * Must always be called from the same thread. The reference held by the caller
+ * on @p snapshot is transferred to the publisher.
+ *
+ * @param publisher Publisher to update.
+ * @param snapshot Snapshot to publish, or NULL to publish nothing.
+ */
+void session_snapshot_publish(session_snapshot_publisher_t *publisher, session_snapshot_t *snapshot);
+
+/**
+ * @brief Acquires the most recently published snapshot.
+ *
+ * Safe to call from any thread, concurrently with @ref session_snapshot_publish.
+ *
+ * @param publisher Publisher to read.
+ *
+ * @return A reference on the published snapshot, to be released with
+ *         @ref release_session_snapshot, or NULL if none is published.
+ */
+session_snapshot_t *session_snapshot_acquire(session_snapshot_publisher_t *publisher);
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,11 +8,20 @@
  * REST endpoints using the currently authenticated Xbox identity from the
  * persistent state.
  *
+ * Each request comes in two flavors:
+ *  - A blocking function (e.g. xbox_get_game_achievements()).
+ *  - A begin/end pair (e.g. xbox_begin_get_game_achievements() and
+ *    xbox_end_get_game_achievements()). Several requests can be started with
+ *    their begin function and then completed, so they are in flight at the
+ *    same time instead of back to back.
+ *
  * Common requirements:
  *  - Most functions require an authenticated identity to be present (see
- *    state_get_xbox_identity()).
+ *    xbox_live_acquire_identity()). The identity and its authorization header
+ *    are shared by the requests rather than rebuilt for each of them.
  *  - Requests use the "Authorization: XBL3.0 x=<uhs>;<token>" header and a
- *    contract version header.
+ *    contract version header, prebuilt once per identity (see
+ *    xbox_identity_handle_t) and attached to each request.
  *
  * Allocation/ownership:
  *  - Functions returning strings or linked lists allocate them with OBS
@@ -24,7 +33,7 @@
 #include <obs-module.h>
 #include <diagnostics/log.h>
 
-#include "io/state.h"
+#include "io/achievements_cache.h"
 #include "net/http/http.h"
 #include "net/json/json.h"
 #include "oauth/xbox-live.h"
@@ -35,72 +44,77 @@
 
 #define XBOX_PRESENCE_ENDPOINT             "https://userpresence.xboxlive.com/users/xuid(%s)"
 #define XBOX_PROFILE_SETTINGS_ENDPOINT     "https://profile.xboxlive.com/users/batch/profile/settings"
-#define XBOX_PROFILE_CONTRACT_VERSION      "2"
 #define GAMERSCORE_SETTING                 "Gamerscore"
 #define XBOX_TITLE_HUB                     "https://titlehub.xboxlive.com/users/xuid(%s)/titles/titleId(%s)/decoration/image"
+#define XBOX_TITLE_HISTORY                 "https://titlehub.xboxlive.com/users/xuid(%s)/titles/titlehistory/decoration/image?maxItems=%d"
 #define XBOX_ACHIEVEMENTS_ENDPOINT         "https://achievements.xboxlive.com/users/xuid(%s)/achievements?titleId=%s"
 
-#define XBOX_GAME_COVER_DISPLAY_IMAGE      "/titles/0/displayImage"
-#define XBOX_GAME_COVER_TYPE               "/titles/0/images/%d/type"
-#define XBOX_GAME_COVER_URL                "/titles/0/images/%d/url"
-#define XBOX_GAME_COVER_POSTER_TYPE        "poster"
-#define XBOX_GAME_COVER_BOX_ART_TYPE        "boxart"
 
 /**
- * @brief Fetch the cover image URL for a given game.
- *
- * Calls the Xbox TitleHub decoration/image endpoint and attempts to extract a
- * poster or box art image URL from the response. If no such image is available,
- * falls back to the display image URL.
+ * @brief Start fetching the cover image URL for a given game.
  *
- * Requires an authenticated Xbox identity to be present in the persistent state.
+ * Sends the Xbox TitleHub decoration/image request without waiting for the
+ * response. Requires an authenticated Xbox identity.
  *
  * @param game Game to fetch the cover for (may be NULL).
- * @return Newly allocated URL string on success, or NULL on error / if not
- *         available. The caller owns the returned string and must free it.
+ * @return Pending request to complete with xbox_end_get_game_cover(), or NULL
+ *         if the request could not be sent.
  */
-char *xbox_get_game_cover(const game_t *game) {
-
-    char *display_image_url = NULL;
+http_future_t *xbox_begin_get_game_cover(const game_t *game) {
 
     if (!game) {
-        return display_image_url;
+        return NULL;
     }
 
     /*
      * Retrieves the user's xbox identity
      */
-    xbox_identity_t *identity = xbox_live_get_identity();
+    xbox_identity_handle_t *handle = xbox_live_acquire_identity();
 
-    if (!identity) {
-        return display_image_url;
+    if (!handle) {
+        return NULL;
     }
 
     char display_request[4096];
-    snprintf(display_request, sizeof(display_request), XBOX_TITLE_HUB, identity->xid, game->id);
+    snprintf(display_request, sizeof(display_request), XBOX_TITLE_HUB, handle->identity->xid, game->id);
 
     obs_log(LOG_DEBUG, "Display image URL: %s", display_request);
 
-    char headers[4096];
-    snprintf(headers,
-             sizeof(headers),
-             "Authorization: XBL3.0 x=%s;%s\r\n"
-             "x-xbl-contract-version: %s\r\n"
-             "Accept-Language: en-CA\r\n", //  Must be present!
-             identity->uhs,
-             identity->token->value,
-             XBOX_PROFILE_CONTRACT_VERSION);
+    http_request_t *request = http_request_create(display_request);
+    http_request_use_headers(request, handle->headers);
+    http_request_add_header(request, "Accept-Language", "en-CA"); //  Must be present!
 
-    obs_log(LOG_DEBUG, "Headers: %s", headers);
+    xbox_live_release_identity(&handle);
 
     /*
      * Sends the request
      */
+    return http_request_send(request);
+}
+
+/**
+ * @brief Complete a request started with xbox_begin_get_game_cover().
+ *
+ * Attempts to extract a poster or box art image URL from the response. If no
+ * such image is available, falls back to the display image URL.
+ *
+ * @param request Pending request (may be NULL).
+ * @return Newly allocated URL string on success, or NULL on error / if not
+ *         available. The caller owns the returned string and must free it.
+ */
+char *xbox_end_get_game_cover(http_future_t *request) {
+
+    char *display_image_url = NULL;
+
+    if (!request) {
+        return display_image_url;
+    }
+
     long  http_code = 0;
-    char *response  = http_get(display_request, headers, NULL, &http_code);
+    char *response  = http_future_wait(request, &http_code);
 
     if (http_code < 200 || http_code >= 300) {
-        obs_log(LOG_ERROR, "Failed to fetch title image: received status code %d", http_code);
+        obs_log(LOG_ERROR, "Failed to fetch title image: received status code %ld", http_code);
         goto cleanup;
     }
 
@@ -113,91 +127,131 @@ char *xbox_get_game_cover(const game_t *game) {
 
     /*
      *  Process the response by trying to get the poster image URL.
-     *  Otherwise falls back on the display name.
+     *  Otherwise falls back on the display image.
      */
-    cJSON *presence_json = cJSON_Parse(response);
+    display_image_url = parse_game_cover_url(response);
 
-    for (int image_index = 0;; image_index++) {
+    if (!display_image_url) {
+        obs_log(LOG_ERROR, "Failed to fetch title image: no image found");
+        goto cleanup;
+    }
 
-        char image_type_key[128];
-        snprintf(image_type_key, sizeof(image_type_key), XBOX_GAME_COVER_TYPE, image_index);
+    obs_log(LOG_INFO, "Xbox game image found");
 
-        cJSON *image_type_value = cJSONUtils_GetPointer(presence_json, image_type_key);
+cleanup:
+    FREE(response);
 
-        if (!image_type_value) {
-            break;
-        }
+    return display_image_url;
+}
 
-        if (strcmp(image_type_value->valuestring, XBOX_GAME_COVER_POSTER_TYPE) != 0 &&
-            strcmp(image_type_value->valuestring, XBOX_GAME_COVER_BOX_ART_TYPE) != 0) {
-            continue;
-        }
+/**
+ * @brief Fetch the cover image URL for a given game.
+ *
+ * Calls the Xbox TitleHub decoration/image endpoint and attempts to extract a
+ * poster or box art image URL from the response. If no such image is available,
+ * falls back to the display image URL.
+ *
+ * Requires an authenticated Xbox identity to be present in the persistent state.
+ *
+ * @param game Game to fetch the cover for (may be NULL).
+ * @return Newly allocated URL string on success, or NULL on error / if not
+ *         available. The caller owns the returned string and must free it.
+ */
+char *xbox_get_game_cover(const game_t *game) {
 
-        char image_url_key[128];
-        snprintf(image_url_key, sizeof(image_url_key), XBOX_GAME_COVER_URL, image_index);
+    return xbox_end_get_game_cover(xbox_begin_get_game_cover(game));
+}
 
-        cJSON *image_url_value = cJSONUtils_GetPointer(presence_json, image_url_key);
+/**
+ * @brief Start retrieving the games most recently played by the user.
+ *
+ * Sends the Xbox TitleHub title history request without waiting for the
+ * response. Requires an authenticated Xbox identity.
+ *
+ * @param max_titles Maximum number of titles to retrieve.
+ * @return Pending request to complete with xbox_end_get_recent_titles(), or NULL
+ *         if the request could not be sent.
+ */
+http_future_t *xbox_begin_get_recent_titles(int max_titles) {
 
-        if (!image_url_value || strlen(image_url_value->valuestring) == 0) {
-            continue;
-        }
+    xbox_identity_handle_t *handle = xbox_live_acquire_identity();
 
-        display_image_url = bstrdup_n(image_url_value->valuestring, strlen(image_url_value->valuestring));
-        obs_log(LOG_INFO, "Xbox poster image found");
-        break;
+    if (!handle) {
+        obs_log(LOG_ERROR, "Failed to fetch the recent titles: no identity found");
+        return NULL;
     }
 
-    if (!display_image_url) {
+    char history_url[512];
+    snprintf(history_url, sizeof(history_url), XBOX_TITLE_HISTORY, handle->identity->xid, max_titles);
 
-        obs_log(LOG_INFO, "No Xbox game poster image found: falling back on the display image");
+    http_request_t *request = http_request_create(history_url);
+    http_request_use_headers(request, handle->headers);
+    http_request_add_header(request, "Accept-Language", "en-CA"); //  Must be present!
 
-        /* No poster image found. Let's see if we can get the display image at least */
-        cJSON *display_image = cJSONUtils_GetPointer(presence_json, XBOX_GAME_COVER_DISPLAY_IMAGE);
+    xbox_live_release_identity(&handle);
 
-        if (!display_image) {
-            obs_log(LOG_ERROR, "Failed to fetch title image: displayName property not found");
-            goto cleanup;
-        }
+    /*
+     * Sends the request
+     */
+    return http_request_send(request);
+}
 
-        display_image_url = bstrdup_n(display_image->valuestring, strlen(display_image->valuestring));
-        obs_log(LOG_INFO, "Xbox game display image found");
+/**
+ * @brief Complete a request started with xbox_begin_get_recent_titles().
+ *
+ * @param request Pending request (may be NULL).
+ * @return Newly allocated list of titles, most recently played first, or NULL
+ *         on error. The caller must free it with free_recent_titles().
+ */
+recent_title_t *xbox_end_get_recent_titles(http_future_t *request) {
+
+    recent_title_t *titles = NULL;
+
+    if (!request) {
+        return NULL;
     }
 
+    long  http_code = 0;
+    char *response  = http_future_wait(request, &http_code);
+
+    if (http_code < 200 || http_code >= 300) {
+        obs_log(LOG_ERROR, "Failed to fetch the recent titles: received status code %ld", http_code);
+        goto cleanup;
+    }
+
+    if (!response) {
+        obs_log(LOG_ERROR, "Failed to fetch the recent titles: received no response");
+        goto cleanup;
+    }
+
+    titles = parse_recent_titles(response);
+
 cleanup:
     FREE(response);
 
-    return display_image_url;
+    return titles;
 }
 
 /**
- * @brief Fetch the current user's gamerscore.
+ * @brief Start fetching the current user's gamerscore.
  *
- * Performs a profile batch settings call and extracts the "Gamerscore" setting.
+ * Sends the profile batch settings request without waiting for the response.
  * Requires an authenticated Xbox identity to be present in the persistent state.
  *
- * @param[out] out_gamerscore Output location for the gamerscore value.
- * @return true if the gamerscore was successfully retrieved and parsed; false otherwise.
+ * @return Pending request to complete with xbox_end_fetch_gamerscore(), or NULL
+ *         if the request could not be sent.
  */
-bool xbox_fetch_gamerscore(int64_t *out_gamerscore) {
-
-    if (!out_gamerscore) {
-        return false;
-    }
+http_future_t *xbox_begin_fetch_gamerscore(void) {
 
     /*
      * Retrieves the user's xbox identity
      */
-    xbox_identity_t *identity = state_get_xbox_identity();
+    xbox_identity_handle_t *handle = xbox_live_acquire_identity();
 
-    if (!identity) {
-        return false;
+    if (!handle) {
+        return NULL;
     }
 
-    bool  result          = false;
-    char *json            = NULL;
-    char *gamerscore_text = NULL;
-    char *end             = NULL;
-
     /*
      * Creates the request
      */
@@ -205,30 +259,52 @@ bool xbox_fetch_gamerscore(int64_t *out_gamerscore) {
     snprintf(json_body,
              sizeof(json_body),
              "{\"userIds\":[\"%s\"],\"settings\":[\"%s\"]}",
-             identity->xid,
+             handle->identity->xid,
              GAMERSCORE_SETTING);
 
     obs_log(LOG_DEBUG, "Body: %s", json_body);
 
-    char headers[4096];
-    snprintf(headers,
-             sizeof(headers),
-             "Authorization: XBL3.0 x=%s;%s\r\n"
-             "x-xbl-contract-version: %s\r\n",
-             identity->uhs,
-             identity->token->value,
-             XBOX_PROFILE_CONTRACT_VERSION);
+    http_request_t *request = http_request_create(XBOX_PROFILE_SETTINGS_ENDPOINT);
+    http_request_use_headers(request, handle->headers);
+    http_request_set_body(request, json_body, NULL);
 
-    obs_log(LOG_DEBUG, "Headers: %s", headers);
+    xbox_live_release_identity(&handle);
 
     /*
      * Sends the request
      */
+    return http_request_send(request);
+}
+
+/**
+ * @brief Complete a request started with xbox_begin_fetch_gamerscore().
+ *
+ * Extracts the "Gamerscore" setting from the response.
+ *
+ * @param request Pending request (may be NULL).
+ * @param[out] out_gamerscore Output location for the gamerscore value.
+ * @return true if the gamerscore was successfully retrieved and parsed; false otherwise.
+ */
+bool xbox_end_fetch_gamerscore(http_future_t *request, int64_t *out_gamerscore) {
+
+    bool  result          = false;
+    char *json            = NULL;
+    char *gamerscore_text = NULL;
+    char *end             = NULL;
+
+    if (!request) {
+        return false;
+    }
+
     long http_code = 0;
-    json           = http_post(XBOX_PROFILE_SETTINGS_ENDPOINT, json_body, headers, &http_code);
+    json           = http_future_wait(request, &http_code);
+
+    if (!out_gamerscore) {
+        goto cleanup;
+    }
 
     if (http_code < 200 || http_code >= 300) {
-        obs_log(LOG_ERROR, "Failed to fetch gamerscore: received status code %d", http_code);
+        obs_log(LOG_ERROR, "Failed to fetch gamerscore: received status code %ld", http_code);
         goto cleanup;
     }
 
@@ -264,55 +340,82 @@ cleanup:
 }
 
 /**
- * @brief Retrieve the game currently being played by the authenticated user.
+ * @brief Fetch the current user's gamerscore.
  *
- * Calls the Xbox Presence endpoint and searches for the first non-"Home" title
- * with state "Active".
+ * Performs a profile batch settings call and extracts the "Gamerscore" setting.
+ * Requires an authenticated Xbox identity to be present in the persistent state.
  *
- * Notes:
- *  - Requires an authenticated Xbox identity to be present in the persistent state.
- *  - The returned game_t owns its id/title strings.
+ * @param[out] out_gamerscore Output location for the gamerscore value.
+ * @return true if the gamerscore was successfully retrieved and parsed; false otherwise.
+ */
+bool xbox_fetch_gamerscore(int64_t *out_gamerscore) {
+
+    if (!out_gamerscore) {
+        return false;
+    }
+
+    return xbox_end_fetch_gamerscore(xbox_begin_fetch_gamerscore(), out_gamerscore);
+}
+
+/**
+ * @brief Start retrieving the game currently being played by the authenticated user.
  *
- * @return Newly allocated game_t on success, or NULL if the user is offline,
- *         no active game is found, or on error.
+ * Sends the Xbox Presence request without waiting for the response.
+ * Requires an authenticated Xbox identity to be present in the persistent state.
+ *
+ * @return Pending request to complete with xbox_end_get_current_game(), or NULL
+ *         if the request could not be sent.
  */
-game_t *xbox_get_current_game(void) {
+http_future_t *xbox_begin_get_current_game(void) {
 
     obs_log(LOG_INFO, "Retrieving current game");
 
-    xbox_identity_t *identity = state_get_xbox_identity();
+    xbox_identity_handle_t *handle = xbox_live_acquire_identity();
 
-    if (!identity) {
+    if (!handle) {
         obs_log(LOG_ERROR, "Failed to fetch the current game: no identity found");
         return NULL;
     }
 
-    char   *response_json = NULL;
-    game_t *game          = NULL;
-
-    char headers[4096];
-    snprintf(headers,
-             sizeof(headers),
-             "Authorization: XBL3.0 x=%s;%s\r\n"
-             "x-xbl-contract-version: %s\r\n",
-             identity->uhs,
-             identity->token->value,
-             XBOX_PROFILE_CONTRACT_VERSION);
-
-    obs_log(LOG_DEBUG, "Headers: %s", headers);
-
     /*
      * Sends the request
      */
     char presence_url[512];
-    snprintf(presence_url, sizeof(presence_url), XBOX_PRESENCE_ENDPOINT, identity->xid);
+    snprintf(presence_url, sizeof(presence_url), XBOX_PRESENCE_ENDPOINT, handle->identity->xid);
+
+    http_request_t *request = http_request_create(presence_url);
+    http_request_use_headers(request, handle->headers);
+
+    xbox_live_release_identity(&handle);
+
+    return http_request_send(request);
+}
+
+/**
+ * @brief Complete a request started with xbox_begin_get_current_game().
+ *
+ * Searches the presence response for the first non-"Home" title with state
+ * "Active". The returned game_t owns its id/title strings.
+ *
+ * @param request Pending request (may be NULL).
+ * @return Newly allocated game_t on success, or NULL if the user is offline,
+ *         no active game is found, or on error.
+ */
+game_t *xbox_end_get_current_game(http_future_t *request) {
+
+    char   *response_json = NULL;
+    game_t *game          = NULL;
+
+    if (!request) {
+        return NULL;
+    }
 
     long http_code = 0;
-    response_json  = http_get(presence_url, headers, NULL, &http_code);
+    response_json  = http_future_wait(request, &http_code);
 
     if (http_code < 200 || http_code >= 300) {
         /* Retry? */
-        obs_log(LOG_ERROR, "Failed to fetch the current game: received status code %d", http_code);
+        obs_log(LOG_ERROR, "Failed to fetch the current game: received status code %ld", http_code);
         goto cleanup;
     }
 
@@ -340,8 +443,8 @@ game_t *xbox_get_current_game(void) {
         goto cleanup;
     }
 
-    char current_game_title[128];
-    char current_game_id[128];
+    char current_game_title[128] = "";
+    char current_game_id[128]    = "";
 
     for (int title_game_index = 0; title_game_index < 10; title_game_index++) {
 
@@ -388,8 +491,8 @@ game_t *xbox_get_current_game(void) {
     obs_log(LOG_INFO, "Game is '%s' (%s)", current_game_title, current_game_id);
 
     game        = bzalloc(sizeof(game_t));
-    game->id    = strdup(current_game_id);
-    game->title = strdup(current_game_title);
+    game->id    = bstrdup(current_game_id);
+    game->title = bstrdup(current_game_title);
 
 cleanup:
     // FREE(response_json);
@@ -398,71 +501,177 @@ cleanup:
 }
 
 /**
- * @brief Retrieve the list of achievements for a given game.
+ * @brief Retrieve the game currently being played by the authenticated user.
  *
- * Calls the achievements endpoint for the authenticated user and parses the
- * response JSON into an achievement_t linked list.
+ * Calls the Xbox Presence endpoint and searches for the first non-"Home" title
+ * with state "Active".
  *
- * Requires an authenticated Xbox identity to be present in the persistent state.
+ * Notes:
+ *  - Requires an authenticated Xbox identity to be present in the persistent state.
+ *  - The returned game_t owns its id/title strings.
+ *
+ * @return Newly allocated game_t on success, or NULL if the user is offline,
+ *         no active game is found, or on error.
+ */
+game_t *xbox_get_current_game(void) {
+
+    return xbox_end_get_current_game(xbox_begin_get_current_game());
+}
+
+/**
+ * @brief Send the achievements request of a game, optionally made conditional.
  *
  * @param game Game for which achievements should be fetched (may be NULL).
- * @return Head of a newly allocated linked list of achievements, or NULL on error.
- *         The caller owns the returned list and must free it.
+ * @param etag ETag of the cached achievements, sent as If-None-Match (may be NULL).
+ * @param last_modified Last-Modified value of the cached achievements, sent as
+ *        If-Modified-Since (may be NULL).
+ * @return Pending request, or NULL if the request could not be sent.
  */
-achievement_t *xbox_get_game_achievements(const game_t *game) {
+static http_future_t *begin_get_game_achievements(const game_t *game, const char *etag, const char *last_modified) {
 
     if (!game) {
         return NULL;
     }
 
-    xbox_identity_t *identity = state_get_xbox_identity();
+    xbox_identity_handle_t *handle = xbox_live_acquire_identity();
 
-    if (!identity) {
+    if (!handle) {
         obs_log(LOG_ERROR, "Failed to fetch the game's achievements: no identity found");
         return NULL;
     }
 
-    achievement_t *achievements  = NULL;
-    char          *response_json = NULL;
+    char achievements_url[512];
+    snprintf(achievements_url, sizeof(achievements_url), XBOX_ACHIEVEMENTS_ENDPOINT, handle->identity->xid, game->id);
 
-    char headers[4096];
-    snprintf(headers,
-             sizeof(headers),
-             "Authorization: XBL3.0 x=%s;%s\r\n"
-             "x-xbl-contract-version: %s\r\n",
-             identity->uhs,
-             identity->token->value,
-             XBOX_PROFILE_CONTRACT_VERSION);
+    http_request_t *request = http_request_create(achievements_url);
+    http_request_use_headers(request, handle->headers);
 
-    obs_log(LOG_DEBUG, "Headers: %s", headers);
+    /* Lets the service answer 304 Not Modified instead of sending the whole list again */
+
+    if (etag) {
+        http_request_add_header(request, "If-None-Match", etag);
+    }
+
+    if (last_modified) {
+        http_request_add_header(request, "If-Modified-Since", last_modified);
+    }
+
+    xbox_live_release_identity(&handle);
 
     /*
      * Sends the request
      */
-    char presence_url[512];
-    snprintf(presence_url, sizeof(presence_url), XBOX_ACHIEVEMENTS_ENDPOINT, identity->xid, game->id);
+    return http_request_send(request);
+}
 
-    long http_code = 0;
-    response_json  = http_get(presence_url, headers, NULL, &http_code);
+/**
+ * @brief Start retrieving the list of achievements for a given game.
+ *
+ * Sends the achievements request without waiting for the response.
+ * Requires an authenticated Xbox identity to be present in the persistent state.
+ *
+ * @param game Game for which achievements should be fetched (may be NULL).
+ * @return Pending request to complete with xbox_end_get_game_achievements(), or
+ *         NULL if the request could not be sent.
+ */
+http_future_t *xbox_begin_get_game_achievements(const game_t *game) {
 
-    if (http_code < 200 || http_code >= 300) {
-        obs_log(LOG_ERROR, "Failed to fetch the games achievements: received status code %d", http_code);
+    return begin_get_game_achievements(game, NULL, NULL);
+}
+
+/**
+ * @brief Start revalidating the cached achievements of a game.
+ *
+ * Sends a conditional achievements request: the service only sends the list
+ * back if it changed since the cached copy was retrieved.
+ *
+ * @param game Game whose achievements are cached (may be NULL).
+ * @param etag ETag of the cached achievements (may be NULL).
+ * @param last_modified Last-Modified value of the cached achievements (may be NULL).
+ * @return Pending request to complete with xbox_end_get_game_achievements(), or
+ *         NULL if the request could not be sent.
+ */
+http_future_t *xbox_begin_revalidate_game_achievements(const game_t *game,
+                                                       const char   *etag,
+                                                       const char   *last_modified) {
+
+    return begin_get_game_achievements(game, etag, last_modified);
+}
+
+/**
+ * @brief Complete a request started with xbox_begin_get_game_achievements() or
+ * xbox_begin_revalidate_game_achievements().
+ *
+ * Parses the response JSON into an achievement catalog and stores it in the
+ * achievements cache along with the validators of the response.
+ *
+ * @param request Pending request (may be NULL).
+ * @param game Game the achievements were requested for (used for logging and
+ *        as the cache key).
+ * @return Newly allocated catalog of achievements, or NULL on error or if the
+ *         cached achievements are still up to date (304 Not Modified).
+ *         The caller owns the returned catalog and must free it.
+ */
+achievement_catalog_t *xbox_end_get_game_achievements(http_future_t *request, const game_t *game) {
+
+    achievement_catalog_t *achievements = NULL;
+    http_response_t        response;
+
+    if (!request) {
+        return NULL;
+    }
+
+    http_future_wait_response(request, &response);
+
+    if (response.http_code == 304) {
+        obs_log(LOG_DEBUG, "Cached achievements of game %s are up to date", game ? game->title : "(unknown)");
         goto cleanup;
     }
 
-    if (!response_json) {
+    if (response.http_code < 200 || response.http_code >= 300) {
+        obs_log(LOG_ERROR, "Failed to fetch the games achievements: received status code %ld", response.http_code);
+        goto cleanup;
+    }
+
+    if (!response.body) {
         obs_log(LOG_ERROR, "Failed to fetch the games achievements: received no response");
         goto cleanup;
     }
 
-    obs_log(LOG_DEBUG, "Response: %s", response_json);
+    obs_log(LOG_DEBUG, "Response: %s", response.body);
+
+    achievements = parse_achievement_catalog(response.body);
 
-    achievements = parse_achievements(response_json);
+    obs_log(LOG_INFO,
+            "Received %zu achievements for game %s",
+            achievement_catalog_count(achievements),
+            game ? game->title : "(unknown)");
 
-    obs_log(LOG_INFO, "Received %d achievements for game %s", count_achievements(achievements), game->title);
+    if (achievements && game) {
+        achievements_cache_store(game->id, achievements, response.etag, response.last_modified);
+    }
 
 cleanup:
-    FREE(response_json);
+    FREE(response.body);
+    FREE(response.etag);
+    FREE(response.last_modified);
 
     return achievements;
 }
+
+/**
+ * @brief Retrieve the list of achievements for a given game.
+ *
+ * Calls the achievements endpoint for the authenticated user and parses the
+ * response JSON into an achievement catalog.
+ *
+ * Requires an authenticated Xbox identity to be present in the persistent state.
+ *
+ * @param game Game for which achievements should be fetched (may be NULL).
+ * @return Newly allocated catalog of achievements, or NULL on error.
+ *         The caller owns the returned catalog and must free it.
+ */
+achievement_catalog_t *xbox_get_game_achievements(const game_t *game) {
+
+    return xbox_end_get_game_achievements(xbox_begin_get_game_achievements(game), game);
+}
@@ -3,6 +3,7 @@
 #include <stdbool.h>
 #include <stdint.h> // for int64_t
 #include <common/types.h>
+#include <net/http/http.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,6 +21,26 @@ extern "C" {
  */
 bool xbox_fetch_gamerscore(int64_t *out_gamerscore);
 
+/**
+ * @brief Starts fetching the current authenticated user's gamerscore.
+ *
+ * Non-blocking counterpart of @ref xbox_fetch_gamerscore.
+ *
+ * @return Pending request that must be completed with
+ *         @ref xbox_end_fetch_gamerscore, or NULL if it could not be sent.
+ */
+http_future_t *xbox_begin_fetch_gamerscore(void);
+
+/**
+ * @brief Waits for a gamerscore request and extracts the gamerscore.
+ *
+ * @param request Pending request returned by @ref xbox_begin_fetch_gamerscore (may be NULL).
+ * @param[out] out_gamerscore Output location for the gamerscore.
+ *
+ * @return True on success (and @p out_gamerscore is written), false otherwise.
+ */
+bool xbox_end_fetch_gamerscore(http_future_t *request, int64_t *out_gamerscore);
+
 /**
  * @brief Retrieves the game currently being played by the authenticated user.
  *
@@ -29,16 +50,82 @@ bool xbox_fetch_gamerscore(int64_t *out_gamerscore);
  */
 game_t *xbox_get_current_game(void);
 
+/**
+ * @brief Starts retrieving the game currently being played.
+ *
+ * Non-blocking counterpart of @ref xbox_get_current_game.
+ *
+ * @return Pending request that must be completed with
+ *         @ref xbox_end_get_current_game, or NULL if it could not be sent.
+ */
+http_future_t *xbox_begin_get_current_game(void);
+
+/**
+ * @brief Waits for a presence request and extracts the game being played.
+ *
+ * @param request Pending request returned by @ref xbox_begin_get_current_game (may be NULL).
+ *
+ * @return Newly allocated @c game_t, or NULL if no active game is detected or
+ *         on error. The caller must free it with @ref free_game.
+ */
+game_t *xbox_end_get_current_game(http_future_t *request);
+
 /**
  * @brief Retrieves the list of achievements for a game.
  *
  * @param game Game for which achievements should be fetched (may be NULL).
  *
- * @return Head of a newly allocated linked list of achievements, or NULL on
- *         error. The caller owns the returned list and must free it with
- *         @ref free_achievement.
+ * @return Newly allocated catalog of achievements, or NULL on error. The
+ *         caller owns the returned catalog and must free it with
+ *         @ref free_achievement_catalog.
+ */
+achievement_catalog_t *xbox_get_game_achievements(const game_t *game);
+
+/**
+ * @brief Starts retrieving the list of achievements for a game.
+ *
+ * Non-blocking counterpart of @ref xbox_get_game_achievements.
+ *
+ * @param game Game for which achievements should be fetched (may be NULL).
+ *
+ * @return Pending request that must be completed with
+ *         @ref xbox_end_get_game_achievements, or NULL if it could not be sent.
+ */
+http_future_t *xbox_begin_get_game_achievements(const game_t *game);
+
+/**
+ * @brief Starts revalidating the cached achievements of a game.
+ *
+ * Conditional counterpart of @ref xbox_begin_get_game_achievements: the request
+ * carries the validators of the cached achievements, so the service only sends
+ * the list back if it changed.
+ *
+ * @param game Game whose achievements are cached (may be NULL).
+ * @param etag ETag of the cached achievements (may be NULL).
+ * @param last_modified Last-Modified value of the cached achievements (may be NULL).
+ *
+ * @return Pending request, to be completed with
+ *         @ref xbox_end_get_game_achievements, or NULL if it could not be sent.
+ */
+http_future_t *xbox_begin_revalidate_game_achievements(const game_t *game,
+                                                       const char   *etag,
+                                                       const char   *last_modified);
+
+/**
+ * @brief Waits for an achievements request and parses the achievements.
+ *
+ * Retrieved achievements are also stored in the achievements cache.
+ *
+ * @param request Pending request returned by @ref xbox_begin_get_game_achievements
+ *        or @ref xbox_begin_revalidate_game_achievements (may be NULL).
+ * @param game Game the achievements were requested for (used for logging and as
+ *        the cache key, may be NULL).
+ *
+ * @return Newly allocated catalog of achievements, or NULL on error or when the
+ *         cached achievements are still up to date. The caller must free it with
+ *         @ref free_achievement_catalog.
  */
-achievement_t *xbox_get_game_achievements(const game_t *game);
+achievement_catalog_t *xbox_end_get_game_achievements(http_future_t *request, const game_t *game);
 
 /**
  * @brief Fetches a cover image URL for a given game.
@@ -50,6 +137,47 @@ achievement_t *xbox_get_game_achievements(const game_t *game);
  */
 char *xbox_get_game_cover(const game_t *game);
 
+/**
+ * @brief Starts fetching a cover image URL for a given game.
+ *
+ * Non-blocking counterpart of @ref xbox_get_game_cover.
+ *
+ * @param game Game to fetch the cover for (may be NULL).
+ *
+ * @return Pending request that must be completed with
+ *         @ref xbox_end_get_game_cover, or NULL if it could not be sent.
+ */
+http_future_t *xbox_begin_get_game_cover(const game_t *game);
+
+/**
+ * @brief Waits for a title hub request and extracts the cover image URL.
+ *
+ * @param request Pending request returned by @ref xbox_begin_get_game_cover (may be NULL).
+ *
+ * @return Newly allocated URL string, or NULL if not available or on error.
+ */
+char *xbox_end_get_game_cover(http_future_t *request);
+
+/**
+ * @brief Starts retrieving the games most recently played by the user.
+ *
+ * @param max_titles Maximum number of titles to retrieve.
+ *
+ * @return Pending request that must be completed with
+ *         @ref xbox_end_get_recent_titles, or NULL if it could not be sent.
+ */
+http_future_t *xbox_begin_get_recent_titles(int max_titles);
+
+/**
+ * @brief Waits for a title history request and parses the titles.
+ *
+ * @param request Pending request returned by @ref xbox_begin_get_recent_titles (may be NULL).
+ *
+ * @return Newly allocated list of titles, most recently played first, or NULL
+ *         on error. The caller must free it with @ref free_recent_titles.
+ */
+recent_title_t *xbox_end_get_recent_titles(http_future_t *request);
+
 #ifdef __cplusplus
 }
 #endif
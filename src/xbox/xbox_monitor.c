@@ -14,6 +14,17 @@
  *  - The monitor runs a background pthread that calls lws_service().
  *  - Incoming messages are parsed and subscriber callbacks are invoked from that
  *    thread.
+ *  - Blocking HTTP work (achievements and gamerscore retrieval) runs on a second
+ *    worker thread, which sends the requests of all its pending jobs
+ *    concurrently. Results are queued back and applied on the lws thread when
+ *    lws_cancel_service() wakes it up, so the websocket keeps being serviced
+ *    while requests are in flight.
+ *  - The worker thread also owns the achievements cache: a game whose
+ *    achievements are cached is switched to without waiting for the network,
+ *    then its achievements are revalidated with a conditional request.
+ *  - Once connected, the worker can warm the achievements and cover caches up
+ *    with the games most recently played by the user, one game per batch so a
+ *    real game change never waits behind the whole warm-up.
  *
  * Ownership/lifetime:
  *  - Callback parameters (game/progress/gamerscore) generally point to objects
@@ -30,18 +41,24 @@
 
 #ifdef HAVE_LIBWEBSOCKETS
 
+#include "monitor_jobs.h"
 #include "xbox_client.h"
 #include "xbox_session.h"
 
 #include <libwebsockets.h>
 #include <pthread.h>
+#include <util/threading.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 #include "external/cjson/cJSON.h"
 
+#include "io/achievements_cache.h"
+#include "io/cover_cache.h"
+#include "net/http/http.h"
 #include "io/state.h"
 #include "oauth/xbox-live.h"
+#include "util/event_queue.h"
 
 #include <text/parsers.h>
 
@@ -54,11 +71,18 @@
 #define SUBSCRIBE 1
 #define UNSUBSCRIBE 1
 
+/** Number of events that can wait for the dispatcher before new ones get dropped */
+#define EVENT_QUEUE_CAPACITY 256
+
+/** Number of events the dispatcher takes at once; events of a batch can be coalesced */
+#define DISPATCH_BATCH_SIZE 32
+
 /**
  * @brief Subscription node for game-played events.
  */
 typedef struct game_played_subscription {
     on_xbox_game_played_t            callback;
+    xbox_delivery_mode_t             mode;
     struct game_played_subscription *next;
 } game_played_subscription_t;
 
@@ -69,6 +93,7 @@ static game_played_subscription_t *g_game_played_subscriptions = NULL;
  */
 typedef struct achievements_updated_subscription {
     on_xbox_achievements_progressed_t         callback;
+    xbox_delivery_mode_t                      mode;
     struct achievements_updated_subscription *next;
 } achievements_updated_subscription_t;
 
@@ -79,11 +104,44 @@ static achievements_updated_subscription_t *g_achievements_updated_subscriptions
  */
 typedef struct connection_changed_subscription {
     on_xbox_connection_changed_t            callback;
+    xbox_delivery_mode_t                    mode;
     struct connection_changed_subscription *next;
 } connection_changed_subscription_t;
 
 static connection_changed_subscription_t *g_connection_changed_subscriptions = NULL;
 
+/**
+ * @brief Kind of event delivered to the subscribers by the dispatcher thread.
+ */
+typedef enum monitor_event_type {
+    MONITOR_EVENT_GAME_PLAYED,
+    MONITOR_EVENT_ACHIEVEMENTS_PROGRESSED,
+    MONITOR_EVENT_CONNECTION_CHANGED,
+    MONITOR_EVENT_TYPE_COUNT,
+} monitor_event_type_t;
+
+/**
+ * @brief Event queued by the lws thread for the dispatcher thread.
+ *
+ * The event owns copies of everything the subscribers get, so it stays valid
+ * however the session changes before it is delivered.
+ */
+typedef struct monitor_event {
+    monitor_event_type_t type;
+
+    /** Game played / achievements progressed: session the event was raised for */
+    session_snapshot_t *snapshot;
+
+    /** Achievements progressed: the progress received */
+    achievement_progress_t *progress;
+
+    /** Connection changed: new state */
+    bool connected;
+
+    /** Connection changed: error message, or NULL */
+    char *error_message;
+} monitor_event_t;
+
 /**
  * @brief Monitor thread state.
  *
@@ -91,8 +149,8 @@ static connection_changed_subscription_t *g_connection_changed_subscriptions = N
  * @c g_monitoring_context pointer.
  *
  * Ownership/lifetime:
- * - @c identity is an xbox_identity_t instance returned by state/xbox_live helpers.
- *   It is owned by the state subsystem; do not free it here.
+ * - @c identity is a reference acquired with xbox_live_acquire_identity(). It is
+ *   released when replaced or on stop.
  * - @c auth_token is a heap-allocated "XBL3.0 x=<uhs>;<token>" header value.
  *   It is owned by this context and must be freed when replaced or on stop.
  */
@@ -113,11 +171,14 @@ typedef struct monitoring_context {
     bool connected;
 
     /**
-     * Current identity used.
+     * Current identity used (lws thread only once started).
      *
      * Used to determine whether the token is expired and to refresh it when needed.
      */
-    xbox_identity_t *identity;
+    xbox_identity_handle_t *identity;
+
+    /** True while the worker refreshes the identity (lws thread only) */
+    bool identity_refresh_pending;
 
     /**
      * Authorization token used during the handshake ("XBL3.0 x=uhs;token").
@@ -130,13 +191,76 @@ typedef struct monitoring_context {
     char  *rx_buffer;
     size_t rx_buffer_size;
     size_t rx_buffer_used;
+
+    /** Background thread running the blocking HTTP jobs */
+    pthread_t worker_thread;
+
+    /** True while the worker thread must keep waiting for jobs (protected by @c jobs_mutex) */
+    bool worker_running;
+
+    /** Protects @c pending_jobs, @c completed_jobs and @c worker_running */
+    pthread_mutex_t jobs_mutex;
+
+    /** Signaled when a job is posted or when the worker must stop */
+    pthread_cond_t jobs_cond;
+
+    /** Jobs waiting to be executed by the worker thread */
+    monitor_job_queue_t pending_jobs;
+
+    /** Jobs executed by the worker thread, waiting to be applied on the lws thread */
+    monitor_job_queue_t completed_jobs;
+
+    /**
+     * Incremented on the lws thread each time the current game changes or a new
+     * game is requested. Lets the lws thread discard results of superseded requests.
+     */
+    uint64_t game_generation;
+
+    /** Identifier of the game most recently requested from the worker, if any */
+    char *requested_game_id;
+
+    /** True once the recently played games have been requested (lws thread only) */
+    bool prefetch_started;
+
+    /** Recently played games still waiting to be prefetched (lws thread only) */
+    recent_title_t *prefetch_titles;
+
+    /** Events waiting to be delivered to the subscribers */
+    event_queue_t *events;
+
+    /** Posted after each queued event and when the dispatcher must stop */
+    os_sem_t *events_posted;
+
+    /** Background thread delivering the events to the subscribers */
+    pthread_t dispatcher_thread;
+
+    /** True while the dispatcher thread must keep waiting for events */
+    volatile bool dispatcher_running;
+
+    /** Number of events dropped because the queue was full */
+    volatile long dropped_events;
 } monitoring_context_t;
 
 static monitoring_context_t *g_monitoring_context = NULL;
 
-/* Keeps track of the game, achievements and gamerscore */
+/* Whether the caches are warmed up once connected. Read on the lws thread, set from any thread. */
+static volatile bool g_prefetch_enabled = false;
+
+/* Keeps track of the game, achievements and gamerscore. Only accessed on the lws thread. */
 static xbox_session_t g_current_session;
 
+/* Immutable copies of g_current_session handed out to the other threads */
+static session_snapshot_publisher_t g_session_publisher;
+
+/**
+ * @brief Publish a snapshot of the current session for the readers on other threads.
+ *
+ * Must be called on the lws thread after each change of @c g_current_session.
+ */
+static void publish_current_session(void) {
+    session_snapshot_publish(&g_session_publisher, create_session_snapshot(&g_current_session));
+}
+
 /**
  * @brief Build the WebSocket "Authorization" header value for a given Xbox identity.
  *
@@ -161,8 +285,44 @@ static char *build_authorization_header(const xbox_identity_t *identity) {
     return bstrdup(auth_header);
 }
 
+static void free_event(monitor_event_t **event) {
+
+    if (!event || !*event) {
+        return;
+    }
+
+    monitor_event_t *current = *event;
+
+    release_session_snapshot(&current->snapshot);
+    free_achievement_progress(&current->progress);
+    free_memory((void **)&current->error_message);
+
+    bfree(current);
+    *event = NULL;
+}
+
 /**
- * @brief Invoke all registered game-played subscribers.
+ * @brief Queue an event for the dispatcher thread. Never blocks.
+ *
+ * Ownership of @p event is transferred. The event is dropped if the subscribers
+ * are too far behind.
+ */
+static void post_event(monitor_event_t *event) {
+
+    monitoring_context_t *ctx = g_monitoring_context;
+
+    if (!ctx || !event_queue_push(ctx->events, event)) {
+        long dropped = ctx ? os_atomic_inc_long(&ctx->dropped_events) : 0;
+        obs_log(LOG_WARNING, "Monitoring | Event dropped: the subscribers are too slow (%ld dropped)", dropped);
+        free_event(&event);
+        return;
+    }
+
+    os_sem_post(ctx->events_posted);
+}
+
+/**
+ * @brief Queue a game-played event for the subscribers.
  */
 static void notify_game_played(const game_t *game) {
 
@@ -173,47 +333,190 @@ static void notify_game_played(const game_t *game) {
 
     obs_log(LOG_INFO, "Notifying game played: %s (%s)", game->title, game->id);
 
-    game_played_subscription_t *subscriptions = g_game_played_subscriptions;
+    monitor_event_t *event = bzalloc(sizeof(monitor_event_t));
+    event->type            = MONITOR_EVENT_GAME_PLAYED;
+    event->snapshot        = session_snapshot_acquire(&g_session_publisher);
 
-    while (subscriptions) {
-        subscriptions->callback(game);
-        subscriptions = subscriptions->next;
-    }
+    post_event(event);
 }
 
 /**
- * @brief Invoke all registered achievement progressed subscribers.
+ * @brief Queue an achievements progressed event for the subscribers.
  */
 static void notify_achievements_progressed(const achievement_progress_t *achievements_progress) {
 
     obs_log(LOG_INFO, "Notifying achievements progress: %s", achievements_progress->service_config_id);
 
-    achievements_updated_subscription_t *subscription = g_achievements_updated_subscriptions;
+    monitor_event_t *event = bzalloc(sizeof(monitor_event_t));
+    event->type            = MONITOR_EVENT_ACHIEVEMENTS_PROGRESSED;
+    event->snapshot        = session_snapshot_acquire(&g_session_publisher);
+    event->progress        = copy_achievement_progress(achievements_progress);
 
-    while (subscription) {
-        subscription->callback(g_current_session.gamerscore, achievements_progress);
-        subscription = subscription->next;
-    }
+    post_event(event);
 }
 
 /**
- * @brief Invoke all registered connection state subscribers.
+ * @brief Queue a connection state event for the subscribers.
  */
 static void notify_connection_changed(bool is_connected, const char *error_message) {
 
-    UNUSED_PARAMETER(error_message);
-
     obs_log(LOG_INFO,
             "Notifying of a connection changed: %s (%s)",
             is_connected ? "Connected" : "Not connected",
             error_message);
 
-    connection_changed_subscription_t *node = g_connection_changed_subscriptions;
+    monitor_event_t *event = bzalloc(sizeof(monitor_event_t));
+    event->type            = MONITOR_EVENT_CONNECTION_CHANGED;
+    event->connected       = is_connected;
+    event->error_message   = error_message ? bstrdup(error_message) : NULL;
+
+    post_event(event);
+}
+
+/**
+ * @brief Invoke the subscribers of an event. Runs on the dispatcher thread.
+ *
+ * @param superseded True if a more recent event of the same type is part of the
+ *        batch: subscribers that only want the latest event skip this one.
+ */
+static void deliver_event(const monitor_event_t *event, bool superseded) {
+
+    const xbox_session_t *session = event->snapshot ? event->snapshot->session : NULL;
+
+    switch (event->type) {
+    case MONITOR_EVENT_GAME_PLAYED:
+        if (!session || !session->game) {
+            break;
+        }
+
+        for (game_played_subscription_t *node = g_game_played_subscriptions; node; node = node->next) {
+            if (!superseded || node->mode == XBOX_DELIVER_ALL) {
+                node->callback(session->game);
+            }
+        }
+        break;
+
+    case MONITOR_EVENT_ACHIEVEMENTS_PROGRESSED:
+        for (achievements_updated_subscription_t *node = g_achievements_updated_subscriptions; node;
+             node                                      = node->next) {
+            if (!superseded || node->mode == XBOX_DELIVER_ALL) {
+                node->callback(session ? session->gamerscore : NULL, event->progress);
+            }
+        }
+        break;
+
+    case MONITOR_EVENT_CONNECTION_CHANGED:
+        for (connection_changed_subscription_t *node = g_connection_changed_subscriptions; node; node = node->next) {
+            if (!superseded || node->mode == XBOX_DELIVER_ALL) {
+                node->callback(event->connected, event->error_message);
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Deliver every queued event, a batch at a time. Runs on the dispatcher thread.
+ */
+static void dispatch_pending_events(monitoring_context_t *ctx) {
+
+    monitor_event_t *batch[DISPATCH_BATCH_SIZE];
+    bool             superseded[DISPATCH_BATCH_SIZE];
+
+    for (;;) {
+
+        size_t count = 0;
+
+        while (count < DISPATCH_BATCH_SIZE && (batch[count] = event_queue_pop(ctx->events)) != NULL) {
+            count++;
+        }
+
+        if (count == 0) {
+            return;
+        }
+
+        /* Walks the batch backwards to flag the events followed by a more recent one of the same type */
+        bool seen[MONITOR_EVENT_TYPE_COUNT] = {false};
+
+        for (size_t i = count; i-- > 0;) {
+            superseded[i]         = seen[batch[i]->type];
+            seen[batch[i]->type] = true;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            deliver_event(batch[i], superseded[i]);
+            free_event(&batch[i]);
+        }
+    }
+}
+
+/**
+ * @brief Dispatcher thread entry point.
+ *
+ * Delivers the events queued by the lws thread so that slow subscribers never
+ * hold up the websocket. Events still queued when the thread is asked to stop are
+ * delivered before it exits.
+ */
+static void *dispatcher_thread(void *arg) {
+
+    monitoring_context_t *ctx = arg;
+
+    for (;;) {
+        os_sem_wait(ctx->events_posted);
+
+        dispatch_pending_events(ctx);
+
+        if (!os_atomic_load_bool(&ctx->dispatcher_running)) {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+static bool start_dispatcher_thread(monitoring_context_t *ctx) {
 
-    while (node) {
-        node->callback(is_connected, error_message);
-        node = node->next;
+    ctx->events = create_event_queue(EVENT_QUEUE_CAPACITY);
+
+    if (!ctx->events) {
+        return false;
+    }
+
+    if (os_sem_init(&ctx->events_posted, 0) != 0) {
+        free_event_queue(&ctx->events);
+        return false;
+    }
+
+    ctx->dispatcher_running = true;
+
+    if (pthread_create(&ctx->dispatcher_thread, NULL, dispatcher_thread, ctx) != 0) {
+        os_sem_destroy(ctx->events_posted);
+        ctx->events_posted = NULL;
+        free_event_queue(&ctx->events);
+        return false;
     }
+
+    return true;
+}
+
+/**
+ * @brief Stop the dispatcher thread once it has delivered every queued event.
+ *
+ * Must be called once no other thread can queue events anymore.
+ */
+static void stop_dispatcher_thread(monitoring_context_t *ctx) {
+
+    os_atomic_store_bool(&ctx->dispatcher_running, false);
+    os_sem_post(ctx->events_posted);
+
+    pthread_join(ctx->dispatcher_thread, NULL);
+
+    os_sem_destroy(ctx->events_posted);
+    ctx->events_posted = NULL;
+    free_event_queue(&ctx->events);
 }
 
 /**
@@ -257,6 +560,11 @@ static bool send_websocket_message(const char *message) {
  */
 static bool xbox_presence_subscribe() {
 
+    if (!g_monitoring_context || !g_monitoring_context->connected) {
+        obs_log(LOG_ERROR, "Monitoring | Cannot subscribe - not connected");
+        return false;
+    }
+
     xbox_identity_t *identity = state_get_xbox_identity();
 
     if (!identity) {
@@ -264,11 +572,6 @@ static bool xbox_presence_subscribe() {
         return false;
     }
 
-    if (!g_monitoring_context || !g_monitoring_context->connected) {
-        obs_log(LOG_ERROR, "Monitoring | Cannot subscribe - not connected");
-        return false;
-    }
-
     char message[512];
     snprintf(message,
              sizeof(message),
@@ -277,6 +580,8 @@ static bool xbox_presence_subscribe() {
              identity->xid);
 
     obs_log(LOG_INFO, "Monitoring | Subscribing for presence changes for XUID %s", identity->xid);
+    free_identity(&identity);
+
     return send_websocket_message(message);
 }
 
@@ -313,7 +618,7 @@ static bool xbox_achievements_progress_subscribe(const xbox_session_t *session)
         return false;
     }
 
-    const achievement_t *achievements = session->achievements;
+    const achievement_t *achievements = achievement_catalog_get_achievements(session->achievements);
 
     if (!achievements) {
         obs_log(LOG_ERROR, "Monitoring | No achievements specified");
@@ -322,6 +627,11 @@ static bool xbox_achievements_progress_subscribe(const xbox_session_t *session)
 
     const char *service_config_id = achievements->service_config_id;
 
+    if (!g_monitoring_context || !g_monitoring_context->connected) {
+        obs_log(LOG_ERROR, "Monitoring | Cannot subscribe - not connected");
+        return false;
+    }
+
     xbox_identity_t *identity = state_get_xbox_identity();
 
     if (!identity) {
@@ -329,11 +639,6 @@ static bool xbox_achievements_progress_subscribe(const xbox_session_t *session)
         return false;
     }
 
-    if (!g_monitoring_context || !g_monitoring_context->connected) {
-        obs_log(LOG_ERROR, "Monitoring | Cannot subscribe - not connected");
-        return false;
-    }
-
     char message[512];
     snprintf(message,
              sizeof(message),
@@ -347,6 +652,8 @@ static bool xbox_achievements_progress_subscribe(const xbox_session_t *session)
             service_config_id,
             identity->xid);
 
+    free_identity(&identity);
+
     return send_websocket_message(message);
 }
 
@@ -360,13 +667,18 @@ static bool xbox_achievements_progress_unsubscribe(const xbox_session_t *session
         return false;
     }
 
-    const achievement_t *achievements = session->achievements;
+    const achievement_t *achievements = achievement_catalog_get_achievements(session->achievements);
 
     if (!achievements) {
         obs_log(LOG_ERROR, "Monitoring | No achievements specified");
         return false;
     }
 
+    if (!g_monitoring_context || !g_monitoring_context->connected) {
+        obs_log(LOG_ERROR, "Monitoring | Cannot subscribe - not connected");
+        return false;
+    }
+
     xbox_identity_t *identity = state_get_xbox_identity();
 
     if (!identity) {
@@ -374,11 +686,6 @@ static bool xbox_achievements_progress_unsubscribe(const xbox_session_t *session
         return false;
     }
 
-    if (!g_monitoring_context || !g_monitoring_context->connected) {
-        obs_log(LOG_ERROR, "Monitoring | Cannot subscribe - not connected");
-        return false;
-    }
-
     char message[512];
     snprintf(message,
              sizeof(message),
@@ -392,30 +699,96 @@ static bool xbox_achievements_progress_unsubscribe(const xbox_session_t *session
             achievements->service_config_id,
             identity->xid);
 
+    free_identity(&identity);
+
     return send_websocket_message(message);
 }
 
+/**
+ * @brief Queue a job for the worker thread.
+ *
+ * Ownership of @p job is transferred to the monitoring context.
+ */
+static void post_job(monitoring_context_t *ctx, monitor_job_t *job) {
+
+    pthread_mutex_lock(&ctx->jobs_mutex);
+    monitor_job_queue_push(&ctx->pending_jobs, job);
+    pthread_cond_signal(&ctx->jobs_cond);
+    pthread_mutex_unlock(&ctx->jobs_mutex);
+}
+
+/**
+ * @brief Worker thread entry point.
+ *
+ * Takes every pending job at once and sends their requests before waiting for
+ * any of them, so a batch costs the slowest request rather than the sum of all.
+ * Background jobs are left out of the batch while foreground ones are waiting.
+ * Completed jobs are queued back and the lws thread is woken up to apply them.
+ */
+static void *worker_thread(void *arg) {
+
+    monitoring_context_t *ctx = arg;
+
+    pthread_mutex_lock(&ctx->jobs_mutex);
+
+    while (ctx->worker_running) {
+
+        monitor_job_t *jobs = monitor_job_queue_take_batch(&ctx->pending_jobs);
+
+        if (!jobs) {
+            pthread_cond_wait(&ctx->jobs_cond, &ctx->jobs_mutex);
+            continue;
+        }
+
+        pthread_mutex_unlock(&ctx->jobs_mutex);
+
+        for (monitor_job_t *job = jobs; job; job = job->next) {
+            monitor_job_begin(job);
+        }
+
+        for (monitor_job_t *job = jobs; job; job = job->next) {
+            monitor_job_end(job);
+        }
+
+        pthread_mutex_lock(&ctx->jobs_mutex);
+
+        while (jobs) {
+            monitor_job_t *next = jobs->next;
+            monitor_job_queue_push(&ctx->completed_jobs, jobs);
+            jobs = next;
+        }
+
+        /* Wakes up lws_service() so that the results are applied on the lws thread */
+        if (ctx->context) {
+            lws_cancel_service(ctx->context);
+        }
+    }
+
+    pthread_mutex_unlock(&ctx->jobs_mutex);
+
+    return 0;
+}
+
 /**
  * @brief Update the current game (including sessions and subscriptions) and notify listeners.
  *
  * This:
  *  - unsubscribes from previous achievements
- *  - refreshes the session (fetch achievements for new game)
+ *  - replaces the session's game and achievements
  *  - subscribes to achievement updates for the new game (if any)
  *  - notifies listeners
+ *
+ * Must be called on the lws thread. Ownership of @p achievements is transferred
+ * to the session.
  */
-static void xbox_change_game(game_t *game) {
-
-    if (game && xbox_session_is_game_played(&g_current_session, game)) {
-        /* No change */
-        return;
-    }
+static void xbox_change_game(const game_t *game, achievement_catalog_t *achievements) {
 
     /* First, let's make sure we unsubscribe from the previous achievements */
     xbox_achievements_progress_unsubscribe(&g_current_session);
 
-    /* Change the game which includes getting the new list of achievements */
-    xbox_session_change_game(&g_current_session, game);
+    /* Change the game which includes the new list of achievements */
+    xbox_session_set_game(&g_current_session, game, achievements);
+    publish_current_session();
 
     if (game) {
         /* Now let's subscribe to the new achievements */
@@ -426,12 +799,261 @@ static void xbox_change_game(game_t *game) {
     notify_game_played(game);
 }
 
+/**
+ * @brief Ask the worker thread to retrieve the achievements of a game.
+ *
+ * Any result of a previously requested game change is superseded.
+ *
+ * @param game Game to switch to. Ownership is transferred to the job. May be NULL
+ *             when @p lookup_current_game is true.
+ * @param lookup_current_game True to retrieve the currently played game first.
+ */
+static void request_game_change(game_t *game, bool lookup_current_game) {
+
+    monitoring_context_t *ctx = g_monitoring_context;
+
+    monitor_job_t *job       = bzalloc(sizeof(monitor_job_t));
+    job->type                = MONITOR_JOB_CHANGE_GAME;
+    job->lookup_current_game = lookup_current_game;
+    job->generation          = ++ctx->game_generation;
+    job->game                = game;
+
+    free_memory((void **)&ctx->requested_game_id);
+
+    if (game) {
+        ctx->requested_game_id = bstrdup(game->id);
+    }
+
+    post_job(ctx, job);
+}
+
 /**
  * @brief Handle a parsed game update message.
+ *
+ * Takes ownership of @p game.
  */
 static void on_game_update_received(game_t *game) {
 
-    xbox_change_game(game);
+    monitoring_context_t *ctx = g_monitoring_context;
+
+    if (!game) {
+        /* Nothing to retrieve: supersedes any pending request and applies right away */
+        ctx->game_generation++;
+        free_memory((void **)&ctx->requested_game_id);
+        xbox_change_game(NULL, NULL);
+        return;
+    }
+
+    if (ctx->requested_game_id && strcasecmp(ctx->requested_game_id, game->id) == 0) {
+        /* Already being retrieved */
+        free_game(&game);
+        return;
+    }
+
+    if (xbox_session_is_game_played(&g_current_session, game)) {
+        /* No change: supersedes any pending request for another game */
+        ctx->game_generation++;
+        free_memory((void **)&ctx->requested_game_id);
+        free_game(&game);
+        return;
+    }
+
+    request_game_change(game, false);
+}
+
+/**
+ * @brief Apply the result of a game change job. Runs on the lws thread.
+ */
+static void on_game_change_completed(monitoring_context_t *ctx, monitor_job_t *job) {
+
+    if (job->generation != ctx->game_generation) {
+        obs_log(LOG_DEBUG, "Monitoring | Discarding superseded game change");
+        return;
+    }
+
+    free_memory((void **)&ctx->requested_game_id);
+
+    if (job->game && xbox_session_is_game_played(&g_current_session, job->game)) {
+        /* No change */
+        return;
+    }
+
+    xbox_change_game(job->game, job->achievements);
+
+    /* The session now owns the achievements */
+    job->achievements = NULL;
+
+    if (job->from_cache) {
+        /* The cached achievements are shown: make sure they are still current */
+        monitor_job_t *revalidation = bzalloc(sizeof(monitor_job_t));
+        revalidation->type          = MONITOR_JOB_REVALIDATE_ACHIEVEMENTS;
+        revalidation->generation    = ctx->game_generation;
+        revalidation->game          = copy_game(job->game);
+        revalidation->etag          = job->etag;
+        revalidation->last_modified = job->last_modified;
+
+        job->etag          = NULL;
+        job->last_modified = NULL;
+
+        post_job(ctx, revalidation);
+    }
+}
+
+/**
+ * @brief Apply the result of an achievements revalidation. Runs on the lws thread.
+ */
+static void on_achievements_revalidated(monitoring_context_t *ctx, monitor_job_t *job) {
+
+    if (!job->achievements) {
+        /* Up to date (or unavailable): the cached achievements stay */
+        return;
+    }
+
+    if (job->generation != ctx->game_generation) {
+        obs_log(LOG_DEBUG, "Monitoring | Discarding achievements of a game no longer played");
+        return;
+    }
+
+    if (xbox_session_refresh_achievements(&g_current_session, job->game, job->achievements)) {
+        obs_log(LOG_INFO, "Monitoring | Achievements of %s refreshed", job->game->title);
+        publish_current_session();
+    }
+
+    /* Either owned by the session or freed */
+    job->achievements = NULL;
+}
+
+/**
+ * @brief Apply the result of a gamerscore job. Runs on the lws thread.
+ */
+static void on_gamerscore_fetched(const monitor_job_t *job) {
+
+    if (!job->succeeded) {
+        obs_log(LOG_WARNING, "Monitoring | Failed to retrieve the gamerscore");
+        return;
+    }
+
+    if (!g_current_session.gamerscore) {
+        g_current_session.gamerscore = bzalloc(sizeof(gamerscore_t));
+    }
+
+    g_current_session.gamerscore->base_value = (int)job->gamerscore;
+    publish_current_session();
+}
+
+/**
+ * @brief Post the prefetch job of the next recently played game, if any. Runs on the lws thread.
+ *
+ * Games are prefetched one at a time: each job is posted once the previous one
+ * completed, so a game change is batched with at most one prefetch.
+ */
+static void prefetch_next_title(monitoring_context_t *ctx) {
+
+    recent_title_t *title = ctx->prefetch_titles;
+
+    if (!title) {
+        return;
+    }
+
+    if (!g_prefetch_enabled) {
+        free_recent_titles(&ctx->prefetch_titles);
+        return;
+    }
+
+    ctx->prefetch_titles = title->next;
+    title->next          = NULL;
+
+    monitor_job_t *job = bzalloc(sizeof(monitor_job_t));
+    job->type          = MONITOR_JOB_PREFETCH_TITLE;
+    job->recent_titles = title;
+    post_job(ctx, job);
+}
+
+/**
+ * @brief Start prefetching the recently played games. Runs on the lws thread.
+ */
+static void on_recent_titles_fetched(monitoring_context_t *ctx, monitor_job_t *job) {
+
+    if (!job->recent_titles) {
+        obs_log(LOG_DEBUG, "Monitoring | No recently played game to prefetch");
+        return;
+    }
+
+    free_recent_titles(&ctx->prefetch_titles);
+    ctx->prefetch_titles = job->recent_titles;
+    job->recent_titles   = NULL;
+
+    prefetch_next_title(ctx);
+}
+
+/**
+ * @brief Use the identity refreshed by the worker for the next handshakes. Runs on the lws thread.
+ */
+static void on_identity_refreshed(monitoring_context_t *ctx, monitor_job_t *job) {
+
+    ctx->identity_refresh_pending = false;
+
+    if (!job->identity) {
+        obs_log(LOG_ERROR, "Monitoring | Failed to refresh the token");
+        return;
+    }
+
+    xbox_live_release_identity(&ctx->identity);
+    ctx->identity = job->identity;
+    job->identity = NULL;
+
+    /* Replace the cached auth header for future handshakes */
+    free_memory((void **)&ctx->auth_token);
+    ctx->auth_token = build_authorization_header(ctx->identity->identity);
+
+    obs_log(LOG_INFO, "Monitoring | Token refreshed");
+}
+
+/**
+ * @brief Apply every job completed by the worker thread. Runs on the lws thread.
+ */
+static void process_completed_jobs(monitoring_context_t *ctx) {
+
+    pthread_mutex_lock(&ctx->jobs_mutex);
+    monitor_job_t *jobs = monitor_job_queue_take_all(&ctx->completed_jobs);
+    pthread_mutex_unlock(&ctx->jobs_mutex);
+
+    while (jobs) {
+
+        monitor_job_t *job = jobs;
+        jobs               = job->next;
+
+        switch (job->type) {
+        case MONITOR_JOB_CHANGE_GAME:
+            on_game_change_completed(ctx, job);
+            break;
+
+        case MONITOR_JOB_FETCH_GAMERSCORE:
+            on_gamerscore_fetched(job);
+            break;
+
+        case MONITOR_JOB_REVALIDATE_ACHIEVEMENTS:
+            on_achievements_revalidated(ctx, job);
+            break;
+
+        case MONITOR_JOB_CACHE_PROGRESS:
+            break;
+
+        case MONITOR_JOB_FETCH_RECENT_TITLES:
+            on_recent_titles_fetched(ctx, job);
+            break;
+
+        case MONITOR_JOB_PREFETCH_TITLE:
+            prefetch_next_title(ctx);
+            break;
+
+        case MONITOR_JOB_REFRESH_IDENTITY:
+            on_identity_refreshed(ctx, job);
+            break;
+        }
+
+        free_monitor_job(&job);
+    }
 }
 
 /**
@@ -444,9 +1066,24 @@ static void on_achievement_progress_received(const achievement_progress_t *progr
         return;
     }
 
+    if (!g_current_session.gamerscore) {
+        /* The initial gamerscore has not been retrieved yet */
+        g_current_session.gamerscore = bzalloc(sizeof(gamerscore_t));
+    }
+
     /* TODO Progress is not necessarily achieved */
 
     xbox_session_unlock_achievement(&g_current_session, progress);
+    publish_current_session();
+
+    if (g_current_session.game) {
+        /* Keeps the cached achievements in line without blocking the lws thread on disk IO */
+        monitor_job_t *job = bzalloc(sizeof(monitor_job_t));
+        job->type          = MONITOR_JOB_CACHE_PROGRESS;
+        job->game          = copy_game(g_current_session.game);
+        job->progress      = copy_achievement_progress(progress);
+        post_job(g_monitoring_context, job);
+    }
 
     notify_achievements_progressed(progress);
 }
@@ -454,22 +1091,31 @@ static void on_achievement_progress_received(const achievement_progress_t *progr
 /**
  * @brief Called when the websocket transitions to connected state.
  *
- * Fetches the initial gamerscore, sets up subscriptions, and notifies listeners.
+ * Requests the initial gamerscore, sets up subscriptions, and notifies listeners.
+ * On the first connection, also starts prefetching the recently played games.
  */
 static void on_websocket_connected() {
 
-    int64_t gamerscore_value;
-    xbox_fetch_gamerscore(&gamerscore_value);
-
     if (!g_current_session.gamerscore) {
-        g_current_session.gamerscore             = bzalloc(sizeof(gamerscore_t));
-        g_current_session.gamerscore->base_value = (int)gamerscore_value;
+        monitor_job_t *job = bzalloc(sizeof(monitor_job_t));
+        job->type          = MONITOR_JOB_FETCH_GAMERSCORE;
+        post_job(g_monitoring_context, job);
+    }
+
+    if (g_prefetch_enabled && !g_monitoring_context->prefetch_started) {
+        monitor_job_t *job = bzalloc(sizeof(monitor_job_t));
+        job->type          = MONITOR_JOB_FETCH_RECENT_TITLES;
+        post_job(g_monitoring_context, job);
+
+        g_monitoring_context->prefetch_started = true;
     }
 
     xbox_presence_subscribe();
 
     xbox_achievements_progress_subscribe(&g_current_session);
 
+    publish_current_session();
+
     notify_connection_changed(true, NULL);
 }
 
@@ -479,6 +1125,7 @@ static void on_websocket_connected() {
 static void on_websocket_disconnected() {
 
     xbox_session_clear(&g_current_session);
+    publish_current_session();
 
     notify_connection_changed(false, NULL);
 }
@@ -487,14 +1134,12 @@ static void on_websocket_disconnected() {
  * @brief Process a single, complete websocket message buffer.
  *
  * Xbox RTA messages are arrays; this function extracts index 2 and interprets it as
- * a JSON message. Known message types are dispatched to the relevant parsers.
+ * a JSON message. The frame is parsed exactly once: the payload node is classified
+ * in place and handed to the node-based parsers without being re-serialized.
  */
 static void on_buffer_received(const char *buffer) {
 
-    cJSON  *presence_item = NULL;
-    game_t *game          = NULL;
-    char   *message       = NULL;
-    cJSON  *root          = NULL;
+    cJSON *root = NULL;
 
     if (!buffer) {
         return;
@@ -509,38 +1154,33 @@ static void on_buffer_received(const char *buffer) {
         return;
     }
 
-    /* Retrieves the presence message at index 2 */
-    presence_item = cJSON_GetArrayItem(root, 2);
+    /* Retrieves the message at index 2 */
+    const cJSON *message = cJSON_GetArrayItem(root, 2);
 
-    if (!presence_item) {
+    if (!message) {
         obs_log(LOG_WARNING, "No presence item found");
         goto cleanup;
     }
 
-    message = cJSON_PrintUnformatted(presence_item);
-
-    if (strlen(message) < 5) {
-        obs_log(LOG_DEBUG, "No message");
-        goto cleanup;
-    }
-
-    obs_log(LOG_DEBUG, "Message is %s", message);
-
-    if (is_presence_message(message)) {
+    switch (get_rta_message_type(message)) {
+    case RTA_MESSAGE_PRESENCE: {
         obs_log(LOG_DEBUG, "Message is a presence message");
-        game = parse_game(message);
+        game_t *game = parse_game_from_node(message);
         on_game_update_received(game);
-        goto cleanup;
+        break;
     }
-
-    if (is_achievement_message(message)) {
+    case RTA_MESSAGE_ACHIEVEMENT: {
         obs_log(LOG_DEBUG, "Message is an achievement message");
-        const achievement_progress_t *progress = parse_achievement_progress(message);
+        const achievement_progress_t *progress = parse_achievement_progress_from_node(message);
         on_achievement_progress_received(progress);
+        break;
+    }
+    default:
+        obs_log(LOG_DEBUG, "No message");
+        break;
     }
 
 cleanup:
-    FREE(message);
     FREE_JSON(root);
 }
 
@@ -625,31 +1265,25 @@ static int websocket_callback(struct lws *wsi, enum lws_callback_reasons reason,
          * We use this as a lightweight place to refresh credentials if needed.
          * Note: libwebsockets does not automatically update handshake headers
          * for an already-established connection. Refreshing @c ctx->auth_token
-         * here prepares the next connection attempt (reconnect) to use fresh
+         * prepares the next connection attempt (reconnect) to use fresh
          * credentials.
+         *
+         * The refresh may block: it is posted to the worker thread and applied
+         * in on_identity_refreshed().
          */
         obs_log(LOG_DEBUG, "Monitoring | Checking token");
 
-        if (g_monitoring_context->identity && !token_is_expired(g_monitoring_context->identity->token)) {
+        if (ctx->identity_refresh_pending || (ctx->identity && !token_is_expired(ctx->identity->identity->token))) {
             break;
         }
 
         obs_log(LOG_INFO, "Monitoring | Refreshing token");
 
-        free_memory((void **)&g_monitoring_context->auth_token);
-        free_memory((void **)&g_monitoring_context->identity);
+        monitor_job_t *refresh = bzalloc(sizeof(monitor_job_t));
+        refresh->type          = MONITOR_JOB_REFRESH_IDENTITY;
 
-        g_monitoring_context->identity = xbox_live_get_identity();
-
-        if (!g_monitoring_context->identity) {
-            obs_log(LOG_ERROR, "Monitoring | Failed to refresh the token");
-            break;
-        }
-
-        /* Replace the cached auth header for future handshakes */
-        g_monitoring_context->auth_token = build_authorization_header(g_monitoring_context->identity);
-
-        obs_log(LOG_INFO, "Monitoring | Token refreshed");
+        ctx->identity_refresh_pending = true;
+        post_job(ctx, refresh);
 
         break;
     case LWS_CALLBACK_CLIENT_CONNECTION_ERROR:
@@ -669,6 +1303,11 @@ static int websocket_callback(struct lws *wsi, enum lws_callback_reasons reason,
         ctx->wsi = NULL;
         break;
 
+    case LWS_CALLBACK_EVENT_WAIT_CANCELLED:
+        /* Woken up by the worker thread (or by xbox_monitoring_stop) */
+        process_completed_jobs(ctx);
+        break;
+
     default:
         break;
     }
@@ -739,8 +1378,7 @@ static void *monitoring_thread(void *arg) {
     }
 
     /* Immediately retrieves the game */
-    game_t *current_game = xbox_get_current_game();
-    xbox_change_game(current_game);
+    request_game_change(NULL, true);
 
     /* Service the WebSocket connection */
     while (ctx->running && ctx->context) {
@@ -757,6 +1395,21 @@ static void *monitoring_thread(void *arg) {
     return 0;
 }
 
+/**
+ * @brief Stop the worker thread and wait for it to finish its current job.
+ *
+ * Jobs still queued are left in place; they are freed with the context.
+ */
+static void stop_worker_thread(monitoring_context_t *ctx) {
+
+    pthread_mutex_lock(&ctx->jobs_mutex);
+    ctx->worker_running = false;
+    pthread_cond_signal(&ctx->jobs_cond);
+    pthread_mutex_unlock(&ctx->jobs_mutex);
+
+    pthread_join(ctx->worker_thread, NULL);
+}
+
 //  --------------------------------------------------------------------------------------------------------------------
 //  Public functions
 //  --------------------------------------------------------------------------------------------------------------------
@@ -774,8 +1427,11 @@ bool xbox_monitoring_start() {
         return false;
     }
 
+    /* A previous stop may have interrupted the waits of the blocking requests */
+    http_resume_waits();
+
     /* Get the authorization token from state */
-    xbox_identity_t *identity = xbox_live_get_identity();
+    xbox_identity_handle_t *identity = xbox_live_acquire_identity();
 
     if (!identity) {
         obs_log(LOG_ERROR, "Monitoring | No identity available");
@@ -786,10 +1442,11 @@ bool xbox_monitoring_start() {
 
     if (!g_monitoring_context) {
         obs_log(LOG_ERROR, "Monitoring | Failed to allocate context");
+        xbox_live_release_identity(&identity);
         return false;
     }
 
-    char *authorization_header = build_authorization_header(identity);
+    char *authorization_header = build_authorization_header(identity->identity);
 
     g_monitoring_context->identity   = identity;
     g_monitoring_context->running    = true;
@@ -804,6 +1461,34 @@ bool xbox_monitoring_start() {
     if (!g_monitoring_context->rx_buffer) {
         obs_log(LOG_ERROR, "Monitoring | Failed to allocate receive buffer");
         bfree(g_monitoring_context->auth_token);
+        xbox_live_release_identity(&g_monitoring_context->identity);
+        bfree(g_monitoring_context);
+        g_monitoring_context = NULL;
+        return false;
+    }
+
+    if (!start_dispatcher_thread(g_monitoring_context)) {
+        obs_log(LOG_ERROR, "Monitoring | Failed to create dispatcher thread");
+        bfree(g_monitoring_context->rx_buffer);
+        bfree(g_monitoring_context->auth_token);
+        xbox_live_release_identity(&g_monitoring_context->identity);
+        bfree(g_monitoring_context);
+        g_monitoring_context = NULL;
+        return false;
+    }
+
+    pthread_mutex_init(&g_monitoring_context->jobs_mutex, NULL);
+    pthread_cond_init(&g_monitoring_context->jobs_cond, NULL);
+    g_monitoring_context->worker_running = true;
+
+    if (pthread_create(&g_monitoring_context->worker_thread, NULL, worker_thread, g_monitoring_context) != 0) {
+        obs_log(LOG_ERROR, "Monitoring | Failed to create worker thread");
+        stop_dispatcher_thread(g_monitoring_context);
+        pthread_cond_destroy(&g_monitoring_context->jobs_cond);
+        pthread_mutex_destroy(&g_monitoring_context->jobs_mutex);
+        bfree(g_monitoring_context->rx_buffer);
+        bfree(g_monitoring_context->auth_token);
+        xbox_live_release_identity(&g_monitoring_context->identity);
         bfree(g_monitoring_context);
         g_monitoring_context = NULL;
         return false;
@@ -811,8 +1496,11 @@ bool xbox_monitoring_start() {
 
     if (pthread_create(&g_monitoring_context->thread, NULL, monitoring_thread, g_monitoring_context) != 0) {
         obs_log(LOG_ERROR, "Monitoring | Failed to create monitoring thread");
+        stop_worker_thread(g_monitoring_context);
+        stop_dispatcher_thread(g_monitoring_context);
         bfree(g_monitoring_context->rx_buffer);
         bfree(g_monitoring_context->auth_token);
+        xbox_live_release_identity(&g_monitoring_context->identity);
         bfree(g_monitoring_context);
         g_monitoring_context = NULL;
         return false;
@@ -834,6 +1522,12 @@ void xbox_monitoring_stop(void) {
 
     obs_log(LOG_INFO, "Monitoring | Stopping monitoring");
 
+    /* The worker may be waiting for a throttled request to be retried */
+    http_interrupt_waits();
+
+    /* The worker must be gone before the lws context gets destroyed */
+    stop_worker_thread(g_monitoring_context);
+
     g_monitoring_context->running = false;
 
     if (g_monitoring_context->context) {
@@ -842,10 +1536,25 @@ void xbox_monitoring_stop(void) {
 
     pthread_join(g_monitoring_context->thread, NULL);
 
+    /* The lws thread is gone: readers must not pick up its session anymore */
+    session_snapshot_publish(&g_session_publisher, NULL);
+
+    /* Nothing can queue events anymore: deliver the remaining ones and stop */
+    stop_dispatcher_thread(g_monitoring_context);
+
+    free_monitor_jobs(monitor_job_queue_take_all(&g_monitoring_context->pending_jobs));
+    free_monitor_jobs(monitor_job_queue_take_all(&g_monitoring_context->completed_jobs));
+    pthread_cond_destroy(&g_monitoring_context->jobs_cond);
+    pthread_mutex_destroy(&g_monitoring_context->jobs_mutex);
+    free_memory((void **)&g_monitoring_context->requested_game_id);
+    free_recent_titles(&g_monitoring_context->prefetch_titles);
+
     if (g_monitoring_context->auth_token) {
         bfree(g_monitoring_context->auth_token);
     }
 
+    xbox_live_release_identity(&g_monitoring_context->identity);
+
     if (g_monitoring_context->rx_buffer) {
         bfree(g_monitoring_context->rx_buffer);
     }
@@ -868,43 +1577,27 @@ bool xbox_monitoring_is_active(void) {
 }
 
 /**
- * @brief Get the currently cached game from the active session.
+ * @brief Enable or disable the prefetching of the recently played games.
  *
- * Ownership/lifetime: the returned pointer is owned by the monitor/session and
- * may be replaced when the current game changes or when monitoring stops.
- *
- * @return Cached game, or NULL if no game is currently known.
+ * Games are prefetched one job at a time: when disabled, the game being
+ * prefetched, if any, completes and the ones still waiting are dropped.
  */
-const game_t *get_current_game() {
-    return g_current_session.game;
+void xbox_monitoring_set_prefetch_enabled(bool enabled) {
+    g_prefetch_enabled = enabled;
 }
 
 /**
- * @brief Get the most recently cached gamerscore associated with the current session.
- *
- * This snapshot is initialized when the websocket connects (via an initial
- * gamerscore fetch) and then updated as achievement progression messages are
- * processed.
+ * @brief Get a consistent snapshot of the game, achievements and gamerscore of the active session.
  *
- * Ownership/lifetime: the returned pointer is owned by the monitor/session and
- * remains valid until the next update or until monitoring stops.
+ * The snapshot is an immutable copy published by the lws thread each time the
+ * session changes. Acquiring it never blocks and it stays valid, even if the
+ * session changes or monitoring stops, until it is released.
  *
- * @return Cached gamerscore snapshot, or NULL if not available yet.
+ * @return Snapshot to release with @ref release_session_snapshot, or NULL if
+ *         monitoring has not produced any session yet.
  */
-const gamerscore_t *get_current_gamerscore(void) {
-    return g_current_session.gamerscore;
-}
-
-/**
- * @brief Get the currently cached achievements list from the active session.
- *
- * Ownership/lifetime: the returned pointer is owned by the monitor/session and
- * may be replaced when the current game changes or when monitoring stops.
- *
- * @return Cached achievements list, or NULL if not available.
- */
-const achievement_t *get_current_game_achievements() {
-    return g_current_session.achievements;
+session_snapshot_t *get_current_session_snapshot(void) {
+    return session_snapshot_acquire(&g_session_publisher);
 }
 
 /**
@@ -916,9 +1609,9 @@ const achievement_t *get_current_game_achievements() {
  * - If a game is already known at subscription time, the callback is invoked
  *   immediately with the cached game.
  *
- * Threading: callbacks may be invoked from the monitor thread.
+ * Threading: callbacks are invoked from the dispatcher thread.
  */
-void xbox_subscribe_game_played(const on_xbox_game_played_t callback) {
+void xbox_subscribe_game_played(const on_xbox_game_played_t callback, xbox_delivery_mode_t mode) {
 
     if (!callback) {
         return;
@@ -932,13 +1625,18 @@ void xbox_subscribe_game_played(const on_xbox_game_played_t callback) {
     }
 
     new_subscription->callback  = callback;
+    new_subscription->mode      = mode;
     new_subscription->next      = g_game_played_subscriptions;
     g_game_played_subscriptions = new_subscription;
 
     /* Immediately sends the game if there is one being played */
-    if (g_current_session.game) {
-        callback(g_current_session.game);
+    session_snapshot_t *snapshot = get_current_session_snapshot();
+
+    if (snapshot && snapshot->session->game) {
+        callback(snapshot->session->game);
     }
+
+    release_session_snapshot(&snapshot);
 }
 
 /**
@@ -948,9 +1646,9 @@ void xbox_subscribe_game_played(const on_xbox_game_played_t callback) {
  * - Each call registers an additional callback (fan-out).
  * - There is currently no unsubscribe API; callbacks live until process exit.
  *
- * Threading: callbacks may be invoked from the monitor thread.
+ * Threading: callbacks are invoked from the dispatcher thread.
  */
-void xbox_subscribe_achievements_progressed(on_xbox_achievements_progressed_t callback) {
+void xbox_subscribe_achievements_progressed(on_xbox_achievements_progressed_t callback, xbox_delivery_mode_t mode) {
 
     if (!callback) {
         return;
@@ -964,6 +1662,7 @@ void xbox_subscribe_achievements_progressed(on_xbox_achievements_progressed_t ca
     }
 
     new_subscription->callback           = callback;
+    new_subscription->mode               = mode;
     new_subscription->next               = g_achievements_updated_subscriptions;
     g_achievements_updated_subscriptions = new_subscription;
 }
@@ -977,9 +1676,9 @@ void xbox_subscribe_achievements_progressed(on_xbox_achievements_progressed_t ca
  * - If the monitor context already exists, the callback is invoked immediately
  *   with the current connection state.
  *
- * Threading: callbacks may be invoked from the monitor thread.
+ * Threading: callbacks are invoked from the dispatcher thread.
  */
-void xbox_subscribe_connected_changed(const on_xbox_connection_changed_t callback) {
+void xbox_subscribe_connected_changed(const on_xbox_connection_changed_t callback, xbox_delivery_mode_t mode) {
     if (!callback) {
         return;
     }
@@ -992,6 +1691,7 @@ void xbox_subscribe_connected_changed(const on_xbox_connection_changed_t callbac
     }
 
     new_node->callback                 = callback;
+    new_node->mode                     = mode;
     new_node->next                     = g_connection_changed_subscriptions;
     g_connection_changed_subscriptions = new_node;
 
@@ -1017,28 +1717,27 @@ bool xbox_monitoring_is_active(void) {
     return false;
 }
 
-const gamerscore_t *get_current_gamerscore(void) {
-    return NULL;
-}
-
-const game_t *get_current_game() {
-    return NULL;
+void xbox_monitoring_set_prefetch_enabled(bool enabled) {
+    (void)enabled;
 }
 
-const achievement_t *get_current_game_achievements() {
+session_snapshot_t *get_current_session_snapshot(void) {
     return NULL;
 }
 
-void xbox_subscribe_game_played(const on_xbox_game_played_t callback) {
+void xbox_subscribe_game_played(const on_xbox_game_played_t callback, xbox_delivery_mode_t mode) {
     (void)callback;
+    (void)mode;
 }
 
-void xbox_subscribe_achievements_progressed(on_xbox_achievements_progressed_t callback) {
+void xbox_subscribe_achievements_progressed(on_xbox_achievements_progressed_t callback, xbox_delivery_mode_t mode) {
     (void)callback;
+    (void)mode;
 }
 
-void xbox_subscribe_connected_changed(const on_xbox_connection_changed_t callback) {
+void xbox_subscribe_connected_changed(const on_xbox_connection_changed_t callback, xbox_delivery_mode_t mode) {
     (void)callback;
+    (void)mode;
 }
 
 #endif /* HAVE_LIBWEBSOCKETS */
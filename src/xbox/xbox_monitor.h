@@ -2,6 +2,7 @@
 
 #include <stdbool.h>
 #include "common/types.h"
+#include "xbox/session_snapshot.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,16 +17,29 @@ extern "C" {
  * achievements progressed, connection state changes).
  *
  * Threading:
- *  - Callbacks may be invoked from the monitor's networking thread.
- *  - Callbacks must return quickly and must not perform OBS graphics operations
- *    directly (use obs_enter_graphics/obs_leave_graphics or schedule work).
+ *  - Callbacks are invoked from a dispatcher thread fed by a bounded queue, so a
+ *    slow callback delays the other subscribers but never the networking thread.
+ *    If the subscribers fall too far behind, new events are dropped.
+ *  - Callbacks must not perform OBS graphics operations directly (use
+ *    obs_enter_graphics/obs_leave_graphics or schedule work).
  *
  * Ownership/lifetime:
  *  - Pointers passed to callbacks (e.g., game_t/gamerscore_t/progress lists) are
- *    owned by the monitor and remain valid until the next update or until
- *    monitoring stops. If you need to keep them, make a deep copy.
+ *    owned by the monitor and only remain valid during the callback. If you need
+ *    to keep them, make a deep copy.
+ *  - Other threads read the session through @ref get_current_session_snapshot.
  */
 
+/**
+ * @brief How the events of a subscription are delivered.
+ */
+typedef enum xbox_delivery_mode {
+    /** Every event is delivered, in order. */
+    XBOX_DELIVER_ALL,
+    /** When several events of the same kind are waiting, only the most recent one is delivered. */
+    XBOX_DELIVER_LATEST,
+} xbox_delivery_mode_t;
+
 /**
  * @brief Callback invoked for every raw JSON message received from the RTA endpoint.
  *
@@ -58,37 +72,17 @@ typedef void (*on_xbox_achievements_progressed_t)(const gamerscore_t           *
 typedef void (*on_xbox_connection_changed_t)(bool connected, const char *error_message);
 
 /**
- * @brief Get the most recently cached gamerscore snapshot.
- *
- * Ownership/lifetime: the returned pointer is owned by the monitor and may be
- * replaced on the next incoming update. Copy it if you need to keep it.
- *
- * Threading: safe to call from any thread but the returned object may change
- * asynchronously while monitoring is running.
+ * @brief Get a snapshot of the current session (game, achievements and gamerscore).
  *
- * @return Pointer to the current gamerscore snapshot, or NULL if unknown.
- */
-const gamerscore_t *get_current_gamerscore(void);
-
-/**
- * @brief Get the most recently detected currently played game.
+ * Ownership/lifetime: the returned snapshot is immutable and remains valid until
+ * it is released with @ref release_session_snapshot, even if the session changes
+ * or monitoring stops in the meantime.
  *
- * Ownership/lifetime: the returned pointer is owned by the monitor and remains
- * valid until the next update or until monitoring stops.
+ * Threading: safe to call from any thread; never blocks.
  *
- * @return Pointer to the current game, or NULL if none is known.
+ * @return Snapshot of the current session, or NULL if none is known.
  */
-const game_t *get_current_game(void);
-
-/**
- * @brief Get the most recently cached achievements list for the current game.
- *
- * Ownership/lifetime: the returned pointer is owned by the monitor and remains
- * valid until the next update or until monitoring stops.
- *
- * @return Pointer to the cached achievements list, or NULL if not available.
- */
-const achievement_t *get_current_game_achievements(void);
+session_snapshot_t *get_current_session_snapshot(void);
 
 /**
  * @brief Start monitoring the Xbox Live RTA endpoint.
@@ -111,14 +105,30 @@ void xbox_monitoring_stop(void);
  */
 bool xbox_monitoring_is_active(void);
 
+/**
+ * @brief Enable or disable the prefetching of the recently played games.
+ *
+ * When enabled, the achievements and cover art of the games the user played most
+ * recently are stored in the on-disk caches in the background once monitoring
+ * connects, so switching to one of them during a stream does not wait for the
+ * network. Disabled by default, since it costs a burst of requests.
+ *
+ * When disabled, the game being prefetched, if any, completes; the games still
+ * waiting to be prefetched are dropped.
+ *
+ * @param enabled True to prefetch the recently played games.
+ */
+void xbox_monitoring_set_prefetch_enabled(bool enabled);
+
 /**
  * @brief Subscribe to game-played events.
  *
  * Passing NULL clears/unsubscribes the callback.
  *
  * @param callback Callback invoked when the current game changes.
+ * @param mode Whether every event or only the latest waiting one is delivered.
  */
-void xbox_subscribe_game_played(on_xbox_game_played_t callback);
+void xbox_subscribe_game_played(on_xbox_game_played_t callback, xbox_delivery_mode_t mode);
 
 /**
  * @brief Subscribe to achievement progress events.
@@ -126,8 +136,9 @@ void xbox_subscribe_game_played(on_xbox_game_played_t callback);
  * Passing NULL clears/unsubscribes the callback.
  *
  * @param callback Callback invoked when achievement progress is received.
+ * @param mode Whether every event or only the latest waiting one is delivered.
  */
-void xbox_subscribe_achievements_progressed(on_xbox_achievements_progressed_t callback);
+void xbox_subscribe_achievements_progressed(on_xbox_achievements_progressed_t callback, xbox_delivery_mode_t mode);
 
 /**
  * @brief Subscribe to connection state change events.
@@ -135,8 +146,9 @@ void xbox_subscribe_achievements_progressed(on_xbox_achievements_progressed_t ca
  * Passing NULL clears/unsubscribes the callback.
  *
  * @param callback Callback invoked when connectivity changes.
+ * @param mode Whether every event or only the latest waiting one is delivered.
  */
-void xbox_subscribe_connected_changed(on_xbox_connection_changed_t callback);
+void xbox_subscribe_connected_changed(on_xbox_connection_changed_t callback, xbox_delivery_mode_t mode);
 
 #ifdef __cplusplus
 }
@@ -9,39 +9,6 @@
 #include <errno.h>
 #include <stdlib.h>
 
-//  --------------------------------------------------------------------------------------------------------------------
-//  Private functions.
-//  --------------------------------------------------------------------------------------------------------------------
-
-/**
- * @brief Finds an achievement definition by id.
- *
- * Performs a case-insensitive search of the @p achievements linked list for an
- * entry whose @c id matches @c progress->id.
- *
- * @param progress Progress item containing the achievement id to look up.
- * @param achievements Head of the achievements linked list.
- *
- * @return Pointer to the matching achievement node within @p achievements, or
- *         NULL if not found.
- */
-static const achievement_t *find_achievement_by_id(const achievement_progress_t *progress,
-                                                   const achievement_t          *achievements) {
-
-    const achievement_t *current = achievements;
-
-    while (current) {
-
-        if (strcasecmp(current->id, progress->id) == 0) {
-            return current;
-        }
-
-        current = current->next;
-    }
-
-    return NULL;
-}
-
 //  --------------------------------------------------------------------------------------------------------------------
 //  Public functions.
 //  --------------------------------------------------------------------------------------------------------------------
@@ -88,29 +55,78 @@ void xbox_session_change_game(xbox_session_t *session, game_t *game) {
         return;
     }
 
-    free_achievement(&session->achievements);
+    /* Let's get the achievements of the game */
+    achievement_catalog_t *achievements = game ? xbox_get_game_achievements(game) : NULL;
+
+    xbox_session_set_game(session, game, achievements);
+}
+
+/**
+ * @brief Switches the session to a new game whose achievements are already known.
+ *
+ * Frees any existing achievements and game stored in the session, then stores a
+ * copy of @p game and takes ownership of @p achievements.
+ *
+ * @param session Session to update (must not be NULL).
+ * @param game New game to set. If NULL, the session is cleared.
+ * @param achievements Achievements of @p game. Ownership is transferred to the
+ *        session; freed immediately if @p session or @p game is NULL.
+ */
+void xbox_session_set_game(xbox_session_t *session, const game_t *game, achievement_catalog_t *achievements) {
+
+    if (!session) {
+        obs_log(LOG_ERROR, "Failed to set game: session is NULL");
+        free_achievement_catalog(&achievements);
+        return;
+    }
+
+    free_achievement_catalog(&session->achievements);
     free_game(&session->game);
 
-    /* Let's get the achievements of the game */
     if (!game) {
+        free_achievement_catalog(&achievements);
         return;
     }
 
     session->game         = copy_game(game);
-    session->achievements = xbox_get_game_achievements(game);
+    session->achievements = achievements;
+}
+
+/**
+ * @brief Replaces the achievements of the game being played.
+ *
+ * @param session Session to update (may be NULL).
+ * @param game Game the achievements belong to (may be NULL).
+ * @param achievements New achievements. Ownership is transferred to the session
+ *        when applied; freed otherwise.
+ * @return true if the achievements were replaced.
+ */
+bool xbox_session_refresh_achievements(xbox_session_t        *session,
+                                       const game_t          *game,
+                                       achievement_catalog_t *achievements) {
+
+    if (!session || !achievements || !xbox_session_is_game_played(session, game)) {
+        free_achievement_catalog(&achievements);
+        return false;
+    }
+
+    free_achievement_catalog(&session->achievements);
+    session->achievements = achievements;
+
+    return true;
 }
 
 /**
  * @brief Applies an achievement progress update to the current session.
  *
- * Looks up the achievement by id and, if it has a reward, appends a new entry to
- * the session's @c gamerscore->unlocked_achievements list.
+ * Looks up the achievement by id in the catalog (constant time) and, if it has a
+ * reward, records it in the session's gamerscore (constant time).
  *
  * Current behavior/assumptions:
  * - The function assumes the first reward's @c value is a numeric gamerscore
- *   amount and will parse it via @c atoi().
- * - No de-duplication is performed; callers should avoid sending the same unlock
- *   multiple times.
+ *   amount and will parse it via @c strtol().
+ * - Achievements already unlocked are ignored, so replayed progression events do
+ *   not count twice.
  *
  * @param session Session to update (may be NULL).
  * @param progress Progress update indicating which achievement was unlocked
@@ -124,7 +140,7 @@ void xbox_session_unlock_achievement(xbox_session_t *session, const achievement_
 
     /* TODO Let's make sure the progress is achieved */
 
-    const achievement_t *achievement = find_achievement_by_id(progress, session->achievements);
+    const achievement_t *achievement = achievement_catalog_find(session->achievements, progress->id);
 
     if (!achievement) {
         obs_log(LOG_ERROR,
@@ -144,8 +160,11 @@ void xbox_session_unlock_achievement(xbox_session_t *session, const achievement_
 
     gamerscore_t *gamerscore = session->gamerscore;
 
-    unlocked_achievement_t *unlocked_achievement = bzalloc(sizeof(unlocked_achievement_t));
-    unlocked_achievement->id                     = bstrdup(progress->id);
+    if (gamerscore_is_unlocked(gamerscore, progress->id)) {
+        /* Replayed progression event: the achievement has already been counted */
+        obs_log(LOG_DEBUG, "Achievement %s is already unlocked", progress->id);
+        return;
+    }
 
     long  parsed_value = 0;
     char *endptr       = NULL;
@@ -163,25 +182,15 @@ void xbox_session_unlock_achievement(xbox_session_t *session, const achievement_
         parsed_value = 0;
     }
 
-    unlocked_achievement->value = (int)parsed_value;
-
-    unlocked_achievement_t *unlocked_achievements = gamerscore->unlocked_achievements;
-
-    /* Appends the unlocked achievement to the list */
-    if (!unlocked_achievements) {
-        gamerscore->unlocked_achievements = unlocked_achievement;
-    } else {
-        unlocked_achievement_t *last_unlocked_achievement = unlocked_achievements;
-        while (last_unlocked_achievement->next) {
-            last_unlocked_achievement = last_unlocked_achievement->next;
-        }
-        last_unlocked_achievement->next = unlocked_achievement;
+    if (!gamerscore_add_unlocked_achievement(gamerscore, progress->id, (int)parsed_value)) {
+        obs_log(LOG_ERROR, "Failed to unlock achievement %s", progress->id ? progress->id : "(null)");
+        return;
     }
 
     obs_log(LOG_INFO,
             "New achievement unlocked: %s (%d G)! Gamerscore is now %d",
             achievement->name,
-            unlocked_achievement->value,
+            (int)parsed_value,
             xbox_session_compute_gamerscore(session));
 }
 
@@ -203,7 +212,7 @@ void xbox_session_clear(xbox_session_t *session) {
         return;
     }
 
-    free_achievement(&session->achievements);
+    free_achievement_catalog(&session->achievements);
     free_game(&session->game);
     free_gamerscore(&session->gamerscore);
 }
@@ -50,6 +50,45 @@ bool xbox_session_is_game_played(xbox_session_t *session, const game_t *game);
  */
 void xbox_session_change_game(xbox_session_t *session, game_t *game);
 
+/**
+ * @brief Updates the session to use a new current game and its achievements.
+ *
+ * Same as xbox_session_change_game() except that no network request is made:
+ * the achievements list has already been retrieved by the caller (typically on
+ * a worker thread).
+ *
+ * Ownership:
+ *  - The session makes its own copy of @p game.
+ *  - The session takes ownership of @p achievements.
+ *  - If @p game is NULL, the session is cleared and @p achievements is freed.
+ *
+ * @param session Session to update.
+ * @param game New game to set for this session.
+ * @param achievements Achievements catalog of @p game (may be NULL).
+ */
+void xbox_session_set_game(xbox_session_t *session, const game_t *game, achievement_catalog_t *achievements);
+
+/**
+ * @brief Replaces the achievements of the game being played.
+ *
+ * Used when an up-to-date list is received for the game already shown, e.g.
+ * after the cached achievements of the game have been revalidated. The game and
+ * the gamerscore of the session are left untouched.
+ *
+ * Ownership:
+ *  - The session takes ownership of @p achievements when they are applied;
+ *    otherwise they are freed.
+ *
+ * @param session Session to update.
+ * @param game Game the achievements belong to.
+ * @param achievements New achievements catalog of @p game.
+ *
+ * @return true if @p game is the game being played and the achievements were replaced.
+ */
+bool xbox_session_refresh_achievements(xbox_session_t        *session,
+                                       const game_t          *game,
+                                       achievement_catalog_t *achievements);
+
 /**
  * @brief Applies an unlock/progress update to the session.
  *
@@ -3,12 +3,13 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <common/types.h>
+#include <net/http/http.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-void mock_xbox_client_set_achievements(achievement_t *achievements);
+void mock_xbox_client_set_achievements(achievement_catalog_t *achievements);
 void mock_xbox_client_reset(void);
 
 /* Stub for xbox_fetch_gamerscore - does nothing in unit tests */
@@ -22,7 +23,7 @@ static inline game_t *xbox_get_current_game(void) {
     return NULL;
 }
 
-achievement_t *xbox_get_game_achievements(const game_t *game);
+achievement_catalog_t *xbox_get_game_achievements(const game_t *game);
 
 /* Stub for xbox_get_game_cover - returns NULL in unit tests */
 static inline char *xbox_get_game_cover(const game_t *game) {
@@ -30,6 +31,19 @@ static inline char *xbox_get_game_cover(const game_t *game) {
     return NULL;
 }
 
+/* Asynchronous API: defined by the tests exercising its callers */
+http_future_t         *xbox_begin_fetch_gamerscore(void);
+bool                   xbox_end_fetch_gamerscore(http_future_t *request, int64_t *out_gamerscore);
+http_future_t         *xbox_begin_get_current_game(void);
+game_t                *xbox_end_get_current_game(http_future_t *request);
+http_future_t         *xbox_begin_get_game_achievements(const game_t *game);
+http_future_t         *xbox_begin_revalidate_game_achievements(const game_t *game,
+                                                               const char   *etag,
+                                                               const char   *last_modified);
+achievement_catalog_t *xbox_end_get_game_achievements(http_future_t *request, const game_t *game);
+http_future_t         *xbox_begin_get_recent_titles(int max_titles);
+recent_title_t        *xbox_end_get_recent_titles(http_future_t *request);
+
 #ifdef __cplusplus
 }
 #endif
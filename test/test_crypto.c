@@ -630,6 +630,104 @@ void test_crypto_to_from_roundtrip(void) {
     TEST_ASSERT_EQUAL_STRING(serialized_keys, reserialized_keys);
 }
 
+/*
+ * Helper: verify a signature header against the "to-be-signed" data it covers.
+ */
+static bool verify_signature_header(EVP_PKEY      *pkey,
+                                    const uint8_t *header,
+                                    const char    *path,
+                                    const char    *auth_token,
+                                    const char    *payload) {
+
+    const char *fields[] = {"POST", path, auth_token, payload};
+
+    uint8_t prefix[4 + 1 + 8 + 1] = {0};
+    memcpy(prefix, header, 4);
+    memcpy(prefix + 5, header + 4, 8);
+
+    ECDSA_SIG *ecdsa = ECDSA_SIG_new();
+    ECDSA_SIG_set0(ecdsa, BN_bin2bn(header + 12, 32, NULL), BN_bin2bn(header + 44, 32, NULL));
+
+    unsigned char *der_sig = NULL;
+    int            der_len = i2d_ECDSA_SIG(ecdsa, &der_sig);
+
+    EVP_MD_CTX *mdctx    = EVP_MD_CTX_new();
+    bool        verified = EVP_DigestVerifyInit(mdctx, NULL, EVP_sha256(), NULL, pkey) == 1 &&
+                    EVP_DigestVerifyUpdate(mdctx, prefix, sizeof(prefix)) == 1;
+
+    for (size_t i = 0; verified && i < sizeof(fields) / sizeof(fields[0]); i++) {
+        /* Each field is followed by its NUL terminator */
+        verified = EVP_DigestVerifyUpdate(mdctx, fields[i], strlen(fields[i]) + 1) == 1;
+    }
+
+    verified = verified && der_len > 0 && EVP_DigestVerifyFinal(mdctx, der_sig, (size_t)der_len) == 1;
+
+    EVP_MD_CTX_free(mdctx);
+    OPENSSL_free(der_sig);
+    ECDSA_SIG_free(ecdsa);
+
+    return verified;
+}
+
+static void crypto_signer_create__key_is_null__null_returned(void) {
+
+    //  Act.
+    crypto_signer_t *signer = crypto_signer_create(NULL);
+
+    //  Assert.
+    TEST_ASSERT_NULL(signer);
+}
+
+static void crypto_signer_sign__signer_reused__every_header_verified(void) {
+
+    //  Arrange.
+    EVP_PKEY        *pkey   = crypto_generate_keys();
+    crypto_signer_t *signer = crypto_signer_create(pkey);
+
+    const char *payloads[] = {"{\"first\":1}", "{\"second\":2}", "{}"};
+    uint8_t     headers[3][CRYPTO_SIGNATURE_HEADER_SIZE];
+    bool        signed_headers[3];
+
+    //  Act.
+    for (size_t i = 0; i < 3; i++) {
+        signed_headers[i] =
+            crypto_signer_sign(signer, "https://sisu.xboxlive.com/authorize?x=1", "token", payloads[i], headers[i]);
+    }
+
+    //  Assert.
+    TEST_ASSERT_TRUE(crypto_signer_uses_key(signer, pkey));
+
+    for (size_t i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(signed_headers[i]);
+        TEST_ASSERT_EQUAL_UINT32(1, read_u32_be(headers[i]));
+        TEST_ASSERT_TRUE(verify_signature_header(pkey, headers[i], "/authorize?x=1", "token", payloads[i]));
+    }
+
+    crypto_signer_free(&signer);
+    TEST_ASSERT_NULL(signer);
+
+    EVP_PKEY_free(pkey);
+}
+
+static void crypto_signer_sign__key_released_by_caller__header_signed(void) {
+
+    //  Arrange.
+    EVP_PKEY        *pkey   = crypto_generate_keys();
+    crypto_signer_t *signer = crypto_signer_create(pkey);
+    EVP_PKEY_free(pkey);
+
+    uint8_t header[CRYPTO_SIGNATURE_HEADER_SIZE];
+
+    //  Act.
+    bool signed_header =
+        crypto_signer_sign(signer, "https://device.auth.xboxlive.com/device/authenticate", "", "{}", header);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(signed_header);
+
+    crypto_signer_free(&signer);
+}
+
 static void crypto_from_string__key_loaded(void) {
 
     //  Arrange.
@@ -654,6 +752,9 @@ int main(void) {
     RUN_TEST(test_crypto_sign_policy_header_known_signature_structure);
     RUN_TEST(test_crypto_verify_known_signature);
     RUN_TEST(test_crypto_sign_and_verify_roundtrip);
+    RUN_TEST(crypto_signer_create__key_is_null__null_returned);
+    RUN_TEST(crypto_signer_sign__signer_reused__every_header_verified);
+    RUN_TEST(crypto_signer_sign__key_released_by_caller__header_signed);
 
     return UNITY_END();
 }
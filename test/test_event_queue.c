@@ -0,0 +1,158 @@
+#include "unity.h"
+
+#include "util/event_queue.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+#define PRODUCER_COUNT 4
+#define ITEMS_PER_PRODUCER 10000
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void create_event_queue__zero_capacity__null_returned(void) {
+    //  Act.
+    event_queue_t *queue = create_event_queue(0);
+
+    //  Assert.
+    TEST_ASSERT_NULL(queue);
+}
+
+static void event_queue_pop__queue_is_empty__null_returned(void) {
+    //  Arrange.
+    event_queue_t *queue = create_event_queue(4);
+
+    //  Act.
+    void *item = event_queue_pop(queue);
+
+    //  Assert.
+    TEST_ASSERT_NULL(item);
+
+    free_event_queue(&queue);
+    TEST_ASSERT_NULL(queue);
+}
+
+static void event_queue_pop__items_pushed__items_returned_in_order(void) {
+    //  Arrange.
+    event_queue_t *queue = create_event_queue(4);
+    int            items[3];
+
+    for (int i = 0; i < 3; i++) {
+        event_queue_push(queue, &items[i]);
+    }
+
+    //  Act.
+    void *first  = event_queue_pop(queue);
+    void *second = event_queue_pop(queue);
+    void *third  = event_queue_pop(queue);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_PTR(&items[0], first);
+    TEST_ASSERT_EQUAL_PTR(&items[1], second);
+    TEST_ASSERT_EQUAL_PTR(&items[2], third);
+    TEST_ASSERT_NULL(event_queue_pop(queue));
+
+    free_event_queue(&queue);
+}
+
+static void event_queue_push__queue_is_full__false_returned(void) {
+    //  Arrange.
+    event_queue_t *queue = create_event_queue(4);
+    int            item  = 0;
+
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(event_queue_push(queue, &item));
+    }
+
+    //  Act.
+    bool pushed = event_queue_push(queue, &item);
+
+    //  Assert.
+    TEST_ASSERT_FALSE(pushed);
+
+    free_event_queue(&queue);
+}
+
+static void event_queue_push__item_popped_from_full_queue__item_pushed(void) {
+    //  Arrange.
+    event_queue_t *queue = create_event_queue(2);
+    int            items[3];
+
+    event_queue_push(queue, &items[0]);
+    event_queue_push(queue, &items[1]);
+    event_queue_pop(queue);
+
+    //  Act.
+    bool pushed = event_queue_push(queue, &items[2]);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(pushed);
+    TEST_ASSERT_EQUAL_PTR(&items[1], event_queue_pop(queue));
+    TEST_ASSERT_EQUAL_PTR(&items[2], event_queue_pop(queue));
+
+    free_event_queue(&queue);
+}
+
+static void *produce(void *argument) {
+
+    event_queue_t *queue = argument;
+
+    for (uintptr_t i = 1; i <= ITEMS_PER_PRODUCER; i++) {
+        while (!event_queue_push(queue, (void *)i)) {
+            /* Full: let the consumer run */
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void event_queue_pop__concurrent_producers__every_item_returned_once(void) {
+    //  Arrange.
+    event_queue_t *queue = create_event_queue(64);
+    pthread_t      producers[PRODUCER_COUNT];
+
+    for (int i = 0; i < PRODUCER_COUNT; i++) {
+        pthread_create(&producers[i], NULL, produce, queue);
+    }
+
+    //  Act.
+    uint64_t sum   = 0;
+    size_t   count = 0;
+
+    while (count < PRODUCER_COUNT * ITEMS_PER_PRODUCER) {
+        void *item = event_queue_pop(queue);
+
+        if (!item) {
+            sched_yield();
+            continue;
+        }
+
+        sum += (uintptr_t)item;
+        count++;
+    }
+
+    for (int i = 0; i < PRODUCER_COUNT; i++) {
+        pthread_join(producers[i], NULL);
+    }
+
+    //  Assert.
+    uint64_t expected = (uint64_t)PRODUCER_COUNT * ITEMS_PER_PRODUCER * (ITEMS_PER_PRODUCER + 1) / 2;
+    TEST_ASSERT_EQUAL_UINT64(expected, sum);
+    TEST_ASSERT_NULL(event_queue_pop(queue));
+
+    free_event_queue(&queue);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(create_event_queue__zero_capacity__null_returned);
+    RUN_TEST(event_queue_pop__queue_is_empty__null_returned);
+    RUN_TEST(event_queue_pop__items_pushed__items_returned_in_order);
+    RUN_TEST(event_queue_push__queue_is_full__false_returned);
+    RUN_TEST(event_queue_push__item_popped_from_full_queue__item_pushed);
+    RUN_TEST(event_queue_pop__concurrent_producers__every_item_returned_once);
+    return UNITY_END();
+}
@@ -0,0 +1,239 @@
+#include "unity.h"
+
+#include "net/http/http_buffer.h"
+
+#include <util/bmem.h>
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void http_buffer_append__chunks_appended_content_concatenated(void) {
+    //  Arrange.
+    http_buffer_t buffer;
+    http_buffer_init(&buffer, false);
+
+    //  Act.
+    bool first  = http_buffer_append(&buffer, "hello", 5);
+    bool second = http_buffer_append(&buffer, " world", 6);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(first);
+    TEST_ASSERT_TRUE(second);
+    TEST_ASSERT_EQUAL_size_t(11, buffer.size);
+    TEST_ASSERT_EQUAL_STRING("hello world", buffer.data);
+
+    http_buffer_free(&buffer);
+}
+
+static void http_buffer_append__many_small_chunks_capacity_grows_geometrically(void) {
+    //  Arrange.
+    http_buffer_t buffer;
+    http_buffer_init(&buffer, false);
+
+    size_t growths           = 0;
+    size_t previous_capacity = 0;
+
+    //  Act.
+    for (int i = 0; i < 100000; i++) {
+        http_buffer_append(&buffer, "x", 1);
+
+        if (buffer.capacity != previous_capacity) {
+            growths++;
+            previous_capacity = buffer.capacity;
+        }
+    }
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(100000, buffer.size);
+    TEST_ASSERT_TRUE(growths <= 8);
+
+    http_buffer_free(&buffer);
+}
+
+static void http_buffer_reserve__capacity_reserved_no_growth_on_append(void) {
+    //  Arrange.
+    http_buffer_t buffer;
+    http_buffer_init(&buffer, false);
+
+    char chunk[100];
+    memset(chunk, 'a', sizeof(chunk));
+
+    //  Act.
+    bool  reserved = http_buffer_reserve(&buffer, 5000);
+    char *data     = buffer.data;
+
+    for (int i = 0; i < 50; i++) {
+        http_buffer_append(&buffer, chunk, sizeof(chunk));
+    }
+
+    //  Assert.
+    TEST_ASSERT_TRUE(reserved);
+    TEST_ASSERT_EQUAL_PTR(data, buffer.data);
+    TEST_ASSERT_EQUAL_size_t(5000, buffer.capacity);
+    TEST_ASSERT_EQUAL_size_t(5000, buffer.size);
+
+    http_buffer_free(&buffer);
+}
+
+static void http_buffer_detach__nothing_appended_empty_string_returned(void) {
+    //  Arrange.
+    http_buffer_t buffer;
+    http_buffer_init(&buffer, false);
+
+    //  Act.
+    size_t size = 42;
+    char  *data = http_buffer_detach(&buffer, &size);
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_EQUAL_STRING("", data);
+    TEST_ASSERT_EQUAL_size_t(0, size);
+
+    bfree(data);
+}
+
+static void http_buffer_detach__content_appended_content_returned_and_buffer_emptied(void) {
+    //  Arrange.
+    http_buffer_t buffer;
+    http_buffer_init(&buffer, false);
+    http_buffer_append(&buffer, "{}", 2);
+
+    //  Act.
+    size_t size = 0;
+    char  *data = http_buffer_detach(&buffer, &size);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_STRING("{}", data);
+    TEST_ASSERT_EQUAL_size_t(2, size);
+    TEST_ASSERT_NULL(buffer.data);
+    TEST_ASSERT_EQUAL_size_t(0, buffer.size);
+
+    bfree(data);
+}
+
+static void http_buffer_init__thread_arena_used_storage_reused_across_buffers(void) {
+    //  Arrange.
+    http_buffer_t first;
+    http_buffer_init(&first, true);
+    http_buffer_append(&first, "first", 5);
+    char *arena_data = first.data;
+    char *detached   = http_buffer_detach(&first, NULL);
+
+    //  Act.
+    http_buffer_t second;
+    http_buffer_init(&second, true);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_STRING("first", detached);
+    TEST_ASSERT_TRUE(detached != arena_data);
+    TEST_ASSERT_EQUAL_PTR(arena_data, second.data);
+    TEST_ASSERT_EQUAL_size_t(0, second.size);
+    TEST_ASSERT_EQUAL_STRING("", second.data);
+
+    http_buffer_free(&second);
+    bfree(detached);
+}
+
+static void http_buffer_init__thread_arena_already_borrowed_own_storage_used(void) {
+    //  Arrange.
+    http_buffer_t first;
+    http_buffer_init(&first, true);
+
+    //  Act.
+    http_buffer_t second;
+    http_buffer_init(&second, true);
+    http_buffer_append(&first, "first", 5);
+    http_buffer_append(&second, "second", 6);
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(first.arena);
+    TEST_ASSERT_NULL(second.arena);
+    TEST_ASSERT_EQUAL_STRING("first", first.data);
+    TEST_ASSERT_EQUAL_STRING("second", second.data);
+
+    http_buffer_free(&second);
+    http_buffer_free(&first);
+}
+
+static void http_buffer_parse_content_length__header_is_content_length_value_returned(void) {
+    //  Arrange.
+    const char *line = "content-LENGTH:  1234\r\n";
+
+    //  Act.
+    size_t content_length = 0;
+    bool   parsed         = http_buffer_parse_content_length(line, strlen(line), &content_length);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(parsed);
+    TEST_ASSERT_EQUAL_size_t(1234, content_length);
+}
+
+static void http_buffer_parse_content_length__header_is_other_false_returned(void) {
+    //  Arrange.
+    const char *line = "Content-Type: application/json\r\n";
+
+    //  Act.
+    size_t content_length = 0;
+    bool   parsed         = http_buffer_parse_content_length(line, strlen(line), &content_length);
+
+    //  Assert.
+    TEST_ASSERT_FALSE(parsed);
+}
+
+static void http_buffer_parse_content_length__value_is_invalid_false_returned(void) {
+    //  Arrange.
+    const char *line = "Content-Length: 12abc\r\n";
+
+    //  Act.
+    size_t content_length = 0;
+    bool   parsed         = http_buffer_parse_content_length(line, strlen(line), &content_length);
+
+    //  Assert.
+    TEST_ASSERT_FALSE(parsed);
+}
+
+static void http_buffer_parse_header__header_matches_trimmed_value_returned(void) {
+    //  Arrange.
+    const char *line = "etag:  \"abc123\" \r\n";
+
+    //  Act.
+    const char *value        = NULL;
+    size_t      value_length = 0;
+    bool        parsed       = http_buffer_parse_header(line, strlen(line), "ETag", &value, &value_length);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(parsed);
+    TEST_ASSERT_EQUAL_size_t(8, value_length);
+    TEST_ASSERT_EQUAL_STRING_LEN("\"abc123\"", value, value_length);
+}
+
+static void http_buffer_parse_header__name_is_prefix_false_returned(void) {
+    //  Arrange.
+    const char *line = "ETag-Extra: abc\r\n";
+
+    //  Act.
+    const char *value        = NULL;
+    size_t      value_length = 0;
+    bool        parsed       = http_buffer_parse_header(line, strlen(line), "ETag", &value, &value_length);
+
+    //  Assert.
+    TEST_ASSERT_FALSE(parsed);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(http_buffer_append__chunks_appended_content_concatenated);
+    RUN_TEST(http_buffer_append__many_small_chunks_capacity_grows_geometrically);
+    RUN_TEST(http_buffer_reserve__capacity_reserved_no_growth_on_append);
+    RUN_TEST(http_buffer_detach__nothing_appended_empty_string_returned);
+    RUN_TEST(http_buffer_detach__content_appended_content_returned_and_buffer_emptied);
+    RUN_TEST(http_buffer_init__thread_arena_used_storage_reused_across_buffers);
+    RUN_TEST(http_buffer_init__thread_arena_already_borrowed_own_storage_used);
+    RUN_TEST(http_buffer_parse_content_length__header_is_content_length_value_returned);
+    RUN_TEST(http_buffer_parse_content_length__header_is_other_false_returned);
+    RUN_TEST(http_buffer_parse_content_length__value_is_invalid_false_returned);
+    RUN_TEST(http_buffer_parse_header__header_matches_trimmed_value_returned);
+    RUN_TEST(http_buffer_parse_header__name_is_prefix_false_returned);
+    return UNITY_END();
+}
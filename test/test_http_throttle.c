@@ -0,0 +1,132 @@
+#include "unity.h"
+
+#include "net/http/http_throttle.h"
+
+#define TITLEHUB_URL "https://titlehub.xboxlive.com/users/xuid(1)/titles/titlehistory"
+
+void setUp(void) {
+    http_throttle_reset();
+}
+
+void tearDown(void) {}
+
+static void http_throttle_reserve__within_burst__no_delay(void) {
+    //  Arrange.
+    int64_t delays[HTTP_THROTTLE_DEFAULT_MAX_REQUESTS];
+
+    //  Act.
+    for (int i = 0; i < HTTP_THROTTLE_DEFAULT_MAX_REQUESTS; i++) {
+        delays[i] = http_throttle_reserve(TITLEHUB_URL, 1000);
+    }
+
+    //  Assert.
+    for (int i = 0; i < HTTP_THROTTLE_DEFAULT_MAX_REQUESTS; i++) {
+        TEST_ASSERT_EQUAL_INT64(0, delays[i]);
+    }
+}
+
+static void http_throttle_reserve__burst_exceeded__requests_spaced_at_refill_rate(void) {
+    //  Arrange.
+    http_throttle_set_limit(TITLEHUB_URL, 2, 2);
+
+    http_throttle_reserve(TITLEHUB_URL, 1000);
+    http_throttle_reserve(TITLEHUB_URL, 1000);
+
+    //  Act.
+    int64_t third  = http_throttle_reserve(TITLEHUB_URL, 1000);
+    int64_t fourth = http_throttle_reserve(TITLEHUB_URL, 1000);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT64(1000, third);
+    TEST_ASSERT_EQUAL_INT64(2000, fourth);
+}
+
+static void http_throttle_reserve__tokens_refilled__no_delay(void) {
+    //  Arrange.
+    http_throttle_set_limit(TITLEHUB_URL, 1, 1);
+    http_throttle_reserve(TITLEHUB_URL, 1000);
+
+    //  Act.
+    int64_t delay = http_throttle_reserve(TITLEHUB_URL, 2000);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT64(0, delay);
+}
+
+static void http_throttle_reserve__other_host__own_bucket(void) {
+    //  Arrange.
+    http_throttle_set_limit(TITLEHUB_URL, 1, 60);
+    http_throttle_reserve(TITLEHUB_URL, 1000);
+
+    //  Act.
+    int64_t delay = http_throttle_reserve("https://achievements.xboxlive.com/users/xuid(1)/achievements", 1000);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT64(0, delay);
+}
+
+static void http_throttle_defer__host_blocked__delay_until_retry_time(void) {
+    //  Arrange.
+    http_throttle_defer(TITLEHUB_URL, 31000);
+
+    //  Act.
+    int64_t delay = http_throttle_reserve(TITLEHUB_URL, 1000);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT64(30000, delay);
+}
+
+static void http_throttle_parse_limit__xbox_live_body__limits_returned(void) {
+    //  Arrange.
+    const char *body = "{\"limitType\":\"Rate\",\"maxRequests\":10,\"periodInSeconds\":15,\"currentRequests\":11}";
+
+    uint32_t max_requests   = 0;
+    uint32_t period_seconds = 0;
+
+    //  Act.
+    bool found = http_throttle_parse_limit(body, &max_requests, &period_seconds);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(found);
+    TEST_ASSERT_EQUAL_UINT32(10, max_requests);
+    TEST_ASSERT_EQUAL_UINT32(15, period_seconds);
+}
+
+static void http_throttle_parse_limit__no_limits__false_returned(void) {
+    //  Arrange.
+    uint32_t max_requests   = 0;
+    uint32_t period_seconds = 0;
+
+    //  Act.
+    bool found = http_throttle_parse_limit("Too Many Requests", &max_requests, &period_seconds);
+
+    //  Assert.
+    TEST_ASSERT_FALSE(found);
+}
+
+static void http_throttle_backoff_ms__attempts__delay_doubles_with_jitter(void) {
+    //  Act.
+    int64_t first_min  = http_throttle_backoff_ms(1, 0);
+    int64_t first_max  = http_throttle_backoff_ms(1, UINT32_MAX);
+    int64_t second_min = http_throttle_backoff_ms(2, 0);
+    int64_t capped     = http_throttle_backoff_ms(100, 0);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT64(250, first_min);
+    TEST_ASSERT_TRUE(first_max >= 250 && first_max <= 500);
+    TEST_ASSERT_EQUAL_INT64(500, second_min);
+    TEST_ASSERT_EQUAL_INT64(15000, capped);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(http_throttle_reserve__within_burst__no_delay);
+    RUN_TEST(http_throttle_reserve__burst_exceeded__requests_spaced_at_refill_rate);
+    RUN_TEST(http_throttle_reserve__tokens_refilled__no_delay);
+    RUN_TEST(http_throttle_reserve__other_host__own_bucket);
+    RUN_TEST(http_throttle_defer__host_blocked__delay_until_retry_time);
+    RUN_TEST(http_throttle_parse_limit__xbox_live_body__limits_returned);
+    RUN_TEST(http_throttle_parse_limit__no_limits__false_returned);
+    RUN_TEST(http_throttle_backoff_ms__attempts__delay_doubles_with_jitter);
+    return UNITY_END();
+}
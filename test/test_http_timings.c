@@ -0,0 +1,166 @@
+#include "unity.h"
+
+#include "net/http/http_timings.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void setUp(void) {
+    http_timings_reset();
+}
+
+void tearDown(void) {}
+
+static http_timing_sample_t make_sample(int64_t total_us) {
+
+    http_timing_sample_t sample = {
+        .name_lookup_us  = 1000,
+        .connect_us      = 2000,
+        .tls_us          = 4000,
+        .first_byte_us   = total_us - 1000,
+        .total_us        = total_us,
+        .new_connections = 1,
+        .sent_bytes      = 10,
+        .received_bytes  = 100,
+    };
+
+    return sample;
+}
+
+static void http_timings_record__same_host_different_paths__aggregated_in_one_endpoint(void) {
+    //  Arrange.
+    http_timing_sample_t first  = make_sample(20000);
+    http_timing_sample_t second = make_sample(40000);
+    second.new_connections      = 0;
+
+    //  Act.
+    http_timings_record("https://titlehub.xboxlive.com/users/xuid(1)/titles", &first);
+    http_timings_record("https://titlehub.xboxlive.com:443/users/xuid(2)/titles?maxItems=5", &second);
+
+    //  Assert.
+    http_endpoint_timings_t endpoints[2];
+    size_t                  count = http_timings_get(endpoints, 2);
+
+    TEST_ASSERT_EQUAL_size_t(1, count);
+    TEST_ASSERT_EQUAL_STRING("titlehub.xboxlive.com", endpoints[0].host);
+    TEST_ASSERT_EQUAL_UINT64(2, endpoints[0].requests);
+    TEST_ASSERT_EQUAL_UINT64(1, endpoints[0].new_connections);
+    TEST_ASSERT_EQUAL_UINT64(60000, endpoints[0].total_us);
+    TEST_ASSERT_EQUAL_UINT64(20, endpoints[0].sent_bytes);
+    TEST_ASSERT_EQUAL_UINT64(200, endpoints[0].received_bytes);
+    TEST_ASSERT_EQUAL_INT64(40000, endpoints[0].max_total_us);
+}
+
+static void http_timings_record__different_hosts__endpoints_in_order_of_appearance(void) {
+    //  Arrange.
+    http_timing_sample_t sample = make_sample(5000);
+
+    //  Act.
+    http_timings_record("https://login.live.com/oauth20_token.srf", &sample);
+    http_timings_record("https://sisu.xboxlive.com/authorize", &sample);
+
+    //  Assert.
+    http_endpoint_timings_t endpoints[2];
+    size_t                  count = http_timings_get(endpoints, 2);
+
+    TEST_ASSERT_EQUAL_size_t(2, count);
+    TEST_ASSERT_EQUAL_STRING("login.live.com", endpoints[0].host);
+    TEST_ASSERT_EQUAL_STRING("sisu.xboxlive.com", endpoints[1].host);
+}
+
+static void http_timings_record__table_full__extra_hosts_counted_as_other(void) {
+    //  Arrange.
+    http_timing_sample_t sample = make_sample(5000);
+
+    //  Act.
+    for (int i = 0; i < HTTP_TIMINGS_MAX_ENDPOINTS + 5; i++) {
+        char url[64];
+        snprintf(url, sizeof(url), "https://host%d.example.com/", i);
+        http_timings_record(url, &sample);
+    }
+
+    //  Assert.
+    http_endpoint_timings_t endpoints[HTTP_TIMINGS_MAX_ENDPOINTS];
+    size_t                  count = http_timings_get(endpoints, HTTP_TIMINGS_MAX_ENDPOINTS);
+
+    TEST_ASSERT_EQUAL_size_t(HTTP_TIMINGS_MAX_ENDPOINTS, count);
+    TEST_ASSERT_EQUAL_STRING("other", endpoints[HTTP_TIMINGS_MAX_ENDPOINTS - 1].host);
+    TEST_ASSERT_EQUAL_UINT64(6, endpoints[HTTP_TIMINGS_MAX_ENDPOINTS - 1].requests);
+}
+
+static void http_timings_percentile_us__no_request__zero_returned(void) {
+    //  Arrange.
+    http_endpoint_timings_t endpoint;
+    memset(&endpoint, 0, sizeof(endpoint));
+
+    //  Act.
+    int64_t percentile = http_timings_percentile_us(&endpoint, 50.0);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT64(0, percentile);
+}
+
+static void http_timings_percentile_us__spread_samples__bucket_upper_bounds_returned(void) {
+    //  Arrange.
+    for (int i = 0; i < 9; i++) {
+        http_timing_sample_t fast = make_sample(3000);
+        http_timings_record("https://profile.xboxlive.com/", &fast);
+    }
+
+    http_timing_sample_t slow = make_sample(900000);
+    http_timings_record("https://profile.xboxlive.com/", &slow);
+
+    http_endpoint_timings_t endpoint;
+    http_timings_get(&endpoint, 1);
+
+    //  Act.
+    int64_t median = http_timings_percentile_us(&endpoint, 50.0);
+    int64_t p95    = http_timings_percentile_us(&endpoint, 95.0);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT64(4000, median);
+    TEST_ASSERT_EQUAL_INT64(900000, p95);
+}
+
+static void http_timings_format__one_endpoint__summary_line_written(void) {
+    //  Arrange.
+    http_timing_sample_t sample = make_sample(20000);
+    http_timings_record("https://achievements.xboxlive.com/users/xuid(1)/achievements", &sample);
+
+    char buffer[1024];
+
+    //  Act.
+    size_t count = http_timings_format(buffer, sizeof(buffer));
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(1, count);
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "achievements.xboxlive.com: 1 requests, 1 new connections"));
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "total 20.0 ms"));
+}
+
+static void http_timings_format__buffer_too_small__summary_truncated(void) {
+    //  Arrange.
+    http_timing_sample_t sample = make_sample(20000);
+    http_timings_record("https://achievements.xboxlive.com/", &sample);
+    http_timings_record("https://profile.xboxlive.com/", &sample);
+
+    char buffer[16];
+
+    //  Act.
+    http_timings_format(buffer, sizeof(buffer));
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(sizeof(buffer) - 1, strlen(buffer));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(http_timings_record__same_host_different_paths__aggregated_in_one_endpoint);
+    RUN_TEST(http_timings_record__different_hosts__endpoints_in_order_of_appearance);
+    RUN_TEST(http_timings_record__table_full__extra_hosts_counted_as_other);
+    RUN_TEST(http_timings_percentile_us__no_request__zero_returned);
+    RUN_TEST(http_timings_percentile_us__spread_samples__bucket_upper_bounds_returned);
+    RUN_TEST(http_timings_format__one_endpoint__summary_line_written);
+    RUN_TEST(http_timings_format__buffer_too_small__summary_truncated);
+    return UNITY_END();
+}
@@ -0,0 +1,80 @@
+#include "unity.h"
+
+#include "drawing/image_scale.h"
+
+#include <util/bmem.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void scale_image__pixels_is_null__null_returned(void) {
+    //  Act.
+    uint8_t *scaled = scale_image(NULL, 2, 2, 1, 1);
+
+    //  Assert.
+    TEST_ASSERT_NULL(scaled);
+}
+
+static void scale_image__same_size__pixels_copied(void) {
+    //  Arrange.
+    const uint8_t pixels[] = {
+        1, 2, 3, 4, 5, 6, 7, 8,
+        9, 10, 11, 12, 13, 14, 15, 16,
+    };
+
+    //  Act.
+    uint8_t *scaled = scale_image(pixels, 2, 2, 2, 2);
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(scaled);
+    TEST_ASSERT_EQUAL_MEMORY(pixels, scaled, sizeof(pixels));
+
+    bfree(scaled);
+}
+
+static void scale_image__half_size__pixels_averaged(void) {
+    //  Arrange.
+    const uint8_t pixels[] = {
+        0, 0, 0, 255, 100, 0, 0, 255,
+        0, 100, 0, 255, 0, 0, 101, 255,
+    };
+
+    //  Act.
+    uint8_t *scaled = scale_image(pixels, 2, 2, 1, 1);
+
+    //  Assert.
+    const uint8_t expected[] = {25, 25, 25, 255};
+
+    TEST_ASSERT_NOT_NULL(scaled);
+    TEST_ASSERT_EQUAL_MEMORY(expected, scaled, sizeof(expected));
+
+    bfree(scaled);
+}
+
+static void scale_image__double_size__pixels_repeated(void) {
+    //  Arrange.
+    const uint8_t pixels[] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    //  Act.
+    uint8_t *scaled = scale_image(pixels, 2, 1, 4, 2);
+
+    //  Assert.
+    const uint8_t expected[] = {
+        1, 2, 3, 4, 1, 2, 3, 4, 5, 6, 7, 8, 5, 6, 7, 8,
+        1, 2, 3, 4, 1, 2, 3, 4, 5, 6, 7, 8, 5, 6, 7, 8,
+    };
+
+    TEST_ASSERT_NOT_NULL(scaled);
+    TEST_ASSERT_EQUAL_MEMORY(expected, scaled, sizeof(expected));
+
+    bfree(scaled);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(scale_image__pixels_is_null__null_returned);
+    RUN_TEST(scale_image__same_size__pixels_copied);
+    RUN_TEST(scale_image__half_size__pixels_averaged);
+    RUN_TEST(scale_image__double_size__pixels_repeated);
+    return UNITY_END();
+}
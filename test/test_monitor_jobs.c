@@ -0,0 +1,291 @@
+#include "unity.h"
+
+#include "xbox/monitor_jobs.h"
+#include "io/achievements_cache.h"
+#include "io/cover_cache.h"
+
+#include <util/bmem.h>
+#include <string.h>
+
+#define MAX_FUTURES 8
+
+/**
+ * Fake request: never freed, so a future completed twice is counted rather than
+ * corrupting the heap.
+ */
+struct http_future {
+    int completions;
+};
+
+static struct http_future g_futures[MAX_FUTURES];
+static size_t             g_future_count;
+
+/* Game returned by xbox_end_get_current_game (ownership transferred) */
+static game_t *g_current_game;
+
+/* Request passed to xbox_end_get_game_achievements, if it was called */
+static http_future_t *g_achievements_request;
+static bool           g_achievements_completed;
+
+static http_future_t *create_future(void) {
+    TEST_ASSERT_TRUE(g_future_count < MAX_FUTURES);
+    return &g_futures[g_future_count++];
+}
+
+static void complete_future(http_future_t *request) {
+    if (request) {
+        request->completions++;
+    }
+}
+
+static game_t *create_game(const char *id, const char *title) {
+
+    game_t *game = bzalloc(sizeof(game_t));
+    game->id     = bstrdup(id);
+    game->title  = bstrdup(title);
+
+    return game;
+}
+
+static monitor_job_t *create_job(monitor_job_type_t type) {
+
+    monitor_job_t *job = bzalloc(sizeof(monitor_job_t));
+    job->type          = type;
+
+    return job;
+}
+
+//  Fakes of the Xbox client
+
+http_future_t *xbox_begin_fetch_gamerscore(void) {
+    return create_future();
+}
+
+bool xbox_end_fetch_gamerscore(http_future_t *request, int64_t *out_gamerscore) {
+    complete_future(request);
+    *out_gamerscore = 0;
+    return false;
+}
+
+http_future_t *xbox_begin_get_current_game(void) {
+    return create_future();
+}
+
+game_t *xbox_end_get_current_game(http_future_t *request) {
+
+    complete_future(request);
+
+    game_t *game   = g_current_game;
+    g_current_game = NULL;
+
+    return game;
+}
+
+http_future_t *xbox_begin_get_game_achievements(const game_t *game) {
+    return game ? create_future() : NULL;
+}
+
+http_future_t *xbox_begin_revalidate_game_achievements(const game_t *game,
+                                                       const char   *etag,
+                                                       const char   *last_modified) {
+    (void)etag;
+    (void)last_modified;
+    return game ? create_future() : NULL;
+}
+
+achievement_catalog_t *xbox_end_get_game_achievements(http_future_t *request, const game_t *game) {
+    (void)game;
+    complete_future(request);
+    g_achievements_request   = request;
+    g_achievements_completed = true;
+    return NULL;
+}
+
+http_future_t *xbox_begin_get_recent_titles(int max_titles) {
+    (void)max_titles;
+    return create_future();
+}
+
+recent_title_t *xbox_end_get_recent_titles(http_future_t *request) {
+    complete_future(request);
+    return NULL;
+}
+
+//  Fakes of the caches, the HTTP layer and the identity
+
+achievement_catalog_t *achievements_cache_load(const char *title_id, char **out_etag, char **out_last_modified) {
+    (void)title_id;
+    *out_etag          = NULL;
+    *out_last_modified = NULL;
+    return NULL;
+}
+
+bool achievements_cache_contains(const char *title_id) {
+    (void)title_id;
+    return false;
+}
+
+bool achievements_cache_set_progress(const char *title_id, const char *achievement_id, const char *progress_state) {
+    (void)title_id;
+    (void)achievement_id;
+    (void)progress_state;
+    return true;
+}
+
+bool cover_cache_contains(const char *url) {
+    (void)url;
+    return true;
+}
+
+char *cover_cache_store(const char *url, const uint8_t *data, size_t size) {
+    (void)url;
+    (void)data;
+    (void)size;
+    return NULL;
+}
+
+bool http_download(const char *url, uint8_t **out_data, size_t *out_size) {
+    (void)url;
+    *out_data = NULL;
+    *out_size = 0;
+    return false;
+}
+
+xbox_identity_handle_t *xbox_live_acquire_identity(void) {
+    return NULL;
+}
+
+void xbox_live_release_identity(xbox_identity_handle_t **handle) {
+    *handle = NULL;
+}
+
+void setUp(void) {
+    memset(g_futures, 0, sizeof(g_futures));
+    g_future_count           = 0;
+    g_current_game           = NULL;
+    g_achievements_request   = NULL;
+    g_achievements_completed = false;
+}
+
+void tearDown(void) {
+    free_game(&g_current_game);
+}
+
+//  Tests monitor_job_begin / monitor_job_end
+
+static void monitor_job_end__change_game_without_game_played__request_completed_once(void) {
+    //  Arrange.
+    monitor_job_t *job       = create_job(MONITOR_JOB_CHANGE_GAME);
+    job->lookup_current_game = true;
+
+    //  Act.
+    monitor_job_begin(job);
+    monitor_job_end(job);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(1, g_future_count);
+    TEST_ASSERT_EQUAL_INT(1, g_futures[0].completions);
+    TEST_ASSERT_NULL(job->game);
+    TEST_ASSERT_NULL(job->achievements);
+    TEST_ASSERT_NULL(g_achievements_request);
+    TEST_ASSERT_NULL(job->request);
+
+    free_monitor_job(&job);
+}
+
+static void monitor_job_end__change_game_with_game_played__achievements_requested(void) {
+    //  Arrange.
+    g_current_game = create_game("1234", "Halo");
+
+    monitor_job_t *job       = create_job(MONITOR_JOB_CHANGE_GAME);
+    job->lookup_current_game = true;
+
+    //  Act.
+    monitor_job_begin(job);
+    monitor_job_end(job);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(2, g_future_count);
+    TEST_ASSERT_EQUAL_INT(1, g_futures[0].completions);
+    TEST_ASSERT_EQUAL_INT(1, g_futures[1].completions);
+    TEST_ASSERT_EQUAL_PTR(&g_futures[1], g_achievements_request);
+    TEST_ASSERT_NOT_NULL(job->game);
+    TEST_ASSERT_EQUAL_STRING("1234", job->game->id);
+
+    free_monitor_job(&job);
+}
+
+static void monitor_job_end__change_game_of_known_game__achievements_requested_once(void) {
+    //  Arrange.
+    monitor_job_t *job = create_job(MONITOR_JOB_CHANGE_GAME);
+    job->game          = create_game("1234", "Halo");
+
+    //  Act.
+    monitor_job_begin(job);
+    monitor_job_end(job);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(1, g_future_count);
+    TEST_ASSERT_EQUAL_INT(1, g_futures[0].completions);
+    TEST_ASSERT_TRUE(g_achievements_completed);
+
+    free_monitor_job(&job);
+}
+
+//  Tests monitor_job_queue_take_batch
+
+static void monitor_job_queue_take_batch__foreground_jobs_queued__background_jobs_left_queued(void) {
+    //  Arrange.
+    monitor_job_queue_t queue    = {0};
+    monitor_job_t      *prefetch = create_job(MONITOR_JOB_PREFETCH_TITLE);
+    monitor_job_t      *change   = create_job(MONITOR_JOB_CHANGE_GAME);
+    monitor_job_t      *fetch    = create_job(MONITOR_JOB_FETCH_GAMERSCORE);
+
+    monitor_job_queue_push(&queue, prefetch);
+    monitor_job_queue_push(&queue, change);
+    monitor_job_queue_push(&queue, fetch);
+
+    //  Act.
+    monitor_job_t *batch = monitor_job_queue_take_batch(&queue);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_PTR(change, batch);
+    TEST_ASSERT_EQUAL_PTR(fetch, batch->next);
+    TEST_ASSERT_NULL(fetch->next);
+    TEST_ASSERT_EQUAL_PTR(prefetch, queue.head);
+    TEST_ASSERT_EQUAL_PTR(prefetch, queue.tail);
+
+    free_monitor_jobs(batch);
+    free_monitor_jobs(monitor_job_queue_take_all(&queue));
+}
+
+static void monitor_job_queue_take_batch__only_background_jobs_queued__every_job_taken(void) {
+    //  Arrange.
+    monitor_job_queue_t queue  = {0};
+    monitor_job_t      *first  = create_job(MONITOR_JOB_PREFETCH_TITLE);
+    monitor_job_t      *second = create_job(MONITOR_JOB_PREFETCH_TITLE);
+
+    monitor_job_queue_push(&queue, first);
+    monitor_job_queue_push(&queue, second);
+
+    //  Act.
+    monitor_job_t *batch = monitor_job_queue_take_batch(&queue);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_PTR(first, batch);
+    TEST_ASSERT_EQUAL_PTR(second, batch->next);
+    TEST_ASSERT_NULL(queue.head);
+    TEST_ASSERT_NULL(queue.tail);
+
+    free_monitor_jobs(batch);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(monitor_job_end__change_game_without_game_played__request_completed_once);
+    RUN_TEST(monitor_job_end__change_game_with_game_played__achievements_requested);
+    RUN_TEST(monitor_job_end__change_game_of_known_game__achievements_requested_once);
+    RUN_TEST(monitor_job_queue_take_batch__foreground_jobs_queued__background_jobs_left_queued);
+    RUN_TEST(monitor_job_queue_take_batch__only_background_jobs_queued__every_job_taken);
+    return UNITY_END();
+}
@@ -2,6 +2,8 @@
 
 #include "text/parsers.h"
 
+#include <util/bmem.h>
+
 #include <string.h>
 
 void setUp(void) {}
@@ -256,26 +258,267 @@ static void parse_achievements_progress__message_is_multiple_achievements_achiev
     TEST_ASSERT_EQUAL_STRING(actual->next->progress_state, "NotAchieved");
 }
 
-//  Test parse_achievements
+//  Test get_rta_message_type
+
+static void get_rta_message_type__message_is_null_unknown_returned(void) {
+    //  Arrange.
+    const cJSON *message = NULL;
+
+    //  Act.
+    rta_message_type_t actual = get_rta_message_type(message);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(RTA_MESSAGE_UNKNOWN, actual);
+}
 
-static void parse_achievements__message_is_multiple_achievements_achievements_returned(void) {
+static void get_rta_message_type__message_is_not_object_unknown_returned(void) {
+    //  Arrange.
+    cJSON *message = cJSON_Parse("[1,2,0]");
+
+    //  Act.
+    rta_message_type_t actual = get_rta_message_type(message);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(RTA_MESSAGE_UNKNOWN, actual);
+
+    cJSON_Delete(message);
+}
+
+static void get_rta_message_type__frame_contains_presence_presence_returned(void) {
+    //  Arrange.
+    cJSON *frame = cJSON_Parse(
+        "[3,1,{\"presenceDetails\":[{\"presenceText\":\"Halo\",\"titleId\":\"123\",\"isGame\":true}]}]");
+
+    //  Act.
+    rta_message_type_t actual = get_rta_message_type(cJSON_GetArrayItem(frame, 2));
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(RTA_MESSAGE_PRESENCE, actual);
+
+    cJSON_Delete(frame);
+}
+
+static void get_rta_message_type__frame_contains_achievement_achievement_returned(void) {
+    //  Arrange.
+    cJSON *frame = cJSON_Parse("[3,2,{\"serviceConfigId\":\"abc\",\"progression\":[]}]");
+
+    //  Act.
+    rta_message_type_t actual = get_rta_message_type(cJSON_GetArrayItem(frame, 2));
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(RTA_MESSAGE_ACHIEVEMENT, actual);
+
+    cJSON_Delete(frame);
+}
+
+//  Test parse_game_from_node
+
+static void parse_game_from_node__frame_contains_presence_game_returned(void) {
+    //  Arrange.
+    cJSON *frame = cJSON_Parse("[3,1,{\"presenceDetails\":[{\"presenceText\":\"Home\",\"titleId\":\"1\","
+                               "\"isGame\":false},{\"presenceText\":\"Halo\",\"titleId\":\"123\",\"isGame\":true}]}]");
+
+    //  Act.
+    game_t *actual = parse_game_from_node(cJSON_GetArrayItem(frame, 2));
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(actual);
+    TEST_ASSERT_EQUAL_STRING("123", actual->id);
+    TEST_ASSERT_EQUAL_STRING("Halo", actual->title);
+
+    cJSON_Delete(frame);
+}
+
+static void parse_game_from_node__game_has_no_title_id_null_returned(void) {
+    //  Arrange.
+    cJSON *message = cJSON_Parse("{\"presenceDetails\":[{\"presenceText\":\"Halo\",\"isGame\":true}]}");
+
+    //  Act.
+    game_t *actual = parse_game_from_node(message);
+
+    //  Assert.
+    TEST_ASSERT_NULL(actual);
+
+    cJSON_Delete(message);
+}
+
+//  Test parse_achievement_progress_from_node
+
+static void parse_achievement_progress_from_node__message_is_presence_null_returned(void) {
+    //  Arrange.
+    cJSON *message = cJSON_Parse("{\"presenceDetails\":[]}");
+
+    //  Act.
+    achievement_progress_t *actual = parse_achievement_progress_from_node(message);
+
+    //  Assert.
+    TEST_ASSERT_NULL(actual);
+
+    cJSON_Delete(message);
+}
+
+static void parse_achievement_progress_from_node__frame_contains_achievement_achievement_returned(void) {
+    //  Arrange.
+    cJSON *frame = cJSON_Parse("[3,2,{\"serviceConfigId\":\"abc\",\"progression\":[{\"id\":\"7\","
+                               "\"progressState\":\"Achieved\"}]}]");
+
+    //  Act.
+    achievement_progress_t *actual = parse_achievement_progress_from_node(cJSON_GetArrayItem(frame, 2));
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(actual);
+    TEST_ASSERT_EQUAL_STRING("abc", actual->service_config_id);
+    TEST_ASSERT_EQUAL_STRING("7", actual->id);
+    TEST_ASSERT_EQUAL_STRING("Achieved", actual->progress_state);
+    TEST_ASSERT_NULL(actual->next);
+
+    cJSON_Delete(frame);
+}
+
+//  Test parse_achievement_catalog
+
+static void parse_achievement_catalog__message_is_multiple_achievements_achievements_returned(void) {
     //  Arrange.
     const char *message =
         "{\"achievements\":[{\"id\":\"1\",\"serviceConfigId\":\"00000000-0000-0000-0000-00007972ac43\",\"name\":\"Daddy's Glasses\",\"titleAssociations\":[{\"name\":\"My Friend Peppa Pig\",\"id\":2037558339}],\"progressState\":\"Achieved\",\"progression\":{\"requirements\":[],\"timeUnlocked\":\"2026-01-18T02:48:21.7070000Z\"},\"mediaAssets\":[{\"name\":\"cf486b2a-3a9e-4c14-b18c-c91e0bb56926\",\"type\":\"Icon\",\"url\":\"https://images-eds-ssl.xboxlive.com/image?url=27S1DHqE.cHkmFg4nspsdzttpqR9mABLoi_h264Ah_brT_74D18wvss1Tpl1Hv0V.ZRAXkfWjJILaiyZZyI_J2paDrXdC_1Gly_3Cnd9yC7IDl0y2ssMo_dvyQ_OhHyuW60ck5614OfHrmzXJvVaS2vM4efPU6iwu2_vBB1TeAE-\"}],\"platforms\":[\"XboxOne\"],\"isSecret\":false,\"description\":\"You found Daddy Pig's Glasses.\",\"lockedDescription\":\"Find Daddy Pig's Glasses.\",\"productId\":\"00000000-0000-0000-0000-00007972ac43\",\"achievementType\":\"Persistent\",\"participationType\":\"Individual\",\"timeWindow\":null,\"rewards\":[{\"name\":null,\"description\":null,\"value\":\"80\",\"type\":\"Gamerscore\",\"mediaAsset\":null,\"valueType\":\"Int\"}],\"estimatedTime\":\"00:00:00\",\"deeplink\":\"\",\"isRevoked\":false},{\"id\":\"2\",\"serviceConfigId\":\"00000000-0000-0000-0000-00007972ac43\",\"name\":\"Where's Mr. Dinosaur?\",\"titleAssociations\":[{\"name\":\"My Friend Peppa Pig\",\"id\":2037558339}],\"progressState\":\"NotStarted\",\"progression\":{\"requirements\":[{\"id\":\"00000000-0000-0000-0000-000000000000\",\"current\":\"0\",\"target\":\"100\",\"operationType\":\"Sum\",\"valueType\":\"Integer\",\"ruleParticipationType\":\"Individual\"}],\"timeUnlocked\":\"0001-01-01T00:00:00.0000000Z\"},\"mediaAssets\":[{\"name\":\"09f94026-8896-4c8a-9b0c-aeb6371e88f0\",\"type\":\"Icon\",\"url\":\"https://images-eds-ssl.xboxlive.com/image?url=27S1DHqE.cHkmFg4nspsdzokISnshkl.YcYqCmweQJubIDDIVJtokZHSoEQgyASVwuVT1yj8cEV8HdUg07CxZIU7xq2U11afQQ26YbPJi4Hr0GTE81qqxgULNGGK4HLbQoUFccQ4orGzYT5WJdvS3Rj.19DADjcNoFcU9ugzoEk-\"}],\"platforms\":[\"XboxOne\"],\"isSecret\":false,\"description\":\"You recovered Mr. Dinosaur for George.\",\"lockedDescription\":\"Recover Mr. Dinosaur for George.\",\"productId\":\"00000000-0000-0000-0000-00007972ac43\",\"achievementType\":\"Persistent\",\"participationType\":\"Individual\",\"timeWindow\":null,\"rewards\":[{\"name\":null,\"description\":null,\"value\":\"80\",\"type\":\"Gamerscore\",\"mediaAsset\":null,\"valueType\":\"Int\"}],\"estimatedTime\":\"00:00:00\",\"deeplink\":\"\",\"isRevoked\":false},{\"id\":\"3\",\"serviceConfigId\":\"00000000-0000-0000-0000-00007972ac43\",\"name\":\"Whose tracks are these?\",\"titleAssociations\":[{\"name\":\"My Friend Peppa Pig\",\"id\":2037558339}],\"progressState\":\"NotStarted\",\"progression\":{\"requirements\":[{\"id\":\"00000000-0000-0000-0000-000000000000\",\"current\":\"0\",\"target\":\"100\",\"operationType\":\"Sum\",\"valueType\":\"Integer\",\"ruleParticipationType\":\"Individual\"}],\"timeUnlocked\":\"0001-01-01T00:00:00.0000000Z\"},\"mediaAssets\":[{\"name\":\"f0045535-229f-43fa-a597-7221cc75a49e\",\"type\":\"Icon\",\"url\":\"https://images-eds-ssl.xboxlive.com/image?url=27S1DHqE.cHkmFg4nspsd5XrL8tQY.MwWYIrfIlaoTapO0RHdDXslvnCBWfl8yoo0ZWDVpcYOKq2azXdVdxQiCKgnAZuGvvtQ33u632vocTNfQkynPR2EgVhYK51rjukn1CH232.4s4mJ859BihrO4wC3sc9NFfV.qv9ykMyqyM-\"}],\"platforms\":[\"XboxOne\"],\"isSecret\":false,\"description\":\"You followed the tracks in the forest and find out who left them.\",\"lockedDescription\":\"Follow the tracks in the forest and find out who left them.\",\"productId\":\"00000000-0000-0000-0000-00007972ac43\",\"achievementType\":\"Persistent\",\"participationType\":\"Individual\",\"timeWindow\":null,\"rewards\":[{\"name\":null,\"description\":null,\"value\":\"80\",\"type\":\"Gamerscore\",\"mediaAsset\":null,\"valueType\":\"Int\"}],\"estimatedTime\":\"00:00:00\",\"deeplink\":\"\",\"isRevoked\":false},{\"id\":\"4\",\"serviceConfigId\":\"00000000-0000-0000-0000-00007972ac43\",\"name\":\"The Best Snowman Ever!\",\"titleAssociations\":[{\"name\":\"My Friend Peppa Pig\",\"id\":2037558339}],\"progressState\":\"NotStarted\",\"progression\":{\"requirements\":[{\"id\":\"00000000-0000-0000-0000-000000000000\",\"current\":\"0\",\"target\":\"100\",\"operationType\":\"Sum\",\"valueType\":\"Integer\",\"ruleParticipationType\":\"Individual\"}],\"timeUnlocked\":\"0001-01-01T00:00:00.0000000Z\"},\"mediaAssets\":[{\"name\":\"06131097-0d93-4b3c-9bf3-2df074c9d7da\",\"type\":\"Icon\",\"url\":\"https://images-eds-ssl.xboxlive.com/image?url=27S1DHqE.cHkmFg4nspsdwidOMhIK6i8yoxIzzG_hp2nj0JqLJgmdEkolMM7aQLA6ffb.9TCmrB5mYexWdu59xwWID84Gu9yiP6yhpgX2ARtT.uvKjV2V51TSqfyiLsH0JAUQBXTmVBXAqK0Q0dc4iGFdJhGBdEm7vzWVyTtrzs-\"}],\"platforms\":[\"XboxOne\"],\"isSecret\":false,\"description\":\"You built a snowman in Snowy Mountain.\",\"lockedDescription\":\"Build a snowman in Snowy Mountain.\",\"productId\":\"00000000-0000-0000-0000-00007972ac43\",\"achievementType\":\"Persistent\",\"participationType\":\"Individual\",\"timeWindow\":null,\"rewards\":[{\"name\":null,\"description\":null,\"value\":\"80\",\"type\":\"Gamerscore\",\"mediaAsset\":null,\"valueType\":\"Int\"}],\"estimatedTime\":\"00:00:00\",\"deeplink\":\"\",\"isRevoked\":false}],\"pagingInfo\":{\"continuationToken\":null,\"totalRecords\":11}}";
 
     //  Act.
-    achievement_t *actual = parse_achievements(message);
+    achievement_catalog_t *actual = parse_achievement_catalog(message);
 
     //  Assert.
     TEST_ASSERT_NOT_NULL(actual);
+    TEST_ASSERT_EQUAL_size_t(4, achievement_catalog_count(actual));
 
-    achievement_t *current_achievement = actual;
-    int            achievements_count  = 0;
+    const achievement_t *current_achievement = achievement_catalog_get_achievements(actual);
+    int                  achievements_count  = 0;
     while (current_achievement != NULL) {
         achievements_count++;
         current_achievement = current_achievement->next;
     }
     TEST_ASSERT_EQUAL_INT(4, achievements_count);
+
+    free_achievement_catalog(&actual);
+}
+
+static void parse_achievement_catalog__achievement_has_rewards_gamerscore_reward_and_fields_returned(void) {
+    //  Arrange.
+    const char *message =
+        "{\"achievements\":[{\"id\":\"7\",\"serviceConfigId\":\"scid\",\"name\":\"Name\",\"progressState\":\"Achieved\",\"mediaAssets\":[{\"url\":\"https://a\"},{\"url\":\"https://b\"}],\"isSecret\":true,\"description\":\"Done\",\"lockedDescription\":\"Do it\",\"rewards\":[{\"value\":\"Hat\",\"type\":\"InApp\"},{\"value\":\"25\",\"type\":\"Gamerscore\"}]}]}";
+
+    //  Act.
+    achievement_catalog_t *catalog = parse_achievement_catalog(message);
+
+    //  Assert.
+    const achievement_t *actual = achievement_catalog_find(catalog, "7");
+    TEST_ASSERT_NOT_NULL(actual);
+    TEST_ASSERT_EQUAL_STRING("7", actual->id);
+    TEST_ASSERT_EQUAL_STRING("scid", actual->service_config_id);
+    TEST_ASSERT_EQUAL_STRING("Name", actual->name);
+    TEST_ASSERT_EQUAL_STRING("Achieved", actual->progress_state);
+    TEST_ASSERT_EQUAL_STRING("Done", actual->description);
+    TEST_ASSERT_EQUAL_STRING("Do it", actual->locked_description);
+    TEST_ASSERT_TRUE(actual->is_secret);
+    TEST_ASSERT_NOT_NULL(actual->media_assets);
+    TEST_ASSERT_EQUAL_STRING("https://a", actual->media_assets->url);
+    TEST_ASSERT_NOT_NULL(actual->media_assets->next);
+    TEST_ASSERT_EQUAL_STRING("https://b", actual->media_assets->next->url);
+    TEST_ASSERT_NOT_NULL(actual->rewards);
+    TEST_ASSERT_EQUAL_STRING("25", actual->rewards->value);
+    TEST_ASSERT_NULL(actual->rewards->next);
+    TEST_ASSERT_NULL(actual->next);
+
+    free_achievement_catalog(&catalog);
+}
+
+static void parse_achievement_catalog__achievement_has_no_id_achievement_skipped(void) {
+    //  Arrange.
+    const char *message = "{\"achievements\":[{\"name\":\"No id\"},{\"id\":\"2\",\"name\":\"Second\"}]}";
+
+    //  Act.
+    achievement_catalog_t *catalog = parse_achievement_catalog(message);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(1, achievement_catalog_count(catalog));
+
+    const achievement_t *actual = achievement_catalog_get_achievements(catalog);
+    TEST_ASSERT_NOT_NULL(actual);
+    TEST_ASSERT_EQUAL_STRING("2", actual->id);
+    TEST_ASSERT_EQUAL_STRING("Second", actual->name);
+    TEST_ASSERT_NULL(actual->next);
+
+    free_achievement_catalog(&catalog);
+}
+
+static void parse_achievement_catalog__message_has_no_achievements_null_returned(void) {
+    //  Arrange.
+    const char *message = "{\"pagingInfo\":{\"continuationToken\":null,\"totalRecords\":0}}";
+
+    //  Act.
+    achievement_catalog_t *actual = parse_achievement_catalog(message);
+
+    //  Assert.
+    TEST_ASSERT_NULL(actual);
+}
+
+static void parse_game_cover_url__title_has_poster__poster_returned(void) {
+    //  Arrange.
+    const char *message =
+        "{\"titles\":[{\"titleId\":\"1\",\"displayImage\":\"https://display\",\"images\":[{\"url\":\"https://logo\",\"type\":\"logo\"},{\"url\":\"https://poster\",\"type\":\"poster\"}]}]}";
+
+    //  Act.
+    char *actual = parse_game_cover_url(message);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_STRING("https://poster", actual);
+
+    bfree(actual);
+}
+
+static void parse_game_cover_url__title_has_no_poster__display_image_returned(void) {
+    //  Arrange.
+    const char *message =
+        "{\"titles\":[{\"titleId\":\"1\",\"displayImage\":\"https://display\",\"images\":[{\"url\":\"https://logo\",\"type\":\"logo\"}]}]}";
+
+    //  Act.
+    char *actual = parse_game_cover_url(message);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_STRING("https://display", actual);
+
+    bfree(actual);
+}
+
+static void parse_recent_titles__message_has_titles__titles_returned_in_order(void) {
+    //  Arrange.
+    const char *message =
+        "{\"xuid\":\"1\",\"titles\":[{\"titleId\":\"10\",\"name\":\"First\",\"displayImage\":\"https://first\",\"images\":[{\"url\":\"https://first-boxart\",\"type\":\"boxart\"}]},{\"name\":\"No id\"},{\"titleId\":\"20\",\"name\":\"Second\"}]}";
+
+    //  Act.
+    recent_title_t *actual = parse_recent_titles(message);
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(actual);
+    TEST_ASSERT_EQUAL_STRING("10", actual->id);
+    TEST_ASSERT_EQUAL_STRING("First", actual->title);
+    TEST_ASSERT_EQUAL_STRING("https://first-boxart", actual->cover_url);
+    TEST_ASSERT_NOT_NULL(actual->next);
+    TEST_ASSERT_EQUAL_STRING("20", actual->next->id);
+    TEST_ASSERT_EQUAL_STRING("Second", actual->next->title);
+    TEST_ASSERT_NULL(actual->next->cover_url);
+    TEST_ASSERT_NULL(actual->next->next);
+
+    free_recent_titles(&actual);
+}
+
+static void parse_recent_titles__message_has_no_titles__null_returned(void) {
+    //  Arrange.
+    const char *message = "{\"xuid\":\"1\"}";
+
+    //  Act.
+    recent_title_t *actual = parse_recent_titles(message);
+
+    //  Assert.
+    TEST_ASSERT_NULL(actual);
 }
 
 int main(void) {
@@ -304,7 +547,27 @@ int main(void) {
     RUN_TEST(parse_achievements_progress__message_is_not_json_null_returned);
     RUN_TEST(parse_achievements_progress__message_is_achievement_achievement_returned);
     RUN_TEST(parse_achievements_progress__message_is_multiple_achievements_achievements_returned);
-    //  Test parse_achievements
-    RUN_TEST(parse_achievements__message_is_multiple_achievements_achievements_returned);
+    //  Test parse_achievement_catalog
+    RUN_TEST(get_rta_message_type__message_is_null_unknown_returned);
+    RUN_TEST(get_rta_message_type__message_is_not_object_unknown_returned);
+    RUN_TEST(get_rta_message_type__frame_contains_presence_presence_returned);
+    RUN_TEST(get_rta_message_type__frame_contains_achievement_achievement_returned);
+
+    RUN_TEST(parse_game_from_node__frame_contains_presence_game_returned);
+    RUN_TEST(parse_game_from_node__game_has_no_title_id_null_returned);
+
+    RUN_TEST(parse_achievement_progress_from_node__message_is_presence_null_returned);
+    RUN_TEST(parse_achievement_progress_from_node__frame_contains_achievement_achievement_returned);
+
+    RUN_TEST(parse_achievement_catalog__message_is_multiple_achievements_achievements_returned);
+    RUN_TEST(parse_achievement_catalog__achievement_has_rewards_gamerscore_reward_and_fields_returned);
+    RUN_TEST(parse_achievement_catalog__achievement_has_no_id_achievement_skipped);
+    RUN_TEST(parse_achievement_catalog__message_has_no_achievements_null_returned);
+
+    RUN_TEST(parse_game_cover_url__title_has_poster__poster_returned);
+    RUN_TEST(parse_game_cover_url__title_has_no_poster__display_image_returned);
+
+    RUN_TEST(parse_recent_titles__message_has_titles__titles_returned_in_order);
+    RUN_TEST(parse_recent_titles__message_has_no_titles__null_returned);
     return UNITY_END();
 }
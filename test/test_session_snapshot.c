@@ -0,0 +1,241 @@
+#include "unity.h"
+
+#include "xbox/session_snapshot.h"
+
+#include <pthread.h>
+#include <util/bmem.h>
+
+#define READER_ITERATIONS 20000
+#define WRITER_ITERATIONS 2000
+
+static xbox_session_t *create_session(int base_value) {
+
+    xbox_session_t *session         = bzalloc(sizeof(xbox_session_t));
+    session->gamerscore             = bzalloc(sizeof(gamerscore_t));
+    session->gamerscore->base_value = base_value;
+
+    return session;
+}
+
+static session_snapshot_t *create_snapshot(int base_value) {
+
+    xbox_session_t     *session  = create_session(base_value);
+    session_snapshot_t *snapshot = create_session_snapshot(session);
+    free_xbox_session(&session);
+
+    return snapshot;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+//  Tests create_session_snapshot / release_session_snapshot
+
+static void create_session_snapshot__session_is_null__null_returned(void) {
+    //  Act.
+    session_snapshot_t *snapshot = create_session_snapshot(NULL);
+
+    //  Assert.
+    TEST_ASSERT_NULL(snapshot);
+}
+
+static void create_session_snapshot__session_modified__snapshot_unchanged(void) {
+    //  Arrange.
+    xbox_session_t *session = create_session(1000);
+
+    //  Act.
+    session_snapshot_t *snapshot    = create_session_snapshot(session);
+    session->gamerscore->base_value = 2000;
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(1000, gamerscore_compute(snapshot->session->gamerscore));
+
+    release_session_snapshot(&snapshot);
+    free_xbox_session(&session);
+}
+
+static void create_session_snapshot__session_has_achievements__catalog_shared(void) {
+    //  Arrange.
+    xbox_session_t *session = create_session(1000);
+    session->achievements   = create_achievement_catalog(1, 0, 0, 16);
+    achievement_catalog_add(session->achievements, "1");
+
+    //  Act.
+    session_snapshot_t *snapshot = create_session_snapshot(session);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_PTR(session->achievements, snapshot->session->achievements);
+
+    release_session_snapshot(&snapshot);
+    free_xbox_session(&session);
+}
+
+static void release_session_snapshot__session_freed__catalog_still_readable(void) {
+    //  Arrange.
+    xbox_session_t *session = create_session(1000);
+    session->achievements   = create_achievement_catalog(1, 0, 0, 16);
+    achievement_catalog_add(session->achievements, "1");
+
+    session_snapshot_t *snapshot = create_session_snapshot(session);
+
+    //  Act.
+    free_xbox_session(&session);
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(achievement_catalog_find(snapshot->session->achievements, "1"));
+
+    release_session_snapshot(&snapshot);
+}
+
+static void create_session_snapshot__achievement_unlocked_after__snapshot_unchanged(void) {
+    //  Arrange.
+    xbox_session_t *session = create_session(1000);
+    gamerscore_add_unlocked_achievement(session->gamerscore, "1", 10);
+
+    //  Act.
+    session_snapshot_t *snapshot = create_session_snapshot(session);
+    gamerscore_add_unlocked_achievement(session->gamerscore, "2", 20);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(1010, gamerscore_compute(snapshot->session->gamerscore));
+    TEST_ASSERT_TRUE(gamerscore_is_unlocked(snapshot->session->gamerscore, "1"));
+    TEST_ASSERT_FALSE(gamerscore_is_unlocked(snapshot->session->gamerscore, "2"));
+    TEST_ASSERT_FALSE(gamerscore_add_unlocked_achievement(snapshot->session->gamerscore, "1", 10));
+
+    release_session_snapshot(&snapshot);
+    free_xbox_session(&session);
+}
+
+static void release_session_snapshot__retained_snapshot__still_readable(void) {
+    //  Arrange.
+    session_snapshot_t *snapshot = create_snapshot(1000);
+    session_snapshot_t *retained = retain_session_snapshot(snapshot);
+
+    //  Act.
+    release_session_snapshot(&snapshot);
+
+    //  Assert.
+    TEST_ASSERT_NULL(snapshot);
+    TEST_ASSERT_EQUAL_INT(1000, retained->session->gamerscore->base_value);
+
+    release_session_snapshot(&retained);
+}
+
+//  Tests session_snapshot_publish / session_snapshot_acquire
+
+static void session_snapshot_acquire__nothing_published__null_returned(void) {
+    //  Arrange.
+    session_snapshot_publisher_t publisher = {0};
+
+    //  Act.
+    session_snapshot_t *snapshot = session_snapshot_acquire(&publisher);
+
+    //  Assert.
+    TEST_ASSERT_NULL(snapshot);
+}
+
+static void session_snapshot_acquire__snapshot_published__latest_snapshot_returned(void) {
+    //  Arrange.
+    session_snapshot_publisher_t publisher = {0};
+    session_snapshot_publish(&publisher, create_snapshot(1000));
+    session_snapshot_publish(&publisher, create_snapshot(2000));
+
+    //  Act.
+    session_snapshot_t *snapshot = session_snapshot_acquire(&publisher);
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(snapshot);
+    TEST_ASSERT_EQUAL_INT(2000, snapshot->session->gamerscore->base_value);
+    TEST_ASSERT_EQUAL_INT(2, snapshot->references);
+
+    release_session_snapshot(&snapshot);
+    session_snapshot_publish(&publisher, NULL);
+}
+
+static void session_snapshot_publish__acquired_snapshot_replaced__acquired_snapshot_still_readable(void) {
+    //  Arrange.
+    session_snapshot_publisher_t publisher = {0};
+    session_snapshot_publish(&publisher, create_snapshot(1000));
+    session_snapshot_t *snapshot = session_snapshot_acquire(&publisher);
+
+    //  Act.
+    session_snapshot_publish(&publisher, create_snapshot(2000));
+    session_snapshot_publish(&publisher, NULL);
+
+    //  Assert.
+    TEST_ASSERT_NULL(session_snapshot_acquire(&publisher));
+    TEST_ASSERT_EQUAL_INT(1000, snapshot->session->gamerscore->base_value);
+    TEST_ASSERT_EQUAL_INT(1, snapshot->references);
+
+    release_session_snapshot(&snapshot);
+}
+
+static void *read_snapshots(void *argument) {
+
+    session_snapshot_publisher_t *publisher = argument;
+    int                           previous  = 0;
+
+    for (int i = 0; i < READER_ITERATIONS; i++) {
+        session_snapshot_t *snapshot = session_snapshot_acquire(publisher);
+
+        if (snapshot) {
+            int value = snapshot->session->gamerscore->base_value;
+
+            /* Published values only increase */
+            if (value < previous) {
+                release_session_snapshot(&snapshot);
+                return (void *)1;
+            }
+
+            previous = value;
+            release_session_snapshot(&snapshot);
+        }
+    }
+
+    return NULL;
+}
+
+static void session_snapshot_acquire__concurrent_publications__consistent_snapshots_returned(void) {
+    //  Arrange.
+    session_snapshot_publisher_t publisher = {0};
+    pthread_t                    readers[4];
+
+    for (size_t i = 0; i < sizeof(readers) / sizeof(readers[0]); i++) {
+        pthread_create(&readers[i], NULL, read_snapshots, &publisher);
+    }
+
+    //  Act.
+    for (int i = 1; i <= WRITER_ITERATIONS; i++) {
+        session_snapshot_publish(&publisher, create_snapshot(i));
+    }
+
+    //  Assert.
+    for (size_t i = 0; i < sizeof(readers) / sizeof(readers[0]); i++) {
+        void *result = NULL;
+        pthread_join(readers[i], &result);
+        TEST_ASSERT_NULL(result);
+    }
+
+    session_snapshot_t *snapshot = session_snapshot_acquire(&publisher);
+    TEST_ASSERT_EQUAL_INT(WRITER_ITERATIONS, snapshot->session->gamerscore->base_value);
+
+    release_session_snapshot(&snapshot);
+    session_snapshot_publish(&publisher, NULL);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    //   Test create_session_snapshot / release_session_snapshot
+    RUN_TEST(create_session_snapshot__session_is_null__null_returned);
+    RUN_TEST(create_session_snapshot__session_modified__snapshot_unchanged);
+    RUN_TEST(create_session_snapshot__session_has_achievements__catalog_shared);
+    RUN_TEST(release_session_snapshot__session_freed__catalog_still_readable);
+    RUN_TEST(create_session_snapshot__achievement_unlocked_after__snapshot_unchanged);
+    RUN_TEST(release_session_snapshot__retained_snapshot__still_readable);
+    //   Test session_snapshot_publish / session_snapshot_acquire
+    RUN_TEST(session_snapshot_acquire__nothing_published__null_returned);
+    RUN_TEST(session_snapshot_acquire__snapshot_published__latest_snapshot_returned);
+    RUN_TEST(session_snapshot_publish__acquired_snapshot_replaced__acquired_snapshot_still_readable);
+    RUN_TEST(session_snapshot_acquire__concurrent_publications__consistent_snapshots_returned);
+    return UNITY_END();
+}
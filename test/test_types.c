@@ -4,6 +4,8 @@
 
 #include "test/stubs/time/time_stub.h"
 
+#include <stdio.h>
+
 void setUp(void) {}
 void tearDown(void) {}
 
@@ -240,6 +242,34 @@ static void token_is_expired__token_is_not_expired__false_returned(void) {
     TEST_ASSERT_FALSE(is_expired);
 }
 
+static void token_expires_within__expiry_inside_window__true_returned(void) {
+    //  Arrange.
+    token_t *token = bzalloc(sizeof(token_t));
+    token->expires = 260;
+
+    mock_now(200);
+
+    //  Act.
+    bool expires = token_expires_within(token, 60);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(expires);
+}
+
+static void token_expires_within__expiry_after_window__false_returned(void) {
+    //  Arrange.
+    token_t *token = bzalloc(sizeof(token_t));
+    token->expires = 261;
+
+    mock_now(200);
+
+    //  Act.
+    bool expires = token_expires_within(token, 60);
+
+    //  Assert.
+    TEST_ASSERT_FALSE(expires);
+}
+
 //  Tests gamerscore.c
 
 static void free_gamerscore__gamerscore_is_null__null_gamerscore_returned(void) {
@@ -300,17 +330,10 @@ static void copy_gamerscore__gamerscore_is_null__null_copy_returned(void) {
 
 static void copy_gamerscore__gamerscore_is_not_null__copy_returned(void) {
     //  Arrange.
-    unlocked_achievement_t *unlocked_achievement_2 = bzalloc(sizeof(unlocked_achievement_t));
-    unlocked_achievement_2->value                  = 200;
-    unlocked_achievement_2->next                   = NULL;
-
-    unlocked_achievement_t *unlocked_achievement_1 = bzalloc(sizeof(unlocked_achievement_t));
-    unlocked_achievement_1->value                  = 100;
-    unlocked_achievement_1->next                   = unlocked_achievement_2;
-
-    gamerscore_t *gamerscore          = bzalloc(sizeof(gamerscore_t));
-    gamerscore->base_value            = 1000;
-    gamerscore->unlocked_achievements = unlocked_achievement_1;
+    gamerscore_t *gamerscore = bzalloc(sizeof(gamerscore_t));
+    gamerscore->base_value   = 1000;
+    gamerscore_add_unlocked_achievement(gamerscore, "achievement-id-1", 100);
+    gamerscore_add_unlocked_achievement(gamerscore, "achievement-id-2", 200);
 
     //  Act.
     const gamerscore_t *copy = copy_gamerscore(gamerscore);
@@ -326,6 +349,10 @@ static void copy_gamerscore__gamerscore_is_not_null__copy_returned(void) {
     //  Validates the 2nd achievement.
     TEST_ASSERT_EQUAL_INT(copy->unlocked_achievements->next->value, gamerscore->unlocked_achievements->next->value);
     TEST_ASSERT_NULL(copy->unlocked_achievements->next->next);
+
+    //  Validates the running state.
+    TEST_ASSERT_EQUAL_INT(gamerscore_compute(copy), 1300);
+    TEST_ASSERT_TRUE(gamerscore_is_unlocked(copy, "achievement-id-2"));
 }
 
 static void copy_gamerscore__gamerscore_is_null__zero_returned(void) {
@@ -353,14 +380,9 @@ static void copy_gamerscore__no_unlocked_achievements__base_value_returned(void)
 
 static void copy_gamerscore__one_unlocked_achievement__total_returned(void) {
     //  Arrange.
-    unlocked_achievement_t *unlocked_achievement = bzalloc(sizeof(unlocked_achievement_t));
-    unlocked_achievement->id                     = bstrdup("achievement-id");
-    unlocked_achievement->value                  = 200;
-    unlocked_achievement->next                   = NULL;
-
-    gamerscore_t *gamerscore          = bzalloc(sizeof(gamerscore_t));
-    gamerscore->base_value            = 400;
-    gamerscore->unlocked_achievements = unlocked_achievement;
+    gamerscore_t *gamerscore = bzalloc(sizeof(gamerscore_t));
+    gamerscore->base_value   = 400;
+    gamerscore_add_unlocked_achievement(gamerscore, "achievement-id", 200);
 
     //  Act.
     int result = gamerscore_compute(gamerscore);
@@ -371,19 +393,10 @@ static void copy_gamerscore__one_unlocked_achievement__total_returned(void) {
 
 static void copy_gamerscore__two_unlocked_achievements__total_returned(void) {
     //  Arrange.
-    unlocked_achievement_t *unlocked_achievement_2 = bzalloc(sizeof(unlocked_achievement_t));
-    unlocked_achievement_2->id                     = bstrdup("achievement-id-2");
-    unlocked_achievement_2->value                  = 200;
-    unlocked_achievement_2->next                   = NULL;
-
-    unlocked_achievement_t *unlocked_achievement_1 = bzalloc(sizeof(unlocked_achievement_t));
-    unlocked_achievement_1->id                     = bstrdup("achievement-id-1");
-    unlocked_achievement_1->value                  = 100;
-    unlocked_achievement_1->next                   = unlocked_achievement_2;
-
-    gamerscore_t *gamerscore          = bzalloc(sizeof(gamerscore_t));
-    gamerscore->base_value            = 400;
-    gamerscore->unlocked_achievements = unlocked_achievement_1;
+    gamerscore_t *gamerscore = bzalloc(sizeof(gamerscore_t));
+    gamerscore->base_value   = 400;
+    gamerscore_add_unlocked_achievement(gamerscore, "achievement-id-1", 100);
+    gamerscore_add_unlocked_achievement(gamerscore, "achievement-id-2", 200);
 
     //  Act.
     int result = gamerscore_compute(gamerscore);
@@ -392,6 +405,50 @@ static void copy_gamerscore__two_unlocked_achievements__total_returned(void) {
     TEST_ASSERT_EQUAL_INT(result, 700);
 }
 
+static void gamerscore_add_unlocked_achievement__achievement_already_unlocked__false_returned(void) {
+    //  Arrange.
+    gamerscore_t *gamerscore = bzalloc(sizeof(gamerscore_t));
+    gamerscore->base_value   = 400;
+    gamerscore_add_unlocked_achievement(gamerscore, "achievement-id", 200);
+
+    //  Act.
+    bool added = gamerscore_add_unlocked_achievement(gamerscore, "ACHIEVEMENT-ID", 200);
+
+    //  Assert.
+    TEST_ASSERT_FALSE(added);
+    TEST_ASSERT_EQUAL_INT(gamerscore_compute(gamerscore), 600);
+    TEST_ASSERT_NULL(gamerscore->unlocked_achievements->next);
+
+    free_gamerscore(&gamerscore);
+}
+
+static void gamerscore_add_unlocked_achievement__many_achievements__appended_in_order(void) {
+    //  Arrange.
+    gamerscore_t *gamerscore = bzalloc(sizeof(gamerscore_t));
+    char          id[32];
+
+    //  Act.
+    for (int i = 0; i < 100; i++) {
+        snprintf(id, sizeof(id), "achievement-%d", i);
+        gamerscore_add_unlocked_achievement(gamerscore, id, 10);
+    }
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_INT(gamerscore_compute(gamerscore), 1000);
+    TEST_ASSERT_EQUAL_STRING(gamerscore->unlocked_achievements->id, "achievement-0");
+    TEST_ASSERT_EQUAL_STRING(gamerscore->last_unlocked_achievement->id, "achievement-99");
+    TEST_ASSERT_NULL(gamerscore->last_unlocked_achievement->next);
+
+    for (int i = 0; i < 100; i++) {
+        snprintf(id, sizeof(id), "achievement-%d", i);
+        TEST_ASSERT_TRUE(gamerscore_is_unlocked(gamerscore, id));
+    }
+
+    TEST_ASSERT_FALSE(gamerscore_is_unlocked(gamerscore, "achievement-100"));
+
+    free_gamerscore(&gamerscore);
+}
+
 //  Tests unlocked_achievement.c
 
 static void free_unlocked_achievement__unlocked_achievement_is_null__null_unlocked_achievement_returned(void) {
@@ -959,6 +1016,150 @@ static void count_achievements__two_achievements__2_returned(void) {
     TEST_ASSERT_EQUAL_INT(total, 2);
 }
 
+//  Tests achievement_catalog.c
+
+static void create_achievement_catalog_from_list__two_achievements__records_copied_and_chained(void) {
+    //  Arrange.
+    reward_t *reward = bzalloc(sizeof(reward_t));
+    reward->value    = bstrdup("25");
+
+    media_asset_t *media_asset2 = bzalloc(sizeof(media_asset_t));
+    media_asset2->url           = bstrdup("https://www.example.com/image-2.png");
+
+    media_asset_t *media_asset1 = bzalloc(sizeof(media_asset_t));
+    media_asset1->url           = bstrdup("https://www.example.com/image-1.png");
+    media_asset1->next          = media_asset2;
+
+    achievement_t *achievement2 = bzalloc(sizeof(achievement_t));
+    achievement2->id            = bstrdup("achievement-2");
+    achievement2->name          = bstrdup("Second");
+
+    achievement_t *achievement1     = bzalloc(sizeof(achievement_t));
+    achievement1->id                = bstrdup("achievement-1");
+    achievement1->service_config_id = bstrdup("service-config-id");
+    achievement1->name              = bstrdup("First");
+    achievement1->is_secret         = true;
+    achievement1->media_assets      = media_asset1;
+    achievement1->rewards           = reward;
+    achievement1->next              = achievement2;
+
+    //  Act.
+    achievement_catalog_t *catalog = create_achievement_catalog_from_list(achievement1);
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(2, achievement_catalog_count(catalog));
+
+    const achievement_t *first = achievement_catalog_get_achievements(catalog);
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_TRUE(first != achievement1);
+    TEST_ASSERT_EQUAL_STRING("achievement-1", first->id);
+    TEST_ASSERT_EQUAL_STRING("service-config-id", first->service_config_id);
+    TEST_ASSERT_EQUAL_STRING("First", first->name);
+    TEST_ASSERT_NULL(first->description);
+    TEST_ASSERT_TRUE(first->is_secret);
+    TEST_ASSERT_EQUAL_STRING("https://www.example.com/image-1.png", first->media_assets->url);
+    TEST_ASSERT_EQUAL_STRING("https://www.example.com/image-2.png", first->media_assets->next->url);
+    TEST_ASSERT_NULL(first->media_assets->next->next);
+    TEST_ASSERT_EQUAL_STRING("25", first->rewards->value);
+    TEST_ASSERT_NULL(first->rewards->next);
+
+    const achievement_t *second = first->next;
+    TEST_ASSERT_NOT_NULL(second);
+    TEST_ASSERT_EQUAL_STRING("achievement-2", second->id);
+    TEST_ASSERT_NULL(second->media_assets);
+    TEST_ASSERT_NULL(second->rewards);
+    TEST_ASSERT_NULL(second->next);
+
+    free_achievement_catalog(&catalog);
+    free_achievement(&achievement1);
+}
+
+static void achievement_catalog_find__id_case_differs__achievement_returned(void) {
+    //  Arrange.
+    achievement_catalog_t *catalog = create_achievement_catalog(1, 0, 0, 64);
+    achievement_catalog_add(catalog, "Achievement-Id");
+
+    //  Act.
+    const achievement_t *achievement = achievement_catalog_find(catalog, "ACHIEVEMENT-id");
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(achievement);
+    TEST_ASSERT_EQUAL_STRING("Achievement-Id", achievement->id);
+
+    free_achievement_catalog(&catalog);
+}
+
+static void achievement_catalog_find__id_is_unknown__null_returned(void) {
+    //  Arrange.
+    achievement_catalog_t *catalog = create_achievement_catalog(1, 0, 0, 64);
+    achievement_catalog_add(catalog, "achievement-1");
+
+    //  Act.
+    const achievement_t *achievement = achievement_catalog_find(catalog, "achievement-2");
+
+    //  Assert.
+    TEST_ASSERT_NULL(achievement);
+
+    free_achievement_catalog(&catalog);
+}
+
+static void achievement_catalog_find__many_achievements__every_achievement_returned(void) {
+    //  Arrange.
+    const size_t           count   = 1000;
+    achievement_catalog_t *catalog = create_achievement_catalog(count, 0, 0, count * 8);
+
+    for (size_t i = 0; i < count; i++) {
+        char id[8];
+        snprintf(id, sizeof(id), "%zu", i);
+        achievement_catalog_add(catalog, id);
+    }
+
+    //  Act.
+    size_t found = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        char id[8];
+        snprintf(id, sizeof(id), "%zu", i);
+
+        const achievement_t *achievement = achievement_catalog_find(catalog, id);
+
+        if (achievement && strcmp(achievement->id, id) == 0) {
+            found++;
+        }
+    }
+
+    //  Assert.
+    TEST_ASSERT_EQUAL_size_t(count, found);
+
+    free_achievement_catalog(&catalog);
+}
+
+static void achievement_catalog_add__catalog_is_full__null_returned(void) {
+    //  Arrange.
+    achievement_catalog_t *catalog = create_achievement_catalog(1, 0, 0, 64);
+    achievement_catalog_add(catalog, "achievement-1");
+
+    //  Act.
+    achievement_t *achievement = achievement_catalog_add(catalog, "achievement-2");
+
+    //  Assert.
+    TEST_ASSERT_NULL(achievement);
+    TEST_ASSERT_EQUAL_size_t(1, achievement_catalog_count(catalog));
+
+    free_achievement_catalog(&catalog);
+}
+
+static void free_achievement_catalog__catalog_is_not_null__null_catalog_returned(void) {
+    //  Arrange.
+    achievement_catalog_t *catalog = create_achievement_catalog(1, 0, 0, 64);
+
+    //  Act.
+    free_achievement_catalog(&catalog);
+
+    //  Assert.
+    TEST_ASSERT_NULL(catalog);
+}
+
 //  Tests achievement_progress.c
 
 static void free_achievement_progress__achievement_progress_is_null__null_achievement_progress_returned(void) {
@@ -1099,6 +1300,14 @@ int main(void) {
     RUN_TEST(count_achievements__one_achievement__1_returned);
     RUN_TEST(count_achievements__two_achievements__2_returned);
 
+    //  Tests achievement_catalog.c
+    RUN_TEST(create_achievement_catalog_from_list__two_achievements__records_copied_and_chained);
+    RUN_TEST(achievement_catalog_find__id_case_differs__achievement_returned);
+    RUN_TEST(achievement_catalog_find__id_is_unknown__null_returned);
+    RUN_TEST(achievement_catalog_find__many_achievements__every_achievement_returned);
+    RUN_TEST(achievement_catalog_add__catalog_is_full__null_returned);
+    RUN_TEST(free_achievement_catalog__catalog_is_not_null__null_catalog_returned);
+
     //  Tests game.c
     RUN_TEST(free_game__game_is_null__null_game_returned);
     RUN_TEST(free_game__game_id_not_null__null_game_returned);
@@ -1122,6 +1331,8 @@ int main(void) {
     RUN_TEST(token_is_expired__token_is_expired__true_returned);
     RUN_TEST(token_is_expired__token_just_expired__true_returned);
     RUN_TEST(token_is_expired__token_is_not_expired__false_returned);
+    RUN_TEST(token_expires_within__expiry_inside_window__true_returned);
+    RUN_TEST(token_expires_within__expiry_after_window__false_returned);
 
     //  Tests gamerscore.c
     RUN_TEST(free_gamerscore__gamerscore_is_null__null_gamerscore_returned);
@@ -1135,6 +1346,8 @@ int main(void) {
     RUN_TEST(copy_gamerscore__no_unlocked_achievements__base_value_returned);
     RUN_TEST(copy_gamerscore__one_unlocked_achievement__total_returned);
     RUN_TEST(copy_gamerscore__two_unlocked_achievements__total_returned);
+    RUN_TEST(gamerscore_add_unlocked_achievement__achievement_already_unlocked__false_returned);
+    RUN_TEST(gamerscore_add_unlocked_achievement__many_achievements__appended_in_order);
 
     //  Tests unlocked_achievement.c
     RUN_TEST(free_unlocked_achievement__unlocked_achievement_is_null__null_unlocked_achievement_returned);
@@ -195,7 +195,7 @@ static void xbox_session_change_game__session_has_no_game_and_game_is_null__no_g
 static void xbox_session_change_game__session_has_game_and_game_is_null__no_game_selected(void) {
     //  Arrange.
     session->game         = copy_game(game_outer_worlds_2);
-    session->achievements = copy_achievement(achievement_1);
+    session->achievements = create_achievement_catalog_from_list(achievement_1);
 
     game_t *game = NULL;
 
@@ -209,7 +209,7 @@ static void xbox_session_change_game__session_has_game_and_game_is_null__no_game
 
 static void xbox_session_change_game__session_has_no_game_and_game_is_not_null__game_selected(void) {
     //  Arrange.
-    mock_xbox_client_set_achievements(copy_achievement(achievement_1));
+    mock_xbox_client_set_achievements(create_achievement_catalog_from_list(achievement_1));
 
     game_t *game = copy_game(game_fallout_4);
 
@@ -221,15 +221,15 @@ static void xbox_session_change_game__session_has_no_game_and_game_is_not_null__
     TEST_ASSERT_EQUAL_STRING(session->game->id, game_fallout_4->id);
 
     TEST_ASSERT_NOT_NULL(session->achievements);
-    TEST_ASSERT_EQUAL_STRING(session->achievements->id, achievement_1->id);
+    TEST_ASSERT_EQUAL_STRING(achievement_catalog_get_achievements(session->achievements)->id, achievement_1->id);
 }
 
 static void xbox_session_change_game__session_has_game_and_game_is_not_null__new_game_selected(void) {
     //  Arrange.
-    mock_xbox_client_set_achievements(copy_achievement(achievement_2));
+    mock_xbox_client_set_achievements(create_achievement_catalog_from_list(achievement_2));
 
     session->game         = copy_game(game_outer_worlds_2);
-    session->achievements = copy_achievement(achievement_1);
+    session->achievements = create_achievement_catalog_from_list(achievement_1);
 
     game_t *game = copy_game(game_fallout_4);
 
@@ -241,7 +241,76 @@ static void xbox_session_change_game__session_has_game_and_game_is_not_null__new
     TEST_ASSERT_EQUAL_STRING(session->game->id, game_fallout_4->id);
 
     TEST_ASSERT_NOT_NULL(session->achievements);
-    TEST_ASSERT_EQUAL_STRING(session->achievements->id, achievement_2->id);
+    TEST_ASSERT_EQUAL_STRING(achievement_catalog_get_achievements(session->achievements)->id, achievement_2->id);
+}
+
+//  Test xbox_session_set_game
+
+static void xbox_session_set_game__session_has_game_and_game_is_null__no_game_selected(void) {
+    //  Arrange.
+    session->game         = copy_game(game_outer_worlds_2);
+    session->achievements = create_achievement_catalog_from_list(achievement_1);
+
+    //  Act.
+    xbox_session_set_game(session, NULL, create_achievement_catalog_from_list(achievement_2));
+
+    //  Assert.
+    TEST_ASSERT_NULL(session->game);
+    TEST_ASSERT_NULL(session->achievements);
+}
+
+static void xbox_session_set_game__session_has_game_and_game_is_not_null__new_game_and_achievements_selected(void) {
+    //  Arrange.
+    session->game         = copy_game(game_outer_worlds_2);
+    session->achievements = create_achievement_catalog_from_list(achievement_1);
+
+    achievement_catalog_t *achievements = create_achievement_catalog_from_list(achievement_2);
+
+    //  Act.
+    xbox_session_set_game(session, game_fallout_4, achievements);
+
+    //  Assert.
+    TEST_ASSERT_NOT_NULL(session->game);
+    TEST_ASSERT_EQUAL_STRING(session->game->id, game_fallout_4->id);
+    TEST_ASSERT_TRUE(session->game != game_fallout_4);
+
+    TEST_ASSERT_TRUE(session->achievements == achievements);
+}
+
+//  Test xbox_session_refresh_achievements
+
+static void xbox_session_refresh_achievements__game_is_played__achievements_replaced(void) {
+    //  Arrange.
+    session->game         = copy_game(game_outer_worlds_2);
+    session->achievements = create_achievement_catalog_from_list(achievement_1);
+
+    achievement_catalog_t *achievements = create_achievement_catalog_from_list(achievement_2);
+
+    //  Act.
+    bool refreshed = xbox_session_refresh_achievements(session, game_outer_worlds_2, achievements);
+
+    //  Assert.
+    TEST_ASSERT_TRUE(refreshed);
+    TEST_ASSERT_EQUAL_STRING(OUTER_WORLD_2_ID, session->game->id);
+    TEST_ASSERT_TRUE(session->achievements == achievements);
+    TEST_ASSERT_EQUAL_INT(1000, gamerscore_compute(session->gamerscore));
+}
+
+static void xbox_session_refresh_achievements__game_is_not_played__achievements_unchanged(void) {
+    //  Arrange.
+    session->game         = copy_game(game_outer_worlds_2);
+    session->achievements = create_achievement_catalog_from_list(achievement_1);
+
+    const achievement_catalog_t *previous_achievements = session->achievements;
+
+    //  Act.
+    bool refreshed = xbox_session_refresh_achievements(session,
+                                                       game_fallout_4,
+                                                       create_achievement_catalog_from_list(achievement_2));
+
+    //  Assert.
+    TEST_ASSERT_FALSE(refreshed);
+    TEST_ASSERT_TRUE(session->achievements == previous_achievements);
 }
 
 //  Test xbox_session_compute_gamerscore
@@ -275,9 +344,7 @@ static void xbox_session_compute_gamerscore__session_has_one_unlocked_achievemen
     session->gamerscore             = bzalloc(sizeof(gamerscore_t));
     session->gamerscore->base_value = 1000;
 
-    session->gamerscore->unlocked_achievements        = bzalloc(sizeof(unlocked_achievement_t));
-    session->gamerscore->unlocked_achievements->value = 50;
-    session->gamerscore->unlocked_achievements->next  = NULL;
+    gamerscore_add_unlocked_achievement(session->gamerscore, "1", 50);
 
     //  Act.
     int total_gamerscore = xbox_session_compute_gamerscore(session);
@@ -291,12 +358,8 @@ static void xbox_session_compute_gamerscore__session_has_two_unlocked_achievemen
     session->gamerscore             = bzalloc(sizeof(gamerscore_t));
     session->gamerscore->base_value = 1000;
 
-    session->gamerscore->unlocked_achievements        = bzalloc(sizeof(unlocked_achievement_t));
-    session->gamerscore->unlocked_achievements->value = 50;
-
-    session->gamerscore->unlocked_achievements->next        = bzalloc(sizeof(unlocked_achievement_t));
-    session->gamerscore->unlocked_achievements->next->value = 80;
-    session->gamerscore->unlocked_achievements->next->next  = NULL;
+    gamerscore_add_unlocked_achievement(session->gamerscore, "1", 50);
+    gamerscore_add_unlocked_achievement(session->gamerscore, "2", 80);
 
     //  Act.
     int total_gamerscore = xbox_session_compute_gamerscore(session);
@@ -312,7 +375,8 @@ static void xbox_session_unlock_achievement__one_achievement_unlocked__gamerscor
     achievement_t *achievements = copy_achievement(achievement_1);
     achievements->next          = copy_achievement(achievement_2);
 
-    session->achievements = achievements;
+    session->achievements = create_achievement_catalog_from_list(achievements);
+    free_achievement(&achievements);
 
     //  Act.
     xbox_session_unlock_achievement(session, achievement_progress_2);
@@ -327,7 +391,8 @@ static void xbox_session_unlock_achievement__two_achievements_unlocked__gamersco
     achievement_t *achievements = copy_achievement(achievement_1);
     achievements->next          = copy_achievement(achievement_2);
 
-    session->achievements = achievements;
+    session->achievements = create_achievement_catalog_from_list(achievements);
+    free_achievement(&achievements);
 
     //  Act.
     xbox_session_unlock_achievement(session, achievement_progress_2);
@@ -338,6 +403,39 @@ static void xbox_session_unlock_achievement__two_achievements_unlocked__gamersco
     TEST_ASSERT_EQUAL(total_gamerscore, 1000 + 500 + 80);
 }
 
+static void xbox_session_unlock_achievement__achievement_unlocked_twice__gamerscore_incremented_once(void) {
+    //  Arrange.
+    achievement_t *achievements = copy_achievement(achievement_1);
+    achievements->next          = copy_achievement(achievement_2);
+
+    session->achievements = create_achievement_catalog_from_list(achievements);
+    free_achievement(&achievements);
+
+    //  Act.
+    xbox_session_unlock_achievement(session, achievement_progress_2);
+    xbox_session_unlock_achievement(session, achievement_progress_2);
+
+    //  Assert.
+    int total_gamerscore = xbox_session_compute_gamerscore(session);
+    TEST_ASSERT_EQUAL(total_gamerscore, 1000 + 500);
+    TEST_ASSERT_NULL(session->gamerscore->unlocked_achievements->next);
+}
+
+static void xbox_session_unlock_achievement__id_case_differs__gamerscore_incremented(void) {
+    //  Arrange.
+    session->achievements = create_achievement_catalog_from_list(achievement_2);
+
+    free_memory((void **)&achievement_progress_2->id);
+    achievement_progress_2->id = bstrdup("ACHIEVEMENT-2");
+
+    //  Act.
+    xbox_session_unlock_achievement(session, achievement_progress_2);
+
+    //  Assert.
+    int total_gamerscore = xbox_session_compute_gamerscore(session);
+    TEST_ASSERT_EQUAL(total_gamerscore, 1000 + 500);
+}
+
 static void xbox_session_unlock_achievement__unknown_achievements_unlocked__gamerscore_unchanged(void) {
     //  Act.
     xbox_session_unlock_achievement(session, achievement_progress_1);
@@ -352,10 +450,11 @@ static void xbox_session_unlock_achievement__no_reward_found__gamerscore_unchang
     achievement_t *achievements = copy_achievement(achievement_1);
     achievements->next          = copy_achievement(achievement_2);
 
-    session->achievements = achievements;
-
     free_reward((reward_t **)&achievements->rewards);
 
+    session->achievements = create_achievement_catalog_from_list(achievements);
+    free_achievement(&achievements);
+
     //  Act.
     xbox_session_unlock_achievement(session, achievement_progress_1);
 
@@ -378,15 +477,23 @@ int main(void) {
     RUN_TEST(xbox_session_change_game__session_has_game_and_game_is_null__no_game_selected);
     RUN_TEST(xbox_session_change_game__session_has_no_game_and_game_is_not_null__game_selected);
     RUN_TEST(xbox_session_change_game__session_has_game_and_game_is_not_null__new_game_selected);
+
+    RUN_TEST(xbox_session_set_game__session_has_game_and_game_is_null__no_game_selected);
+    RUN_TEST(xbox_session_set_game__session_has_game_and_game_is_not_null__new_game_and_achievements_selected);
+    //   Test xbox_session_refresh_achievements
+    RUN_TEST(xbox_session_refresh_achievements__game_is_played__achievements_replaced);
+    RUN_TEST(xbox_session_refresh_achievements__game_is_not_played__achievements_unchanged);
     //   Test xbox_session_compute_gamerscore
     RUN_TEST(xbox_session_compute_gamerscore__session_is_null__0_returned);
     RUN_TEST(xbox_session_compute_gamerscore__session_has_no_unlocked_achievement__base_value_returned);
     RUN_TEST(xbox_session_compute_gamerscore__session_has_one_unlocked_achievement__total_value_returned);
     RUN_TEST(xbox_session_compute_gamerscore__session_has_two_unlocked_achievements__total_value_returned);
     //   Test xbox_session_unlock_achievement
+    RUN_TEST(xbox_session_unlock_achievement__id_case_differs__gamerscore_incremented);
     RUN_TEST(xbox_session_unlock_achievement__unknown_achievements_unlocked__gamerscore_unchanged);
     RUN_TEST(xbox_session_unlock_achievement__no_reward_found__gamerscore_unchanged);
     RUN_TEST(xbox_session_unlock_achievement__one_achievement_unlocked__gamerscore_incremented);
     RUN_TEST(xbox_session_unlock_achievement__two_achievements_unlocked__gamerscore_incremented);
+    RUN_TEST(xbox_session_unlock_achievement__achievement_unlocked_twice__gamerscore_incremented_once);
     return UNITY_END();
 }